@@ -0,0 +1,158 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <vector>
+#include <string>
+#include <functional>
+#include <chrono>
+#include <limits>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <stdexcept>
+
+namespace CPlantBox {
+
+/**
+ * Minimal timing harness for the benchmarks (no outside dependencies)
+ *
+ * Each case is run Benchmark::repeats times after one warm up run. The setup function is called before each run,
+ * and is not timed. The body returns a problem size (e.g. number of segments), which is reported together with the
+ * timings, so that results of different resolutions or versions can be compared. Cases that throw (e.g. compressed
+ * output without zlib) are reported as skipped.
+ *
+ * The timings are printed to std::cerr (the library writes its messages to std::cout).
+ *
+ * Command line options:
+ *  --filter <substring>    runs only cases whose name contains the substring
+ *  --repeats <n>           number of timed runs per case (default 5)
+ *  --csv <file>            writes the results as CSV (default benchmarks.csv)
+ *  --json <file>           writes the results as JSON
+ *  --list                  lists the case names, and does not run them
+ */
+class Benchmark
+{
+public:
+
+    struct Result {
+        std::string name; ///< case name, e.g. "RootSystem::simulate"
+        std::string param; ///< case parameters, e.g. "Zea_mays_1_Leitner_2010 dx*0.5 30d"
+        int repeats;
+        double min; ///< [s]
+        double mean; ///< [s]
+        double max; ///< [s]
+        double size; ///< problem size, as returned by the body
+    };
+
+    Benchmark(int argc, char** argv) {
+        for (int i = 1; i<argc; i++) {
+            std::string a = argv[i];
+            if (a=="--list") {
+                listOnly = true;
+            } else if (i+1<argc && a=="--filter") {
+                filter = argv[++i];
+            } else if (i+1<argc && a=="--repeats") {
+                repeats = std::stoi(argv[++i]);
+            } else if (i+1<argc && a=="--csv") {
+                csvName = argv[++i];
+            } else if (i+1<argc && a=="--json") {
+                jsonName = argv[++i];
+            } else {
+                throw std::invalid_argument("Benchmark::Benchmark: unknown option "+a);
+            }
+        }
+    }
+
+    /**
+     * Times a case
+     *
+     * @param name      case name
+     * @param param     case parameters (free text)
+     * @param body      timed function, returns the problem size
+     * @param setup     untimed function, called before each run of body (optional)
+     */
+    void run(std::string name, std::string param, const std::function<double()>& body,
+        const std::function<void()>& setup = std::function<void()>()) {
+        if (name.find(filter)==std::string::npos) {
+            return;
+        }
+        if (listOnly) {
+            std::cout << name << ", " << param << "\n";
+            return;
+        }
+        Result r { name, param, repeats, std::numeric_limits<double>::max(), 0., 0., 0. };
+        for (int i = -1; i<repeats; i++) { // i = -1 is the warm up run
+            double t;
+            try {
+                if (setup) {
+                    setup();
+                }
+                auto t0 = std::chrono::steady_clock::now();
+                r.size = body();
+                t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            } catch (const std::exception& e) {
+                std::cerr << std::left << std::setw(44) << name << std::setw(48) << param << "skipped: " << e.what() << "\n";
+                return;
+            }
+            if (i>=0) {
+                r.min = std::min(r.min, t);
+                r.max = std::max(r.max, t);
+                r.mean += t/repeats;
+            }
+        }
+        std::cerr << std::left << std::setw(44) << name << std::setw(48) << param << std::right << std::scientific
+            << std::setprecision(3) << r.min << " s (min), " << r.mean << " s (mean), size " << r.size << "\n";
+        results.push_back(r);
+    }
+
+    /**
+     * Writes the results (call after all cases)
+     */
+    void write() const {
+        if (listOnly) {
+            return;
+        }
+        if (!csvName.empty()) {
+            std::ofstream fos(csvName);
+            writeCSV(fos);
+        }
+        if (!jsonName.empty()) {
+            std::ofstream fos(jsonName);
+            writeJSON(fos);
+        }
+    }
+
+    void writeCSV(std::ostream& os) const {
+        os << "name,param,repeats,min,mean,max,size\n";
+        os << std::setprecision(9);
+        for (const auto& r : results) {
+            os << r.name << "," << r.param << "," << r.repeats << "," << r.min << "," << r.mean << "," << r.max << ","
+                << r.size << "\n";
+        }
+    }
+
+    void writeJSON(std::ostream& os) const {
+        os << "{\n  \"results\": [\n" << std::setprecision(9);
+        for (size_t i = 0; i<results.size(); i++) {
+            const auto& r = results[i];
+            os << "    { \"name\": \"" << r.name << "\", \"param\": \"" << r.param << "\", \"repeats\": " << r.repeats
+                << ", \"min\": " << r.min << ", \"mean\": " << r.mean << ", \"max\": " << r.max << ", \"size\": " << r.size
+                << " }" << ((i+1<results.size()) ? ",\n" : "\n");
+        }
+        os << "  ]\n}\n";
+    }
+
+    int repeats = 5; ///< timed runs per case
+    std::string filter = ""; ///< runs only cases whose name contains filter
+    bool listOnly = false;
+    std::string csvName = "benchmarks.csv";
+    std::string jsonName = "";
+    std::vector<Result> results;
+
+};
+
+} // end namespace CPlantBox
+
+#endif
@@ -0,0 +1,234 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#include "Benchmark.h"
+
+#include "RootSystem.h"
+#include "Plant.h"
+#include "MappedOrganism.h"
+#include "SegmentAnalyser.h"
+#include "XylemFlux.h"
+#include "Photosynthesis.h"
+#include "ExudationModel.h"
+#include "sdf.h"
+
+#include <sstream>
+#include <cstdio>
+#include <cmath>
+
+/**
+ * Benchmarks of the main hot paths, see Benchmark for the command line options
+ *
+ * Parameter files are taken from CPLANTBOX_MODELPARAMETER (set by CMake to the modelparameter folder)
+ */
+
+using namespace CPlantBox;
+
+const std::string rootsystemPath = std::string(CPLANTBOX_MODELPARAMETER) + "/structural/rootsystem/";
+const std::string plantPath = std::string(CPLANTBOX_MODELPARAMETER) + "/structural/plant/";
+
+std::string toString(double x) {
+    std::ostringstream os;
+    os << x;
+    return os.str();
+}
+
+/**
+ * Scales the axial resolution (dx and dxMin) of all organ types by factor
+ */
+void scaleResolution(Organism& plant, double factor) {
+    for (int ot = Organism::ot_seed; ot<=Organism::ot_leaf; ot++) {
+        for (auto& p : plant.getOrganRandomParameter(ot)) {
+            if (p) {
+                p->dx *= factor;
+                p->dxMin *= factor;
+            }
+        }
+    }
+}
+
+/**
+ * A simulated root system, for the benchmarks that analyse the segments
+ */
+std::shared_ptr<RootSystem> rootSystem(std::string name, double simtime) {
+    auto rs = std::make_shared<RootSystem>();
+    rs->setSeed(1);
+    rs->readParameters(rootsystemPath + name + ".xml", "plant", true, false);
+    rs->initialize(false);
+    rs->simulate(simtime, false);
+    return rs;
+}
+
+/**
+ * A simulated root system, for the benchmarks that use the mapped segments
+ */
+std::shared_ptr<MappedRootSystem> mappedRootSystem(std::string name, double simtime) {
+    auto rs = std::make_shared<MappedRootSystem>();
+    rs->setSeed(1);
+    rs->readParameters(rootsystemPath + name + ".xml", "plant", true, false);
+    rs->initialize(false);
+    rs->simulate(simtime, false);
+    return rs;
+}
+
+/**
+ * Organism::simulate for root systems and plants at several resolutions
+ */
+void simulate(Benchmark& b) {
+    for (std::string name : { "Anagallis_femina_Leitner_2010", "Zea_mays_1_Leitner_2010" }) {
+        for (double f : { 1., 0.5, 0.1 }) {
+            std::shared_ptr<RootSystem> rs;
+            b.run("RootSystem::simulate", name + " dx*" + toString(f) + " 30d",
+                [&]() { rs->simulate(30., false); return (double)rs->getNumberOfSegments(); },
+                [&]() {
+                    rs = std::make_shared<RootSystem>();
+                    rs->setSeed(1);
+                    rs->readParameters(rootsystemPath + name + ".xml", "plant", true, false);
+                    scaleResolution(*rs, f);
+                    rs->initialize(false);
+                });
+        }
+    }
+    for (std::string name : { "fspm2023", "Triticum_aestivum_adapted_2023" }) {
+        for (double f : { 1., 0.5, 0.1 }) {
+            std::shared_ptr<Plant> plant;
+            b.run("Plant::simulate", name + " dx*" + toString(f) + " 20d",
+                [&]() { plant->simulate(20., false); return (double)plant->getNumberOfSegments(); },
+                [&]() {
+                    plant = std::make_shared<Plant>(1);
+                    plant->readParameters(plantPath + name + ".xml", "plant", true, false);
+                    scaleResolution(*plant, f);
+                    plant->initialize(false);
+                });
+        }
+    }
+}
+
+/**
+ * MappedSegments::setRectangularGrid, cutting and mapping the segments to grids of increasing resolution
+ */
+void mapping(Benchmark& b) {
+    auto rs = mappedRootSystem("Zea_mays_1_Leitner_2010", 30.);
+    for (bool cut : { false, true }) {
+        for (int n : { 10, 40, 100 }) {
+            std::shared_ptr<MappedSegments> ms;
+            b.run("MappedSegments::setRectangularGrid", std::string(cut ? "cut" : "nocut") + " " + std::to_string(n)+"^3",
+                [&]() {
+                    ms->setRectangularGrid(Vector3d(-20., -20., -100.), Vector3d(20., 20., 0.), Vector3d(n, n, n), cut);
+                    return (double)ms->segments.size(); },
+                [&]() { ms = std::make_shared<MappedSegments>(rs->nodes, rs->nodeCTs, rs->segments, rs->radii, rs->subTypes); });
+        }
+    }
+}
+
+/**
+ * XylemFlux::linearSystem, assembly of the hybrid flux equations
+ */
+void xylemFlux(Benchmark& b) {
+    for (double simtime : { 15., 30. }) {
+        auto rs = mappedRootSystem("Zea_mays_1_Leitner_2010", simtime);
+        rs->setRectangularGrid(Vector3d(-20., -20., -100.), Vector3d(20., 20., 0.), Vector3d(20, 20, 50), false);
+        auto xf = std::make_shared<XylemFlux>(rs);
+        xf->setKr({ 1.728e-4 });
+        xf->setKx({ 4.32e-2 });
+        std::vector<double> sx(20*20*50, -300.);
+        b.run("XylemFlux::linearSystem", "Zea_mays_1_Leitner_2010 " + std::to_string((int)simtime) + "d",
+            [&]() { xf->linearSystem(simtime, sx, true); return (double)rs->segments.size(); });
+    }
+}
+
+/**
+ * Photosynthesis::solve_photosynthesis on a wheat plant (parameters of tutorial/examples/example8a_phloemFlow.py)
+ */
+void photosynthesis(Benchmark& b) {
+    for (double simtime : { 7., 14. }) {
+        auto plant = std::make_shared<MappedPlant>(2);
+        plant->readParameters(plantPath + "Triticum_aestivum_adapted_2023.xml", "plant", true, false);
+        plant->setGeometry(std::make_shared<SDF_PlantBox>(1.e9, 1.e9, 60.));
+        plant->initialize(false);
+        plant->simulate(simtime, false);
+        plant->setSoilGrid([](double x, double y, double z) { return std::max(int(std::floor(-z)), -1); });
+        double TairC = 20., RH = 0.6;
+        double es = 6.112*std::exp((17.67*TairC)/(TairC + 243.5));
+        double ea = es*RH;
+        std::vector<double> sx(60);
+        for (int i = 0; i<60; i++) {
+            sx[i] = -700. + i; // hydrostatic, cell i is the layer [-i-1, -i] cm
+        }
+        std::shared_ptr<Photosynthesis> r;
+        b.run("Photosynthesis::solve_photosynthesis", "Triticum_aestivum_adapted_2023 " + std::to_string((int)simtime) + "d",
+            [&]() { r->solve_photosynthesis(ea, es, simtime, sx, true); return (double)plant->segments.size(); },
+            [&]() {
+                r = std::make_shared<Photosynthesis>(plant, sx[0], 350e-6*0.5);
+                r->setKr({ { 6.5e-5, 8.1e-5, 8.1e-5, 6.5e-5 }, { 0., 0. }, { 3.9e-4 } }, { });
+                r->setKx({ { 4.3e-1, 8.6e-3, 8.6e-3, 1.4e-4 }, { 7.4e1, 7.4e1 }, { 2.6e1 } }, { });
+                r->psi_air = -954378.;
+                r->Qlight = 9.6e-4;
+                r->cs = 350e-6;
+                r->Chl = { 55. };
+            });
+    }
+}
+
+/**
+ * SegmentAnalyser::crop and SegmentAnalyser::distribution
+ */
+void segmentAnalyser(Benchmark& b) {
+    auto rs = rootSystem("Zea_mays_1_Leitner_2010", 30.);
+    SegmentAnalyser ana;
+    b.run("SegmentAnalyser::crop", "Zea_mays_1_Leitner_2010 30d",
+        [&]() { ana.crop(std::make_shared<SDF_PlantBox>(10., 10., 50.)); return (double)ana.segments.size(); },
+        [&]() { ana = SegmentAnalyser(*rs); });
+    ana = SegmentAnalyser(*rs);
+    for (bool exact : { false, true }) {
+        b.run("SegmentAnalyser::distribution", std::string("Zea_mays_1_Leitner_2010 30d ") + (exact ? "exact" : "mid"),
+            [&]() { return (double)ana.distribution("length", 0., -100., 100, exact).size(); });
+    }
+}
+
+/**
+ * ExudationModel::calculate on grids of increasing resolution
+ */
+void exudation(Benchmark& b) {
+    auto rs = rootSystem("Anagallis_femina_Leitner_2010", 10.);
+    for (int n : { 10, 20 }) {
+        std::shared_ptr<ExudationModel> model;
+        b.run("ExudationModel::calculate", "Anagallis_femina_Leitner_2010 10d " + std::to_string(n)+"^3",
+            [&]() { return (double)model->calculate(10.).size(); },
+            [&]() { model = std::make_shared<ExudationModel>(20., 20., n, rs); });
+    }
+}
+
+/**
+ * Organism::writeVTP in all formats, and Organism::writeRSML
+ */
+void output(Benchmark& b) {
+    auto rs = rootSystem("Zea_mays_1_Leitner_2010", 30.);
+    for (int format : { 0, 1, 2 }) {
+        for (bool compressed : { false, true }) {
+            if (format==0 && compressed) {
+                continue;
+            }
+            b.run("Organism::writeVTP", "format=" + std::to_string(format) + (compressed ? " compressed" : ""),
+                [&]() {
+                    std::ostringstream os;
+                    rs->writeVTP(-1, os, format, compressed);
+                    return (double)os.str().size(); });
+        }
+    }
+    std::string name = "benchmark_output.rsml";
+    b.run("Organism::writeRSML", "Zea_mays_1_Leitner_2010 30d",
+        [&]() { rs->writeRSML(name); return (double)rs->getNumberOfSegments(); });
+    std::remove(name.c_str());
+}
+
+int main(int argc, char** argv) {
+    Benchmark b(argc, argv);
+    simulate(b);
+    mapping(b);
+    xylemFlux(b);
+    photosynthesis(b);
+    segmentAnalyser(b);
+    exudation(b);
+    output(b);
+    b.write();
+    return 0;
+}
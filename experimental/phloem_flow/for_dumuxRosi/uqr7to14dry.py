@@ -509,9 +509,7 @@ while simDuration < simMax:
     
     print('simDuration:',simDuration )
     
-    ot_4phloem = r.plant.organTypes # np.insert(,0,2)
-    ot_4phloem.insert(0,2)#first node 
-    ot_4phloem = np.array(ot_4phloem)
+    ot_4phloem = np.insert(r.plant.organTypes, 0, 2) # first node
     
     weatherX = weather(simDuration)
 
@@ -705,9 +705,7 @@ def launchUQR(directoryN,simInit,simStartSim, condition,csChoise,spellDuration):
 
         print('simDuration:',simDuration )
 
-        ot_4phloem = r.plant.organTypes # np.insert(,0,2)
-        ot_4phloem.insert(0,2)#first node 
-        ot_4phloem = np.array(ot_4phloem)
+        ot_4phloem = np.insert(r.plant.organTypes, 0, 2) # first node
         
         hp = max([tempnode[2] for tempnode in r.get_nodes()]) /100 #maxnode canopy [m]
         #print([tempnode[2] for tempnode in r.get_nodes()], hp)
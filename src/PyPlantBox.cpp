@@ -2,6 +2,7 @@
 #include "external/pybind11/include/pybind11/pybind11.h"
 #include "external/pybind11/include/pybind11/stl.h"
 #include "external/pybind11/include/pybind11/functional.h"
+#include "external/pybind11/include/pybind11/numpy.h"
 namespace py = pybind11;
 
 /**
@@ -27,6 +28,8 @@ namespace py = pybind11;
 #include "RootSystem.h"
 #include "Plant.h"
 #include "MappedOrganism.h"
+#include "VTPWriter.h"
+#include "Ensemble.h"
 
 // functional
 #include "Perirhizal.h"
@@ -47,6 +50,68 @@ namespace py = pybind11;
 
 namespace CPlantBox {
 
+/**
+ * Makes the NumPy array @param a read-only
+ */
+template<class T>
+py::array_t<T> readOnly(py::array_t<T> a)
+{
+    py::detail::array_proxy(a.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+    return a;
+}
+
+/**
+ * Read-only NumPy array with a copy of the vector @param v (a single memcpy instead of a Python object per entry).
+ * The array does not change with the vector, assign a new array to the property instead of writing into it.
+ */
+template<class T>
+py::array_t<T> vectorCopy(const std::vector<T>& v)
+{
+    return readOnly(py::array_t<T>(v.size(), v.data())); // without a base object the data are copied
+}
+
+/**
+ * NumPy array (N,d) sharing the memory of a vector @param v of N small vectors (e.g. Vector3d, Vector2i) with d entries of type T,
+ * that keeps @param owner alive.
+ */
+template<class T, class V>
+py::array_t<T> matrixArray(const std::vector<V>& v, py::handle owner)
+{
+    static_assert(sizeof(V) % sizeof(T) == 0, "V must consist of entries of type T");
+    return py::array_t<T>({ v.size(), sizeof(V) / sizeof(T) }, { sizeof(V), sizeof(T) }, reinterpret_cast<const T*>(v.data()), owner);
+}
+
+/**
+ * Read-only NumPy view (N,d) of the vector @param v (no copy), @see matrixArray, its base keeps @param owner alive.
+ * Only valid as long as the vector is neither destroyed nor reallocated, e.g. views of the MappedSegments
+ * vectors are invalid after the next simulate call (access the property again, or copy the view with numpy.array).
+ */
+template<class T, class V>
+py::array_t<T> matrixView(const std::vector<V>& v, py::handle owner = py::none())
+{
+    return readOnly(matrixArray<T>(v, owner));
+}
+
+/**
+ * Read-only NumPy view of the vector @param v (no copy), its base keeps @param owner alive, @see matrixView
+ */
+template<class T>
+py::array_t<T> vectorView(const std::vector<T>& v, py::handle owner)
+{
+    return readOnly(py::array_t<T>({ v.size() }, { sizeof(T) }, v.data(), owner));
+}
+
+/**
+ * Moves the vector @param v into a NumPy array (N,d), without creating a Python object per entry, @see matrixArray
+ */
+template<class T, class V>
+py::array_t<T> toMatrix(std::vector<V>&& v)
+{
+    auto data = new std::vector<V>(std::move(v));
+    py::capsule owner(data, [](void* p) { delete reinterpret_cast<std::vector<V>*>(p); });
+    return matrixArray<T>(*data, owner);
+}
+
 /**
  * Trampoline classes
  *
@@ -284,6 +349,7 @@ PYBIND11_MODULE(plantbox, m) {
             .def("copy",&OrganRandomParameter::copy)
             .def("realize",&OrganRandomParameter::realize)
             .def("getParameter",&OrganRandomParameter::getParameter)
+            .def("setParameter",&OrganRandomParameter::setParameter)
             .def("__str__",&OrganRandomParameter::toString, py::arg("verbose") = true) // default
             .def("writeXML",(void (OrganRandomParameter::*)(std::string name) const) &OrganRandomParameter::writeXML) // overloads
             .def("readXML", (void (OrganRandomParameter::*)(std::string name, bool verbose)) &OrganRandomParameter::readXML, py::arg("name"), py::arg("verbose") = false) // overloads
@@ -313,9 +379,9 @@ PYBIND11_MODULE(plantbox, m) {
     py::class_<Organ, std::shared_ptr<Organ>>(m, "Organ")
             .def(py::init<std::shared_ptr<Organism>, std::shared_ptr<Organ>, int, int, double, int>())
             .def(py::init<int, std::shared_ptr<const OrganSpecificParameter>, bool, bool, double, double, Vector3d, int, bool, int>())
-            .def("copy",&Organ::copy)
+            .def("copy",&Organ::copy, py::arg("plant"), py::arg("share") = false)
             .def("organType",&Organ::organType)
-            .def("simulate",&Organ::simulate, py::arg("dt"), py::arg("verbose") = bool(false) ) // default
+            .def("simulate",&Organ::simulate, py::arg("dt"), py::arg("verbose") = bool(false), py::call_guard<py::gil_scoped_release>()) // default
 			.def("getNumberOfLaterals", &Organ::getNumberOfLaterals)
 			.def("setParent",&Organ::setParent)
             .def("getParent",&Organ::getParent)
@@ -352,7 +418,11 @@ PYBIND11_MODULE(plantbox, m) {
             .def("getNodes",&Organ::getNodes)
             .def("getOrgans", (std::vector<std::shared_ptr<Organ>> (Organ::*)(int otype, bool all)) &Organ::getOrgans, py::arg("ot")=-1, py::arg("all")=false) //overloads, default
             .def("getOrgans", (void (Organ::*)(int otype, std::vector<std::shared_ptr<Organ>>& v, bool all)) &Organ::getOrgans)
-            .def("getParameter",&Organ::getParameter)
+            .def("getParameter",(double (Organ::*)(std::string) const) &Organ::getParameter)
+            .def("getParameter",(double (Organ::*)(int) const) &Organ::getParameter)
+            .def_static("parameterKey",&Organ::parameterKey)
+            .def_static("parameterName",&Organ::parameterName)
+            .def_readonly_static("parameterKeyNames", &Organ::parameterKeyNames)
             .def("__str__",&Organ::toString)
             .def("orgVolume",&Organ::orgVolume, py::arg("length_")=-1, py::arg("realized")=false)
 			.def("orgVolume2Length",&Organ::orgVolume2Length)
@@ -362,9 +432,20 @@ PYBIND11_MODULE(plantbox, m) {
     /*
      * Organism.h
      */
+    py::class_<StepDelta>(m, "StepDelta")
+            .def_readonly("movedNodeIds", &StepDelta::movedNodeIds)
+            .def_readonly("movedNodes", &StepDelta::movedNodes)
+            .def_readonly("movedNodeCTs", &StepDelta::movedNodeCTs)
+            .def_readonly("newNodes", &StepDelta::newNodes)
+            .def_readonly("newNodeCTs", &StepDelta::newNodeCTs)
+            .def_readonly("newSegments", &StepDelta::newSegments)
+            .def_readonly("newSegmentOrigins", &StepDelta::newSegmentOrigins)
+            .def_readonly("newSegmentOrganTypes", &StepDelta::newSegmentOrganTypes)
+            .def_readonly("organs", &StepDelta::organs);
     py::class_<Organism, std::shared_ptr<Organism>>(m, "Organism")
             .def(py::init<unsigned int>(),  py::arg("seednum") = 0)
-            .def("copy", &Organism::copy)
+            .def("copy", &Organism::copy, py::arg("share") = false)
+            .def("fork", &Organism::fork)
             .def("organTypeNumber", &Organism::organTypeNumber)
             .def("organTypeName", &Organism::organTypeName)
             .def("getOrganRandomParameter", (std::shared_ptr<OrganRandomParameter> (Organism::*)(int, int) const)  &Organism::getOrganRandomParameter) //overloads
@@ -374,11 +455,16 @@ PYBIND11_MODULE(plantbox, m) {
 
             .def("addOrgan", &Organism::addOrgan)
             .def("initialize", &Organism::initialize, py::arg("verbose") = true)
-            .def("simulate", &Organism::simulate, py::arg("dt"), py::arg("verbose") = false) //default
+            .def("simulate", &Organism::simulate, py::arg("dt"), py::arg("verbose") = false, py::call_guard<py::gil_scoped_release>()) // default, releases the GIL for Organism::setParallel
             .def("getSimTime", &Organism::getSimTime)
+            .def("setParallel", &Organism::setParallel)
+            .def("setSkipFinished", &Organism::setSkipFinished)
+            .def("getSkipFinished", &Organism::getSkipFinished)
+            .def("getParallel", &Organism::getParallel)
 
             .def("getOrgans", &Organism::getOrgans, py::arg("ot") = -1, py::arg("allOrgs")=false) // default
             .def("getParameter", &Organism::getParameter, py::arg("name"), py::arg("ot") = -1, py::arg("organs") = std::vector<std::shared_ptr<Organ>>(0)) // default
+            .def("getParameters", &Organism::getParameters, py::arg("names"), py::arg("ot") = -1, py::arg("organs") = std::vector<std::shared_ptr<Organ>>(0))
             .def("getSummed", &Organism::getSummed, py::arg("name"), py::arg("ot") = -1) // default
 
             .def("getNumberOfOrgans", &Organism::getNumberOfOrgans)
@@ -389,6 +475,8 @@ PYBIND11_MODULE(plantbox, m) {
             .def("getNodes", &Organism::getNodes)
             .def("getNodeCTs", &Organism::getNodeCTs)
             .def("getSegments", &Organism::getSegments, py::arg("ot") = -1) // default
+            .def("getNodesArray", [](const Organism& o) { return toMatrix<double>(o.getNodes()); }) // (N,3) numpy array
+            .def("getSegmentsArray", [](const Organism& o, int ot) { return toMatrix<int>(o.getSegments(ot)); }, py::arg("ot") = -1) // (N,2) numpy array
             .def("getSegmentCTs", &Organism::getSegmentCTs, py::arg("ot") = -1) // default
             .def("getSegmentOrigins", &Organism::getSegmentOrigins, py::arg("ot") = -1) // default
 
@@ -402,6 +490,7 @@ PYBIND11_MODULE(plantbox, m) {
             .def("getNewNodeCTs", &Organism::getNewNodeCTs)
             .def("getNewSegments", &Organism::getNewSegments, py::arg("ot") = -1)  // default
             .def("getNewSegmentOrigins", &Organism::getNewSegmentOrigins, py::arg("ot") = -1)  // default
+            .def("getStepDelta", &Organism::getStepDelta, py::return_value_policy::reference_internal)
 
             .def("initializeReader", &Organism::initializeReader)
             .def("readParameters", &Organism::readParameters, py::arg("name"), py::arg("basetag") = "plant", py::arg("fromFile") = true, py::arg("verbose") = false)  // default
@@ -430,6 +519,12 @@ PYBIND11_MODULE(plantbox, m) {
             .value("stem", Organism::OrganTypes::ot_stem)
             .value("leaf", Organism::OrganTypes::ot_leaf)
             .export_values();
+    py::enum_<VTPWriter::Format>(m, "VTPFormat")
+            .value("ascii", VTPWriter::Format::ascii)
+            .value("raw", VTPWriter::Format::raw)
+            .value("base64", VTPWriter::Format::base64);
+    py::class_<VTPWriter>(m, "VTPWriter")
+            .def_static("hasCompression", &VTPWriter::hasCompression); // true, if compressed vtp output is available
     /*
      * soil.h
      */
@@ -509,6 +604,29 @@ PYBIND11_MODULE(plantbox, m) {
     //    py::class_<CombinedTropism, Tropism>(m, "CombinedTropism") // Todo constructors needs some extra work (?)
     //        .def(py::init<>());
     // todo antigravi, twist ...
+    /*
+     * Ensemble.h
+     */
+    py::class_<Ensemble, std::shared_ptr<Ensemble>>(m, "Ensemble")
+           .def(py::init<std::shared_ptr<Organism>>())
+           .def("addMember", &Ensemble::addMember)
+           .def("setParameter", &Ensemble::setParameter)
+           .def("getNumberOfMembers", &Ensemble::getNumberOfMembers)
+           .def("run", &Ensemble::run, py::call_guard<py::gil_scoped_release>())
+           .def("getMember", &Ensemble::getMember)
+           .def_readwrite("threads", &Ensemble::threads)
+           .def_readwrite("keepMembers", &Ensemble::keepMembers)
+           .def_readwrite("summedNames", &Ensemble::summedNames)
+           .def_readwrite("summedOrganType", &Ensemble::summedOrganType)
+           .def_readwrite("distributionName", &Ensemble::distributionName)
+           .def_readwrite("distributionTop", &Ensemble::distributionTop)
+           .def_readwrite("distributionBot", &Ensemble::distributionBot)
+           .def_readwrite("distributionLayers", &Ensemble::distributionLayers)
+           .def_readwrite("distributionExact", &Ensemble::distributionExact)
+           .def_readonly("summed", &Ensemble::summed)
+           .def_readonly("numberOfNodes", &Ensemble::numberOfNodes)
+           .def_readonly("numberOfOrgans", &Ensemble::numberOfOrgans)
+           .def_readonly("distribution", &Ensemble::distribution);
     /*
      * analysis.h
      */
@@ -526,10 +644,13 @@ PYBIND11_MODULE(plantbox, m) {
            .def("addHydraulicConductivities", &SegmentAnalyser::addHydraulicConductivities, py::arg("rs"), py::arg("simTime"), py::arg("kr_max") = 1.e6, py::arg("kx_max") = 1.e6)
            .def("addFluxes", &SegmentAnalyser::addFluxes)
            .def("addCellIds", &SegmentAnalyser::addCellIds)
-           .def("crop", &SegmentAnalyser::crop)
+           .def("crop", &SegmentAnalyser::crop, py::call_guard<py::gil_scoped_release>())
            .def("cropDomain", &SegmentAnalyser::cropDomain)
            .def("filter", (void (SegmentAnalyser::*)(std::string, double, double)) &SegmentAnalyser::filter) //overloads
            .def("filter", (void (SegmentAnalyser::*)(std::string, double)) &SegmentAnalyser::filter) //overloads
+           .def("select", &SegmentAnalyser::select)
+           .def("setParallel", &SegmentAnalyser::setParallel)
+           .def("getParallel", &SegmentAnalyser::getParallel)
            .def("pack", &SegmentAnalyser::pack)
            .def("getMinBounds", &SegmentAnalyser::getMinBounds)
            .def("getMaxBounds", &SegmentAnalyser::getMaxBounds)
@@ -541,13 +662,23 @@ PYBIND11_MODULE(plantbox, m) {
            .def("distribution", (std::vector<SegmentAnalyser> (SegmentAnalyser::*)(double, double, int) const) &SegmentAnalyser::distribution) //overloads
            .def("distribution2", (std::vector<std::vector<double>> (SegmentAnalyser::*)(std::string, double, double, double, double, int, int, bool) const) &SegmentAnalyser::distribution2) //overloads
            .def("distribution2", (std::vector<std::vector<SegmentAnalyser>> (SegmentAnalyser::*)(double, double, double, double, int, int) const) &SegmentAnalyser::distribution2) //overloads
+           .def("distribution3", (std::vector<double> (SegmentAnalyser::*)(std::string, Vector3d, Vector3d, int, int, int, bool) const) &SegmentAnalyser::distribution3,
+                py::arg("name"), py::arg("min"), py::arg("max"), py::arg("nx"), py::arg("ny"), py::arg("nz"), py::arg("exact") = false) //overloads
+           .def("distribution3", (std::vector<std::vector<double>> (SegmentAnalyser::*)(const std::vector<std::string>&, Vector3d, Vector3d, int, int, int, bool) const) &SegmentAnalyser::distribution3,
+                py::arg("names"), py::arg("min"), py::arg("max"), py::arg("nx"), py::arg("ny"), py::arg("nz"), py::arg("exact") = false) //overloads
            .def("mapPeriodic", &SegmentAnalyser::mapPeriodic)
            .def("map2D", &SegmentAnalyser::map2D)
            .def("getOrgans", &SegmentAnalyser::getOrgans)
            .def("getNumberOfOrgans", &SegmentAnalyser::getNumberOfOrgans)
            .def("cut", (SegmentAnalyser (SegmentAnalyser::*)(const SDF_HalfPlane&) const) &SegmentAnalyser::cut)
+           .def_static("voxelise", [](const Vector3d& a, const Vector3d& b, const Vector3d& min, const Vector3d& max, int nx, int ny, int nz) {
+                std::vector<int> cells;
+                std::vector<double> t;
+                SegmentAnalyser::voxelise(a, b, min, max, nx, ny, nz, cells, t);
+                return std::make_tuple(cells, t); })
            .def("addData", &SegmentAnalyser::addData)
-           .def("write", &SegmentAnalyser::write, py::arg("name"), py::arg("types") = std::vector<std::string>({"radius", "subType", "creationTime", "organType"}))
+           .def("write", &SegmentAnalyser::write, py::arg("name"), py::arg("types") = std::vector<std::string>({"radius", "subType", "creationTime", "organType"}),
+                py::arg("format") = 0, py::arg("compressed") = false)
            .def_readwrite("nodes", &SegmentAnalyser::nodes)
            .def_readwrite("segments", &SegmentAnalyser::segments)
            .def_readwrite("segO", &SegmentAnalyser::segO)
@@ -833,9 +964,9 @@ PYBIND11_MODULE(plantbox, m) {
             .def("initializeLB", (void (RootSystem::*)(int, int, bool)) &RootSystem::initializeLB, py::arg("basal"), py::arg("shootborne"), py::arg("verbose") = true)
             .def("initializeDB", (void (RootSystem::*)(int, int, bool)) &RootSystem::initializeDB, py::arg("basal"), py::arg("shootborne"), py::arg("verbose") = true)
 			.def("setTropism", &RootSystem::setTropism)
-            .def("simulate",(void (RootSystem::*)(double,bool)) &RootSystem::simulate, py::arg("dt"), py::arg("verbose") = false)
-            .def("simulate",(void (RootSystem::*)()) &RootSystem::simulate)
-            .def("simulate",(void (RootSystem::*)(double, double, ProportionalElongation*, bool)) &RootSystem::simulate)
+            .def("simulate",(void (RootSystem::*)(double,bool)) &RootSystem::simulate, py::arg("dt"), py::arg("verbose") = false, py::call_guard<py::gil_scoped_release>())
+            .def("simulate",(void (RootSystem::*)()) &RootSystem::simulate, py::call_guard<py::gil_scoped_release>())
+            .def("simulate",(void (RootSystem::*)(double, double, ProportionalElongation*, bool)) &RootSystem::simulate, py::call_guard<py::gil_scoped_release>())
             .def("getRoots", &RootSystem::getRoots)
             .def("initCallbacks", &RootSystem::initCallbacks)
             .def("createTropismFunction", &RootSystem::createTropismFunction)
@@ -847,10 +978,36 @@ PYBIND11_MODULE(plantbox, m) {
             .def("getRootBases", &RootSystem::getRootBases)
             .def("push",&RootSystem::push)
             .def("pop",&RootSystem::pop)
-            .def("write", &RootSystem::write);
+            .def("write", &RootSystem::write, py::arg("name"), py::arg("format") = 0, py::arg("compressed") = false);
     /*
      * MappedOrganism.h
      */
+    py::class_<Cell2SegMapper>(m, "Cell2SegMapper") // behaves like the former dict
+        .def("count", &Cell2SegMapper::count)
+        .def("cells", &Cell2SegMapper::cells)
+        .def("keys", &Cell2SegMapper::cells)
+        .def("values", [](const Cell2SegMapper& c) {
+            std::vector<std::vector<int>> v;
+            for (int i : c.cells()) {
+                v.push_back(c.at(i));
+            }
+            return v; })
+        .def("items", [](const Cell2SegMapper& c) {
+            std::vector<std::pair<int, std::vector<int>>> v;
+            for (int i : c.cells()) {
+                v.push_back(std::make_pair(i, std::vector<int>(c.at(i))));
+            }
+            return v; })
+        .def("__len__", &Cell2SegMapper::size)
+        .def("__contains__", [](const Cell2SegMapper& c, int cellIdx) { return c.count(cellIdx)>0; })
+        .def("__getitem__", [](const Cell2SegMapper& c, int cellIdx) {
+            if (c.count(cellIdx)==0) {
+                throw py::key_error(std::to_string(cellIdx));
+            }
+            return std::vector<int>(c.at(cellIdx)); })
+        .def("__iter__", [](const Cell2SegMapper& c) { return py::iter(py::cast(c.cells())); })
+        .def_property_readonly("offsets", [](const Cell2SegMapper& c) { return vectorCopy(c.offsets); })
+        .def_property_readonly("segments", [](const Cell2SegMapper& c) { return vectorCopy(c.segments); });
     py::class_<MappedSegments, std::shared_ptr<MappedSegments>>(m, "MappedSegments")
         .def(py::init<>())
         .def(py::init<std::vector<Vector3d>, std::vector<double>, std::vector<Vector2i>, std::vector<double>, std::vector<int>,  std::vector<int>>())
@@ -863,7 +1020,17 @@ PYBIND11_MODULE(plantbox, m) {
         .def("setSoilGrid", (void (MappedSegments::*)(const std::function<int(double,double,double)>&, Vector3d, Vector3d, Vector3d, bool)) &MappedSegments::setSoilGrid,
         		py::arg("s"), py::arg("min"), py::arg("max"), py::arg("res"), py::arg("cut") = true)
         .def("setRectangularGrid", &MappedSegments::setRectangularGrid, py::arg("min"), py::arg("max"), py::arg("res"), py::arg("cut") = true, py::arg("noChanges") = false)
+        .def("setSoilIndices", [](MappedSegments& ms, py::function f) { // f takes a (N,3) numpy array of points, returns N cell indices
+            ms.setSoilIndices([f](const std::vector<Vector3d>& points) {
+                py::gil_scoped_acquire acquire; // e.g. called within simulate, which releases the GIL
+                auto c = py::array_t<int, py::array::c_style | py::array::forcecast>::ensure(f(matrixView<double>(points))); // view is valid during the call
+                if (!c) {
+                    throw std::invalid_argument("MappedSegments.setSoilIndices: call back must return an array of cell indices");
+                }
+                return std::vector<int>(c.data(), c.data() + c.size());
+            }); }, py::arg("f"))
         .def("mapSegments",  &MappedSegments::mapSegments)
+        .def("soilIndices",  &MappedSegments::soilIndices)
         .def("cutSegments", &MappedSegments::cutSegments)
         .def_readwrite("soil_index", &MappedSegments::soil_index)
         .def("sort",&MappedSegments::sort)
@@ -874,14 +1041,21 @@ PYBIND11_MODULE(plantbox, m) {
         .def("getSegmentMapper",&MappedSegments::getSegmentMapper)
         .def("getSegmentZ",&MappedSegments::getSegmentZ)
         .def_readwrite("nodes", &MappedSegments::nodes)
-        .def_readwrite("nodeCTs", &MappedSegments::nodeCTs)
         .def_readwrite("segments", &MappedSegments::segments)
-        .def_readwrite("radii", &MappedSegments::radii)
-        .def_readwrite("organTypes", &MappedSegments::organTypes)
-        .def_readwrite("Types", &MappedSegments::subTypes) //kept for backward compatibility
-        .def_readwrite("subTypes", &MappedSegments::subTypes)
-        .def_readwrite("seg2cell", &MappedSegments::seg2cell)
-        .def_readwrite("cell2seg", &MappedSegments::cell2seg)
+        .def_property_readonly("nodesArray", [](py::object ms) { return matrixView<double>(ms.cast<const MappedSegments&>().nodes, ms); }) // (N,3) numpy view
+        .def_property_readonly("segmentsArray", [](py::object ms) { return matrixView<int>(ms.cast<const MappedSegments&>().segments, ms); }) // (N,2) numpy view
+        .def_property("nodeCTs", [](py::object ms) { return vectorView(ms.cast<const MappedSegments&>().nodeCTs, ms); }, // numpy views (see matrixView)
+            [](MappedSegments& ms, const std::vector<double>& v) { ms.nodeCTs = v; })
+        .def_property("radii", [](py::object ms) { return vectorView(ms.cast<const MappedSegments&>().radii, ms); },
+            [](MappedSegments& ms, const std::vector<double>& v) { ms.radii = v; })
+        .def_property("organTypes", [](py::object ms) { return vectorView(ms.cast<const MappedSegments&>().organTypes, ms); },
+            [](MappedSegments& ms, const std::vector<int>& v) { ms.organTypes = v; })
+        .def_property("Types", [](py::object ms) { return vectorView(ms.cast<const MappedSegments&>().subTypes, ms); }, //kept for backward compatibility
+            [](MappedSegments& ms, const std::vector<int>& v) { ms.subTypes = v; })
+        .def_property("subTypes", [](py::object ms) { return vectorView(ms.cast<const MappedSegments&>().subTypes, ms); },
+            [](MappedSegments& ms, const std::vector<int>& v) { ms.subTypes = v; })
+        .def_property_readonly("seg2cell", [](py::object ms) { return vectorView(ms.cast<const MappedSegments&>().seg2cell, ms); }) // numpy view
+        .def_readonly("cell2seg", &MappedSegments::cell2seg)
         .def_readwrite("minBound", &MappedSegments::minBound)
         .def_readwrite("maxBound", &MappedSegments::maxBound)
         .def_readwrite("resolution", &MappedSegments::resolution)
@@ -904,12 +1078,12 @@ PYBIND11_MODULE(plantbox, m) {
             .def("reset", &Plant::reset)
             .def("openXML", &Plant::openXML)
             .def("setTropism", &Plant::setTropism)
-            .def("simulate",(void (Plant::*)(double,bool)) &Plant::simulate, py::arg("dt"), py::arg("verbose") = false)
-            .def("simulate",(void (Plant::*)()) &Plant::simulate)
+            .def("simulate",(void (Plant::*)(double,bool)) &Plant::simulate, py::arg("dt"), py::arg("verbose") = false, py::call_guard<py::gil_scoped_release>())
+            .def("simulate",(void (Plant::*)()) &Plant::simulate, py::call_guard<py::gil_scoped_release>())
             .def("initCallbacks", &Plant::initCallbacks)
             .def("createTropismFunction", &Plant::createTropismFunction)
             .def("createGrowthFunction", &Plant::createGrowthFunction)
-            .def("write", &Plant::write)
+            .def("write", &Plant::write, py::arg("name"), py::arg("format") = 0, py::arg("compressed") = false)
             .def("abs2rel", &Plant::abs2rel)
             .def("rel2abs", &Plant::rel2abs);
 
@@ -966,6 +1140,8 @@ PYBIND11_MODULE(plantbox, m) {
             .def("getKx", &XylemFlux::getKx)
             .def("linearSystem",&XylemFlux::linearSystem, py::arg("simTime") , py::arg("sx") , py::arg("cells") = true,
                     py::arg("soil_k") = std::vector<double>(), py::arg("verbose")=false)
+            .def("solve_cpp",&XylemFlux::solve, py::arg("simTime"), py::arg("sx"), py::arg("cells"), py::arg("bcNodes"), py::arg("bcValues"),
+                    py::arg("dirichlet") = false, py::arg("soil_k") = std::vector<double>(), py::arg("verbose")=false)
             .def("soilFluxes",&XylemFlux::soilFluxes, py::arg("simTime"), py::arg("rx"), py::arg("sx"), py::arg("approx") = false,
                     py::arg("soil_k") = std::vector<double>())
             .def("segFluxes",&XylemFlux::segFluxes, py::arg("simTime"), py::arg("rx"), py::arg("sx"), py::arg("approx") = false,
@@ -1019,6 +1195,8 @@ PYBIND11_MODULE(plantbox, m) {
             .def(py::init<std::shared_ptr<MappedSegments>, std::shared_ptr<PlantHydraulicParameters>>())
 
             .def("linearSystemMeunier",&PlantHydraulicModel::linearSystemMeunier, py::arg("simTime") , py::arg("sx") , py::arg("cells") = true)
+            .def("solve_cpp",&PlantHydraulicModel::solve, py::arg("simTime"), py::arg("sx"), py::arg("cells"), py::arg("bcNodes"), py::arg("bcValues"),
+                    py::arg("dirichlet") = false)
             .def("getRadialFluxes", &PlantHydraulicModel::getRadialFluxes)
             .def("sumSegFluxes", &PlantHydraulicModel::sumSegFluxes)
             .def_readwrite("rs", &PlantHydraulicModel::rs)
@@ -1132,7 +1310,7 @@ PYBIND11_MODULE(plantbox, m) {
             .def("setRhoSucrose",&PhloemFlux::setRhoSucrose, py::arg("values"), py::arg("verbose") = false)
             .def("setKrm1",&PhloemFlux::setKrm1, py::arg("values"), py::arg("verbose") = false)
             .def("setKrm2",&PhloemFlux::setKrm2, py::arg("values"), py::arg("verbose") = false)
-			.def("startPM",&PhloemFlux::startPM)
+			.def("startPM",&PhloemFlux::startPM, py::call_guard<py::gil_scoped_release>())
             .def_readonly("rhoSucrose_f",&PhloemFlux::rhoSucrose_f)
             .def_readwrite("psiMin", &PhloemFlux::psiMin)
 
@@ -1256,7 +1434,9 @@ PYBIND11_MODULE(plantbox, m) {
             .def_readwrite("thresh13", &ExudationModel::thresh13)
             .def_readwrite("calc13", &ExudationModel::calc13)
             .def_readwrite("observationRadius", &ExudationModel::observationRadius)
-            .def("calculate",  &ExudationModel::calculate, py::arg("tend"), py::arg("i0") = 0, py::arg("iend")=-1);
+            .def_readwrite("threads", &ExudationModel::threads)
+            .def("calculate",  &ExudationModel::calculate, py::arg("tend"), py::arg("i0") = 0, py::arg("iend")=-1,
+                py::call_guard<py::gil_scoped_release>());
     py::enum_<ExudationModel::IntegrationType>(m, "IntegrationType")
             .value("mps_straight", ExudationModel::IntegrationType::mps_straight )
             .value("mps", ExudationModel::IntegrationType::mps )
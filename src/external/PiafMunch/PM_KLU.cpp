@@ -29,8 +29,8 @@
 #include <PiafMunch/PM_arrays.h>
 
 
-extern double r ;
-char KLU_message[1000] ;
+extern thread_local double r ;
+thread_local char KLU_message[1000] ;
 
 void KLU_LogMessage(const char* message) {
 	_LogMessage(message) ;
@@ -37,9 +37,11 @@ using namespace std;
 #include <sstream>
 #include <vector>
 
-extern char message[], name_[] ;
+extern thread_local char message[], name_[] ;
+extern thread_local ostream PM_cout ; // solver log of the calling thread, writes to std::cout unless redirected (see PhloemFlux::startPM)
 void _LogMessage(const char* message)  ;
 void Update_Output(bool unconditional = false) ;
+void Sparse_registers_clear() ; // empties the Sparse_XXX_set_ij registers of the calling thread (implemented in 'sparse_matrix.cpp')
 int MsgBox(const char* message, const char* titre = "Message", int button0 = 1024, int button1 = 0, int button2 = 0) ;
 
 // -- NOTATION DES MULTIPLICATIONS ENTRE DEUX ARRAYS (matrice x matrice, matrice x vecteur, vecteur x vecteur) ----------------
@@ -31,7 +31,8 @@
 #include <PiafMunch/PM_arrays.h>
 
 
-char message[10000], name_[300] ;
+thread_local char message[10000], name_[300] ;
+thread_local ostream PM_cout(cout.rdbuf()) ;
 
 void Update_Output(bool unconditional) {}
 
@@ -0,0 +1,264 @@
+/*
+* PiafMunch (v.2) -- Implementing and Solving the Munch model of phloem sap flow in higher plants
+*
+* Copyright (C) 2004-2019 INRA
+*
+* Author: A. Lacointe, UMR PIAF, Clermont-Ferrand, France
+*
+* File: PiafMunchContext.h
+*
+* This file is part of PiafMunch. PiafMunch is free software: you can redistribute it and/or
+* modify it under the terms of the GNU General Public License version 3.0 as published by
+* the Free Software Foundation and appearing in the file LICENSE.GPL included in the
+* packaging of this file. Please  review the following information to ensure the GNU
+* General Public License version 3.0  requirements will be met:
+* http://www.gnu.org/copyleft/gpl.html.
+*
+* PiafMunch is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+* without even the implied warranty of FITNESS FOR A PARTICULAR PURPOSE.
+* See the GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License along with PiafMunch.
+* If not, see <http://www.gnu.org/licenses/>.
+*
+-----------------------------------------------------------------------------------------------------------------------------------*/
+#ifndef PIAFMUNCHCONTEXT_H
+#define PIAFMUNCHCONTEXT_H
+
+#include <stdio.h>
+#include <list>
+#include <string>
+#include <vector>
+#include "PM_arrays.h"
+
+/**
+ * State of one PiafMunch solver, formerly the global variables of PiafMunch2.cpp, runPM.cpp, solve.cpp and initialize.cpp.
+ *
+ * PhloemFlux derives from it, so each PhloemFlux owns its solver state and the PiafMunch code keeps using the plain names.
+ * PhloemFlux value-initializes the base, i.e. all members start at zero (or their initializer), like the former globals.
+ * Free functions and solver callbacks reach the state through PM_context, which PhloemFlux::startPM binds to the running instance.
+ */
+struct PiafMunchContext
+{
+	PiafMunchContext() = default;
+	PiafMunchContext(const PiafMunchContext&) = delete; // the Refs lists point into the instance
+	PiafMunchContext& operator=(const PiafMunchContext&) = delete;
+
+	void OutputSettings() ; // sets up output times (implemented in 'runPM.cpp')
+	void UpdateResistances(double t) ; // called if (resistance_changed) (implemented in 'initialize.cpp')
+
+	// parameters and carbon variables (formerly in PiafMunch2.cpp) :
+	string GnuplotPath = "C:/gnuplot/bin/gnuplot.exe" ; // Path to GnuPlot executable, including executable file name
+	Fortran_vector Length;
+	Fortran_vector  Q_Exud, Q_Gr, Q_Rm, Q_Fl; 
+	Fortran_vector  Ag, Q_Grmax, Q_Rmmax, Q_Exudmax, exud_k, krm2, len_leaf;
+	// Tracer-related parameters :
+	double TracerHalfLife ; // (h) set in GUI (default = 0.33967 h  for 13C)
+	double TracerDecay_k ; // (h-1) exponential tracer decay coeff = ln(2) / TracerHalfLife
+	// param. for sympl. volume changes, elastic or irreversible (Lockhart) :
+	Fortran_vector k_Lockhart, P_thr, vol_Sympl_max ;
+	int solver = 1 ; // (int. in the range [1,35] -- see Main.cpp) solver config.# : normally the smaller the better -- but may change in specific configs. (very complex architecture and/or equations...). Try diff. value if calc. fails or unstable or too slow !
+	/******************************************  Environmental Variables / boundary conditions : *********************************************/
+	// The following 4 imposed (but possibly changing) external conditions are set/updated by the user in function  'parameter_and_boundary_conditions()' below :
+	double T ; // (K) absolute temperature : set in GUI, but may be updated anytime
+	Fortran_vector Transpirat		; // (mmol / h)  Leaf transpiration rate
+	Fortran_vector PsiSoil			; // (MPa)  Soil water potential at root end
+	double * vol_Sympl_dot = NULL ; // (ml / h) Variation rate of lateral parenchyma symplasm volume -- to implement pressure-dependent volume variation (reversible elastic reservoir, irreversible Lockhart growth...)
+	/******************* VARIABLES INVOLVED in CARBON METABOLISM AND FLUXES *******************************  */
+	// as components of function f argument double* y in the solving procedure, the first 3 are stored as double* ; all others are Fortran_vectors
+	double* Q_Mucil = NULL;
+	double* Q_S_ST = NULL;
+	double* Q_Mesophyll = NULL						; // Amount of sugar in parenchyma symplasm										(mmol)
+	double* Q_ST = NULL						; // Amount of sugar in sieve tubes	= C_TC * Vol_ST						(mmol)
+	double* Q_RespMaint = NULL						; // Amount of starch in parenchyma										(mmol)
+	double* Q_Exudation = NULL                 ; // amount of sugar in phloem apoplasm   (mmol)
+	double* Q_Growthtot = NULL                 ; // amount of sugar in lateral parenchyma apoplasm   (mmol)
+	Fortran_vector JS_ST						; // (mmol / h)  : Axial phloem sugar flux
+	Fortran_vector JS_PhlMb				; // Phloem cross-membrane sugar fluxes into sieve tubes from apoplasm				(mmol / h)
+	Fortran_vector RespMaint					; // Maintenance respiration rate										(mmol / h)
+	Fortran_vector Q_RespMaintSyn						; // Michaelis-Menten rate of starch synthesis from sugar substrate						(mmol sug.eq./ h)
+	Fortran_vector C_amont					; //  (mmol / ml) : ST Sugar concentration at upflow node
+	Fortran_vector Input					; // e.g. Leaf photosynthetic assimilation rate, but may occur at any node, whether 'leaf' or not (boundary condition)			(mmol / h)
+	Fortran_vector C_Sympl						; // Concentration of sugar in parenchyma = Q_Par / vol_Sympl			(mmol / ml)
+	Fortran_vector C_ST							; // Concentration of sugar in sieve tubes								(mmol / ml solution))
+	double* vol_Sympl = NULL							; // total volume of symplasm	(ml), which is a reservoir of variable size
+	Fortran_vector JS_Sympl						; // Symplasmic flux of sugar from Lateral parenchyma to phloem ST (mmol / h)
+	Fortran_vector JS_ParMb				; // Lateral parenchyma cross-membrane sugar flux into symplasm from apoplasm				(mmol / h)
+	Fortran_vector JS_Apo						; // apoplasmic sugar flux from phloem to Lateral parenchyma  (mmol / h)
+	Fortran_vector C_SymplUpflow					; // upflow concentration (mmol / ml) for JS_Sympl
+	Fortran_vector C_PhlApo, C_ParApo, C_ApoUpflow ; // (mmol / ml) apoplasmic sugar conc., resp. in phloem and lat.parenchyma, and upflow conc. for JS_Apo
+	Fortran_vector Delta_JS_ST ; // sera la composante purement phloemienne de Q_TC_dot[ ]							(mmol / h)
+	double Q_Rm_dot_alt ; // for an alternate, target-oriented,  expression of starch variation rate
+	/******** TRACER-RELATED VARIABLES ***********************************************************/
+	double* TracerQ_Mesophyll = NULL						; // Amount of tracer in parenchyma										(MBq)
+	double* Q_RespMaintmax = NULL						; // Amount of soluble tracer in sieve tubes	= TracerC_ST * Vol_ST						(MBq)
+	double* TracerQ_RespMaint = NULL						; // Amount of insoluble tracer in parenchyma										(MBq)
+	double *Q_S_Mesophyll=NULL, *Q_Growthtotmax=NULL ; // Amount of soluble tracer in apoplasm	= TracerC_xxxApo * Vol_xxxApo			(MBq)
+	Fortran_vector TracerJS_ST						; // TracerJS_ST[i] (MBq / h)  = TracerJS_ST_[i-1], i = 2..N  : Axial phloem soluble tracer flux ; TracerJS_ST[1]= NA, whereas TracerJS_ST_[1] = TracerJS_ST[2]
+	Fortran_vector TracerJS_PhlMb						; // Lateral (Apoplasmic) soluble tracer fluxes into sieve tubes from parenchyma				(MBq / h)
+	Fortran_vector TracerRespMaint					; // Tracer Maintenance respiration rate										(MBq / h)
+	Fortran_vector TracerQ_RespMaintSyn						; // Michaelis-Menten rate of tracer starch synthesis from tracer sugar substrate						(MBq / h)
+	Fortran_vector TracerInput					; // Leaf photosynthetic Tracer Assimilation rate (boundary condition)			(MBq / h)
+	Fortran_vector TracerC_Sympl						; // Concentration of soluble tracer in parenchyma symplasm= TracerQ_Mesophyll / vol_Sympl			(MBq / ml)
+	Fortran_vector TracerC_ST							; // Concentration of soluble tracer in sieve tubes								(MBq / ml solution))
+	Fortran_vector TracerC_PhlApo, TracerC_ParApo ; // Concentration of soluble tracer in apoplasms					(MBq / ml solution))
+	Fortran_vector TracerRatioSympl ; //   TracerQ_Mesophyll / Q_Mesophyll = TracerC_Sympl / C_Sympl  (MBq / mmol)
+	Fortran_vector TracerRatioQ_RespMaint ; //   = TracerQ_RespMaint / Q_RespMaint (MBq / mmol)
+	Fortran_vector Delta_TracerJS_ST ; // sera la composante purement phloemienne de Q_Rmmax_dot[ ]
+	Fortran_vector TracerJS_Sympl, TracerJS_Apo, TracerJS_ParMb ; // Lateral (Sympl., Apopl.; cross-membr...) soluble tracer fluxes FROM sieve tubes INTO parenchyma							(MBq / h)     !!! ATTENTION : sens positif oppose a JS_Trsv !!!
+	Fortran_vector TracerC_SymplUpflow					;  // upflow tracer concentration (mmol / ml) for TracerJS_Sympl
+	Fortran_vector TracerC_ApoUpflow ;				; // upflow tracer concentration (mmol / ml) for TracerJS_Apo
+	/******* variation rate of any variable X is noted: X_dot = dX/dt : *******/
+	double * Q_Mesophyll_dot = NULL, * Q_ST_dot = NULL, * Q_Rm_dot = NULL, *Q_Exud_dot = NULL, *Q_Gtot_dot = NULL,  *Q_S_ST_dot = NULL , *Q_Mucil_dot = NULL ;
+	double * TracerQ_Mesophyll_dot=NULL, * Q_Rmmax_dot=NULL, * TracerQ_Rm_dot=NULL, *Q_S_Mesophyll_dot=NULL, *Q_Gtotmax_dot=NULL ;
+	// Next 2 variables are not considered as such, but as possible inputs to compute vol_Sympl_dot :
+	Fortran_vector P_ST_dot, P_Sympl_dot			; //  dP_ST/dt , dP_Sympl/dt					(MPa h / h)    -- for elasticity...
+	/********************* C-FLUXES-RELATED BIOPHYSICAL and PHYSIOLOGICAL PARAMETERS **********************************/
+	Fortran_vector kML						; // kinetic parameter / Michaelis - phloem loading					(mmol / ml)
+	Fortran_vector vML					; // kinetic parameter / phloem loading								(mmol /h)
+	Fortran_vector kMU						; // kinetic parameter / Michaelis - phloem unloading					(mmol / ml)
+	Fortran_vector vMU					; // kinetic parameter / phloem unloading								(mmol /h)
+	Fortran_vector kMParMb			; // kinetic parameter / Michaelis - parenchyma crossmembrane C flux					(mmol / ml)
+	Fortran_vector vMParMb			; // kinetic parameter / Michaelis - parenchyma crossmembrane C flux					(mmol /h)
+	Fortran_vector kM						; // kinetic parameter / Michaelis - starch Synthesis					(mmol / ml)
+	Fortran_vector Vmax					; // kinetic parameter / starch Synthesis								(mmol ml-1 h-1)
+	Fortran_vector C_targ			  	; // kinetic parameter / starch/sugar equilibrium. (regul. par. sugar conc.) 			(mmol / ml)
+	Fortran_vector kHyd					; // kinetic parameter / starch hydrolysis								(h-1)
+	Fortran_vector k1					; // kinetic parameter / maintenance respiration 						(h-1)
+	Fortran_vector k2					; // kinetic parameter / maintenance respiration						(ml mmol-1 h-1)
+	Fortran_vector k3						; // kinetic parameter / starch/sugar equilibrium. (regul. par. sugar conc.) 			(h-1)
+	Fortran_vector StructC				; // structural C subject to maintenance respiration					(mmol sug. eq.)
+	Fortran_vector vol_ST, vol_ParApo, vol_PhlApo,vol_Seg ; // (ml) total volume of, resp. : sieve tubes, and  parenchyma and phloem apoplasm
+	Fortran_vector  radius_ST ; // vol_Sympl is considered a variable, driven by its variation rate -- see function  Smooth_Parameter_and_BoundaryConditions_Changes()  below
+
+	// solver settings and output buffers (formerly in runPM.cpp) :
+	vector<int> I_Upflow, I_Downflow ; //  I_Upflow(resp.I_Downflow)[jf=1..Nc] = id# of conv. upflow (resp. conv. downflow) node of internode flux #jf
+	int i,j;
+	float rs = 1.1f ; // (if relevant) rate of geometric increment of output step -- to be adjusted to yield 100 steps between t0 and tf
+	string term = "qt" ; // name of terminal for gnuplot (default "wxt" bugs with Windows)
+	vector<double> extra_output_times, breakpoint_times ; // may contain already existing output time points
+	// variables pointers are of type 'Fortran_vector*' (or NULL for those that are components of double* y in definition of function f).
+	// Check for consistency between these lists AllxxxxVariablesRefsQList hereafter and AllxxxxVariablesNamesQList[] above:
+	Fortran_vector* AllNodeVariablesRefsQList[62] = {  // 62 node variables :
+		&Absorb, NULL, &Q_RespMaintSyn, &C_ST, &C_Sympl, &JS_PhlMb, &JW_Trsv, &JW_PhlMb, &JW_ParMb, &Psi_ST,
+		&P_Xyl, NULL, NULL, &RespMaint, &C_SymplUpflow, &JS_Sympl, &JW_Apo, &JW_Sympl , &P_ST, &P_Sympl,
+		&Psi_PhlApo, &Psi_ParApo, &Psi_Sympl, NULL, NULL, &P_PhlApo, &P_ParApo, NULL, NULL,
+		&C_PhlApo, &C_ParApo, NULL, NULL, &JS_Apo, &JS_ParMb, &C_ApoUpflow,
+		&P_ST_dot, &P_Sympl_dot,  NULL, NULL, NULL, &Input, &Transpirat, &PsiSoil,
+		// tracer-specific add-ons :
+		NULL, &TracerQ_RespMaintSyn, &TracerC_ST, &TracerC_Sympl, &TracerJS_PhlMb, NULL, NULL, &TracerRespMaint,
+		&TracerInput, &TracerJS_Sympl, &TracerJS_ParMb, NULL, NULL, &TracerC_PhlApo,
+		&TracerC_ParApo, &TracerJS_Apo , &TracerC_SymplUpflow, &TracerC_ApoUpflow
+	} ;
+	Fortran_vector* AllConnVariablesRefsQList[5] = {&C_amont, &JS_ST,  &JW_ST, &JW_Xyl, &TracerJS_ST} ; // 5 internode-connector variables
+	// temporary storage of results for output :
+	Fortran_matrix Q_ST_t, Q_Mesophyll_t, Q_RespMaint_t, Q_Exudation_t, Q_Growthtot_t, Q_ST_dot_t, Q_Mesophyll_dot_t, Q_Rm_dot_t, Q_Exud_dot_t, Q_Gtot_dot_t, vol_Sympl_t, vol_Sympl_dot_t ;
+	Fortran_matrix JW_ST_t, JS_ST_t, C_Sympl_t, C_ST_t, JS_Sympl_t, JS_Apo_t, JS_ParMb_t, JS_PhlMb_t, Psi_Sympl_t, C_PhlApo_t, C_ParApo_t, P_ST_t, Absorb_t, RespMaint_t ;
+	Fortran_matrix JW_Trsv_t, JW_Xyl_t, JW_PhlMb_t, JW_ParMb_t, JW_Apo_t, JW_Sympl_t, P_Sympl_t, Psi_ST_t, P_Xyl_t, Psi_PhlApo_t, Psi_ParApo_t, P_PhlApo_t, P_ParApo_t ;
+	Fortran_matrix PsiSoil_t, Transpirat_t, Input_t, Q_RespMaintSyn_t, P_ST_dot_t, P_Sympl_dot_t, C_SymplUpflow_t, C_ApoUpflow_t, C_amont_t ;
+	// tracer-specific add-ins :
+	Fortran_matrix Q_RespMaintmax_t, TracerQ_Mesophyll_t, TracerQ_RespMaint_t, Q_S_Mesophyll_t, Q_Growthtotmax_t ;		  // components of vector y as used in diff. system f()...
+	Fortran_matrix TracerJS_ST_t, TracerC_Sympl_t, TracerC_ST_t, TracerJS_Sympl_t, TracerJS_Apo_t, TracerJS_ParMb_t, TracerJS_PhlMb_t, TracerC_PhlApo_t, TracerC_ParApo_t, TracerC_SymplUpflow_t, TracerC_ApoUpflow_t ;
+	Fortran_matrix TracerPhotSynth_t, TracerQ_RespMaintSyn_t, TracerInput_t, TracerRespMaint_t ;
+	Fortran_matrix* AllNodeMatricesRefsQList[62] = {
+		&Absorb_t, &Q_RespMaint_t, &Q_RespMaintSyn_t, &C_ST_t, &C_Sympl_t, &JS_PhlMb_t, &JW_Trsv_t, &JW_PhlMb_t, &JW_ParMb_t, &Psi_ST_t,
+		&P_Xyl_t, &Q_Mesophyll_t, &Q_ST_t, &RespMaint_t, &C_SymplUpflow_t, &JS_Sympl_t, &JW_Apo_t, &JW_Sympl_t, &P_ST_t, &P_Sympl_t,
+		&Psi_PhlApo_t, &Psi_ParApo_t, &Psi_Sympl_t, &vol_Sympl_t, &vol_Sympl_dot_t, &P_PhlApo_t, &P_ParApo_t, &Q_Exudation_t, &Q_Growthtot_t,
+		&C_PhlApo_t, &C_ParApo_t, &Q_Exud_dot_t, &Q_Gtot_dot_t, &JS_Apo_t, &JS_ParMb_t, &C_ApoUpflow_t,
+		&P_ST_dot_t, &P_Sympl_dot_t, &Q_Rm_dot_t, &Q_ST_dot_t, &Q_Mesophyll_dot_t, &Input_t, &Transpirat_t, &PsiSoil_t,
+		// tracer-specific add-ons :
+		&TracerQ_RespMaint_t, &TracerQ_RespMaintSyn_t, &TracerC_ST_t, &TracerC_Sympl_t, &TracerJS_PhlMb_t, &TracerQ_Mesophyll_t, &Q_RespMaintmax_t, &TracerRespMaint_t,
+		&TracerInput_t, &TracerJS_Sympl_t, &TracerJS_ParMb_t, &Q_S_Mesophyll_t, &Q_Growthtotmax_t, &TracerC_PhlApo_t,
+		&TracerC_ParApo_t, &TracerJS_Apo_t, &TracerC_SymplUpflow_t, &TracerC_ApoUpflow_t
+	};
+	Fortran_matrix* AllConnMatricesRefsQList[5] = {&C_amont_t, &JS_ST_t,  &JW_ST_t, &JW_Xyl_t, &TracerJS_ST_t} ;
+	Index_vector Breakpoint_index = Index_vector(1, 1) ; // aux. for output time settings
+	double * y_dot = NULL ;	// used in f() as called by aux() which is called by odesolve() -- contains all derivatives of vector Y (whose starting values are Y0 below) below.
+	Fortran_vector Y0	; // (set in GUI) initial condition vector is made of Q_ST_0, Q_Mesophyll_0, Q_RespMaint_0, Q_Exudation_0 & Q_Growthtot_0, and homologous tracer init values, and vol_Sympl_0 :
+	Fortran_vector atol_, rtol ; // integration accuracy parameters (set in GUI)
+	double t0, tf, pas;		// solve for t = [t0, tf], save result at each time step (hours)
+	float t1 ; int nbv ; // pas = initial output step = between first 2 output steps t0 and t1
+	bool LogScale = false ; // set to 'true' if log scale wanted (in 'PiafMunch2.cpp')
+	Fortran_vector OutputTimes, SegmentTimes, truc ; // will be vector of, resp.: all output times including user-added extra- or breakpoint times ; output times for current integration time segment ; and an aux.
+	double x ; bool to_store = true ; FILE* file = NULL ;
+	int nl = 0 ; // # of current line in matrices currently under construction in aux() -- one for each element SegmentTimes[nl] of time vector SegmentTimes
+	// Selected nodes/connectors and variables for plotting or saving output :
+	int nsp, nvp, nss, nvs, fsp, fvp, fss, fvs, rsp = 0, lsp = 0, xsp ;
+	list<int> SelectedSaveNodesQList ; list<string> SelectedSaveNodeVariablesNamesQList ;
+	list<int> SelectedSaveConnsQList ; list<string> SelectedSaveConnVariablesNamesQList ;
+	list<int> SelectedPlotNodesQList ; list<string> SelectedPlotNodeVariablesNamesQList ;
+	list<int> SelectedPlotConnsQList ; list<string> SelectedPlotConnVariablesNamesQList ;
+	list<Fortran_vector*> SelectedPlotNodeVariablesRefsQList ; list<Fortran_vector*> SelectedPlotConnVariablesRefsQList ;
+	list<int> SelectedPlotNodeVariablesNamesIndicesInQList ; list<int> SelectedPlotConnVariablesNamesIndicesInQList ;
+	list<Fortran_vector*> SelectedSaveNodeVariablesRefsQList ; list<Fortran_vector*> SelectedSaveConnVariablesRefsQList ;
+	list<int> SelectedSaveNodeVariablesNamesIndicesInQList ; list<int> SelectedSaveConnVariablesNamesIndicesInQList ;
+	// following matrices will store dynamics of variables to plot   -- filled in aux() :
+	list<Fortran_matrix*> SelectedPlotNodeMatricesRefsQList, SelectedPlotConnMatricesRefsQList ;
+	list<int> SelectedPlotNetworkEnds_k, SelectedSaveNetworkEnds_k ;
+	list<int>::iterator it, itk ; list<Fortran_vector*>::iterator itv ; list<string>::iterator its ; list<Fortran_matrix*>::iterator itm ;
+	Fortran_vector* FV ; Fortran_matrix* FM ; string QS ;
+	bool AutoQuit = false; // will be TRUEd if launched with '-q' (which will also disable Plotting)
+
+	// hydric system (formerly in solve.cpp) :
+	Fortran_vector Q_ST_seg_init;
+	vector<int> Deg ;
+	int Nt, Nc ; // Nt = Total number of nodes, Nc = total number of connections in network.
+	int N1R ; // Number of  'root tip's, i.e. nodes of conn.order 1 that have imposed soil water potential as a limit condition.
+	vector<int> jf_RootEnds ; // indices to label end nodes = those of conn.order 1
+	SpUnit_matrix Delta2 ; // describe hydraulic architecture (topology)
+	SpUnit_matrix Delta2abs ; // describe hydraulic architecture (topology)
+	Sparse_matrix Deltaabs ; // describe hydraulic architecture (topology)
+	Sparse_matrix Delta2W;
+	Sparse_matrix X ;	// intermediaires de calcul ;
+	int** ipiv_ptr ; void**TM_ptr ; // id. -- initialise dans inialize_hydric()
+	Fortran_vector YY, SM ; // resp., inconnue et second membre de l'eq. matricielle
+	SpUnit_matrix Delta ; // =  - Transpose(Delta2) : describe hydraulic architecture (topology)
+	Sparse_matrix M1, Delta_rxyl, Delta_rphl ;	// intermediaires de calcul ;
+	Fortran_vector Km, rG, O ; //  intermediaires de calcul (Km : rien a voir avec Michaelis !)
+	Fortran_vector inv_Km, rs_rG, inv_rPhlM, inv_rG ; //  intermediaires de calcul, derives ou inverses des precedents
+	int is ; // is = # of current integration time segment (first = 1)
+	double TdC, dEauPure,  siPhi, newPhi ; // pour visc. calc. par  www.seas.upenn.edu et/ou NonLinPsi
+	double T_old = -9999. ; // memory of previous T in update_viscosity() (do not compute dEauPure, siPhi, etc. if T unchanged)
+	bool Adv_BioPhysics ; // true if  non-zero sugar specific volume, osmotic pot.=non-linear function of molality (Thompson and Holbrook), and viscosity changes with C_TC (Thompson and Holbrook ; Seas, Flanagan)  ; set in IntroDialogBox
+	// Hydro Resistance Parameters (set in GUI) :
+	Fortran_vector r_Xyl			; //(MPa h / ml) : xylem water resistance
+	Fortran_vector r_ST			; // (MPa h / ml) : axial phloem water resistance
+	Fortran_vector r_ST_ref 	; // r_ST_ ref. values for C_TC =  0.5 mmol / ml sap solution
+	Fortran_vector r_abs			; // soil - root  water resistances (may be changed by user)			(MPa h / ml)
+	Fortran_vector r_Trsv			; // Transverse xylem to phloem apoplasm water resistance										(MPa h / ml)
+	Fortran_vector r_PhlMb		; // Transmembrane Phloem (ST,CC) Apoplasm to Symplasm water resistance		(MPa h / ml)
+	Fortran_vector r_ParMb		; // Transmembrane Parenchyma Apoplasm to Symplasm water resistance		(MPa h / ml)
+	Fortran_vector r_Apo			;//  Lateral parenchyma to phloem Apoplastic (MPa h / ml)
+	Fortran_vector r_Sympl			; // Lateral parenchyma to phloem ST Symplasmic water resistance (MPa h / ml)
+	int resistance_changed = 0 ; // = NONE a priori
+	Fortran_vector i_amont					;
+	/*************************** VARIABLES INVOLVED IN HYDRIC SYSTEM (Water fluxes): ******************************* */
+	Fortran_vector P_Xyl		    	; // Xylem Pressure (= water potential since there is no solute in this version)					(MPa)
+	Fortran_vector Psi_Xyl		    	; // Xylem Pressure (= water potential since there is no solute in this version)					(MPa)
+	Fortran_vector Psi_ST	 		; // Phloem sieve-tube (+CC) water potential												(MPa)
+	Fortran_vector Psi_PhlApo		; // Phloem Apoplam water potential												(MPa)
+	Fortran_vector Psi_ParApo		; // Lateral parenchyma apoplasmic water potential												(MPa)
+	Fortran_vector P_PhlApo		; // Phloem Apoplam pressure												(MPa)
+	Fortran_vector P_ParApo		; // Lateral parenchyma apoplasmic pressure												(MPa)
+	Fortran_vector Psi_Sympl		; // Lateral parenchyma symplasmic water potential												(MPa)
+	Fortran_vector P_ST			; // Phloem sieve-tube (+CC) turgor pressure 								(MPa)
+	Fortran_vector P_Sympl		; // Lateral parenchyma symplasmic turgor pressure 								(MPa)
+	Fortran_vector Absorb			; // Root end water absorbtion flux										(ml / h)
+	Fortran_vector JW_Xyl			; // Axial xylem water flux
+	Fortran_vector JW_ST			; // Axial phloem sieve-tube liquid flux
+	Fortran_vector JW_Trsv			; // Transverse xylem to phloem apoplasm water flux									(ml / h)
+	Fortran_vector JW_PhlMb		; // Transmembrane Phloem (ST,CC) Apoplasm to Symplasm water flux
+	Fortran_vector JW_ParMb		; // Transmembrane Parenchyma Apoplasm to Symplasm water flux
+	Fortran_vector JW_Apo			; // Lateral parenchyma to phloem Apoplastic water flux									(ml / h)
+	Fortran_vector JW_Sympl		; // Lateral parenchyma to phloem ST Symplasmic liquid flux									(ml / h)
+	double  PartMolalVol =0;
+
+	// intermediary matrices and buffers (formerly in initialize.cpp) :
+	Sparse_matrix A22, A22_I, Delta2rpDelta, Delta2rxDelta, D6, I, X1 ; // intermediary complex matrices to speed up calculations
+	Fortran_vector dummy, dummy_ ; // temporary buffers to speed up calculations(not have to create new objects at each call)
+	Fortran_vector dummy_f ; // temporary buffer of f() (molarity, if Adv_BioPhysics)
+};
+
+extern thread_local PiafMunchContext* PM_context ; // state of the PhloemFlux::startPM running in this thread, NULL outside of it
+
+#endif
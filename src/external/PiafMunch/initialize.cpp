@@ -27,111 +27,11 @@
 #include <vector>
 #include "PM_arrays.h"
 #include "runPM.h"																   
-extern Fortran_vector vol_ST_seg;//, Length;
-extern Fortran_vector vol_ST, vol_ParApo;
-extern vector<int> Deg ;
-extern Sparse_matrix Delta2W;
-extern SpUnit_matrix Delta2		; // describe hydraulic architecture (topology)
-extern Sparse_matrix Deltaabs		; // describe hydraulic architecture (topology)
-#ifdef Full_Matrix // solve full linear system for all hydraulic variables, chained as YY below :
-extern Fortran_vector YY, SM ; // resp., inconnu et second membre de l'eq. matricielle
-#else // reduce linear system to only one unknown hydraulic variable (P_ST) => significant speed up and reduce required memory -- needs pre-solving recalculation if local model is changed
-extern SpUnit_matrix Delta		; // describe hydraulic architecture (topology)
-extern Sparse_matrix M1, Delta_rxyl, Delta_rphl ; // intermediary complex matrices to speed up calculations
-Sparse_matrix A22, A22_I, Delta2rpDelta, Delta2rxDelta, D6, I, X1 ; // intermediary complex matrices to speed up calculations
-Fortran_vector dummy, dummy_ ; // temporary buffers to speed up calculations(not have to create new objects at each call)
-extern Fortran_vector Km, rG, O ; // (def. in hydric_solve.cpp) intermediaires de calcul des matrices, cf. fichier Excel (Km : rien a voir avec Michaelis !)
-extern Fortran_vector inv_Km, rs_rG, inv_rPhlM, inv_rG ; //  intermediaires de calcul, derives ou inverses des precedents
-#endif
-extern Sparse_matrix X ;
-extern int** ipiv_ptr; extern void**TM_ptr; // buffers to speed up linear solving
-extern int jf, i, j ;
 
-/**********************************************  Network Architecture: *********************************************/
-extern int Nt, Nc ; // Nt = Total number of nodes, Nc = total number of de connections in network.
-extern int N1L ; // Number of 'leaf end's, i.e. nodes of conn.order 1 that have imposed transpiration stream as a limit condition.
-extern int N1R ; // Number of  'root tip's, i.e. nodes of conn.order 1 that have imposed soil water potential as a limit condition (N[1] = N1L + N1R).
-extern Index_vector i_[] ; // i_[o = 0..8][k = 1..No] = id# of kth node in (1-based list)  list of all nodes of conn.ord. co(o). For o=0: No=N1L ; o=1: No=N1R ; o=2..8: No=N[o] :
-extern Index_vector &RootEnds, &LeafEnds ; // (= i_[1] and i_[0], resp.) : label which nodes are network ends = nodes of co=1 , which are either 'leaf' or 'root' ends :
-extern vector<int> jf_RootEnds ; // to index those nodes that are root- or leaf-ends, resp.
-extern vector<vector<int> > JF_ ; // JF_[i][j] = Id# du (j)eme flux (dans l'ordre declare dans le fichier) issu du noeud #i :> 0 ou < 0 par convention dans le sens (I_Upflow[ ] --> I_Downflow[ ]) :
-extern vector<int> I_Upflow, I_Downflow ; // I_Upflow(resp.I_Downflow)[jf=1..Nc] = id# du noeud amont (resp. aval) par convention : jf > 0 dans le sens (I_Upflow[(abs(jf)] --> I_Downflow[(abs(jf)], < 0 dans l'autre sens
 
-/******************* VARIABLES INVOLVED in CARBON METABOLISM AND FLUXES *******************************  */
-extern Fortran_vector JS_ST						; // (mmol / h)  : Axial phloem sugar flux
-extern Fortran_vector JS_PhlMb				; // Phloem cross-membrane sugar fluxes into sieve tubes from apoplasm				(mmol / h)
-extern Fortran_vector RespMaint					; // Maintenance respiration rate										(mmol / h)
-extern Fortran_vector Q_RespMaintSyn						; // Michaelis-Menten rate of starch synthesis from sugar substrate						(mmol sug.eq./ h)
-extern Fortran_vector C_amont					; //  (mmol / ml) : ST Sugar concentration at upflow node
-extern Fortran_vector Input					; // Local C input (photosynthetic assimilation rate in leaves, but may be defined anywhere) (boundary condition)			(mmol / h)
-extern Fortran_vector C_Sympl						; // Concentration of sugar in parenchyma = Q_Par / vol_Sympl			(mmol / ml)
-extern Fortran_vector C_ST							; // Concentration of sugar in sieve tubes								(mmol / ml solution))
-//extern Index_vector i_amont					; // i_amont[i] = Id# of upflow node  ; def. ONLY FOR i > 1  (i_amont[1] = NA)
-extern Fortran_vector i_amont					;
-extern Fortran_vector JS_Sympl						; // Symplasmic flux of sugar from Lateral parenchyma to phloem ST (mmol / h)
-extern Fortran_vector JS_ParMb				; // Lateral parenchyma cross-membrane sugar flux into symplasm from apoplasm				(mmol / h)
-extern Fortran_vector JS_Apo						; // apoplasmic sugar flux from phloem to Lateral parenchyma  (mmol / h)
-extern Fortran_vector JW_ParMb, JW_Apo, JW_Sympl ; // water fluxes corresponding to above 3 sugar fluxes   (ml / h)
-extern Fortran_vector C_SymplUpflow					; // upflow concentration (mmol / ml) for JS_Sympl
-extern Fortran_vector C_PhlApo, C_ParApo, C_ApoUpflow ; // (mmol / ml) apoplasmic sugar conc., resp. in phloem and lat.parenchyma, and upflow conc. for JS_Apo
-extern Fortran_vector Delta_JS_ST ; // sera la composante purement phloemienne de Q_TC_dot[ ]							(mmol / h)
-
-/******** TRACER-RELATED VARIABLES ***********************************************************/
-extern double TracerDecay_k, TracerHalfLife ;
-extern Fortran_vector TracerJS_ST						; // TracerJS_ST[i] (MBq / h)  = TracerJS_ST_[i-1], i = 2..N  : Axial phloem soluble tracer flux ; TracerJS_ST[1]= NA, whereas TracerJS_ST_[1] = TracerJS_ST[2]
-extern Fortran_vector TracerJS_PhlMb						; // Lateral (Apoplasmic) soluble tracer fluxes into sieve tubes from parenchyma				(MBq / h)
-extern Fortran_vector TracerRespMaint					; // Tracer Maintenance respiration rate										(MBq / h)
-extern Fortran_vector TracerQ_RespMaintSyn						; // Michaelis-Menten rate of tracer starch synthesis from tracer sugar substrate						(MBq / h)
-extern Fortran_vector TracerInput					; // Tracer input (photosynthetic Tracer Assimilation rate in leaves, but more general) (boundary condition)			(MBq / h)
-extern Fortran_vector TracerC_Sympl						; // Concentration of soluble tracer in parenchyma symplasm= TracerQ_Mesophyll / vol_Sympl			(MBq / ml)
-extern Fortran_vector TracerC_ST							; // Concentration of soluble tracer in sieve tubes								(MBq / ml solution))
-extern Fortran_vector TracerC_PhlApo, TracerC_ParApo ; // Concentration of soluble tracer in apoplasms					(MBq / ml solution))
-extern Fortran_vector TracerRatioSympl ; //   TracerQ_Mesophyll / Q_Mesophyll = TracerC_Sympl / C_Sympl  (MBq / mmol)
-extern Fortran_vector TracerRatioQ_RespMaint ; //   = TracerQ_RespMaint / Q_RespMaint (MBq / mmol)
-extern Fortran_vector Delta_TracerJS_ST ; // sera la composante purement phloemienne de Q_Rmmax_dot[ ]
-extern Fortran_vector TracerJS_Sympl, TracerJS_Apo, TracerJS_ParMb ; // Lateral (Sympl., Apopl.; cross-membr...) soluble tracer fluxes FROM sieve tubes INTO parenchyma							(MBq / h)     !!! ATTENTION : sens positif oppose a JS_Trsv !!!
-extern Fortran_vector TracerC_SymplUpflow					;  // upflow tracer concentration (mmol / ml) for TracerJS_Sympl
-extern Fortran_vector TracerC_ApoUpflow ;				; // upflow tracer concentration (mmol / ml) for TracerJS_Apo
-extern Fortran_vector Delta_TracerJS_ST ; // sera la composante purement phloemienne de Q_Rmmax_dot[ ]
-
-extern Fortran_vector P_Xyl			; // Xylem water potential = pressure (no solute)												(MPa)
-extern Fortran_vector Psi_Xyl			; // Xylem water potential = pressure (no solute)												(MPa)
-extern Fortran_vector Psi_ST			; // Phloem sieve-tube (+CC) water potential												(MPa)
-extern Fortran_vector Psi_PhlApo		; // Phloem Apoplam water potential												(MPa)
-extern Fortran_vector Psi_ParApo		; // Lateral parenchyma apoplasmic water potential												(MPa)
-extern Fortran_vector P_PhlApo		; // Phloem Apoplam pressure												(MPa)
-extern Fortran_vector P_ParApo		; // Lateral parenchyma apoplasmic pressure												(MPa)
-extern Fortran_vector Psi_Sympl		; // Lateral parenchyma symplasmic water potential												(MPa)
-extern Fortran_vector P_ST			; // Phloem sieve-tube (+CC) turgor pressure 								(MPa)
-extern Fortran_vector P_Sympl		; // Lateral parenchyma symplasmic turgor pressure 								(MPa)
-extern Fortran_vector Absorb			; // Root end water absorbtion flux										(ml / h)
-extern Fortran_vector JW_Xyl			; // Axial xylem water flux
-extern Fortran_vector JW_ST			; // Axial phloem sieve-tube liquid flux
-extern Fortran_vector JW_Trsv			; // Transverse xylem to phloem apoplasm water flux									(ml / h)
-extern Fortran_vector JW_PhlMb		; // Transmembrane Phloem (ST,CC) Apoplasm to Symplasm water flux
-extern Fortran_vector JW_ParMb		; // Transmembrane Parenchyma Apoplasm to Symplasm water flux
-extern Fortran_vector JW_Apo			; // Phloem to Lateral parenchyma Apoplastic water flux									(ml / h)
-extern Fortran_vector JW_Sympl		; // Lateral parenchyma to phloem ST Symplasmic liquid flux									(ml / h)
-// Next 2 variables are not considered as such, but as possible inputs to compute vol_Sympl_dot :
-extern Fortran_vector P_ST_dot, P_Sympl_dot			; //  dP_ST/dt , dP_Sympl/dt					(MPa h / h)    -- for elasticity...
 // NZS : optional non-zero volume sugar flow (not a distinct variable)   (ml / h) : NZS = JS_Trsv * PartMolalVol (=0.2155 in Thompson and Holbrook -- 0.214 might be more accurate)
 
-/******************************************  Constants and Parameters: *********************************************/
-extern double TdC, dEauPure, PartMolalVol, siPhi, newPhi ; // pour visc. calc. par  www.seas.upenn.edu
-extern bool Adv_BioPhysics ; // true if  non-zero sugar specific volume, osmotic pot.=non-linear function of molality (Thompson and Holbrook), and viscosity changes with C_TC (Thompson and Holbrook ; Seas, Flanagan)  ; set in IntroDialogBox
-extern Fortran_vector Q_ST_seg_init;
-// Hydro Resistance Parameters (set in GUI) :
-extern Fortran_vector r_Xyl		; // (MPa h / ml)  : axial xylem water resistance
-extern Fortran_vector r_ST			; // (MPa h / ml) : axial phloem water resistance
-extern Fortran_vector r_ST_ref 	; // r_ST_ ref. values for C_TC =  0.5 mmol / ml sap solution
-extern Fortran_vector r_abs			; // soil - root  water resistances (may be changed by user)			(MPa h / ml)
-extern Fortran_vector r_Trsv			; // Transverse xylem to phloem apoplasm water resistance										(MPa h / ml)
-extern Fortran_vector r_PhlMb		; // Transmembrane Phloem (ST,CC) Apoplasm to Symplasm water resistance		(MPa h / ml)
-extern Fortran_vector r_ParMb		; // Transmembrane Parenchyma Apoplasm to Symplasm water resistance		(MPa h / ml)
-extern Fortran_vector r_Apo			;// Phloem to Lateral parenchyma Apoplastic water resistence (MPa h / ml)
-extern Fortran_vector r_Sympl			; // Lateral parenchyma to phloem ST Symplasmic water resistance (MPa h / ml)
 
-extern int resistance_changed ;
 // constants to express hydro resistance changes :
 #define NONE 0
 #define XYL 1
@@ -144,20 +44,8 @@ extern int resistance_changed ;
 #define RABS 128
 
 
-extern Fortran_vector  Q_Exud, Q_Gr, Q_Rm, Q_Fl; 
-extern Fortran_vector  Q_Exudmax, Q_Grmax, Q_Rmmax;//, Q_Fl_seg;
 //extern Fortran_vector C_ST_seg, Q_ST_seg, Q_ST_seg_new,Q_ST_newFuFl, grad_Q_ST_seg;
 
-/******************************************  Environmental Variables: *********************************************/
-extern double T ;	// absolute temperature													(K)
-// The following 2 environment data are set by the user in function  'hydric_boundary_conditions()'  at the end of file 'water-fluxes.cpp' :
-extern Fortran_vector Transpirat		; // Leaf transpiration rate (used in water-fluxes calc.)				(mmol / h)
-extern Fortran_vector PsiSoil			; // Soil water potential at root end (used in water-fluxes calc.)		(MPa)
-void UpdateResistances(double t) ;
-extern Fortran_vector Y0	; // (set in GUI) initial condition vector is made of Q_ST_0, Q_Mesophyll_0, Q_RespMaint_0, Q_Exudation_0, Q_Growthtot_0, and homologous tracer init values, and vol_Sympl_0 :
-
-
-
 
 void PhloemFlux::initialize_carbon(vector<double> vecIn) {
 	
@@ -170,10 +58,10 @@ void PhloemFlux::initialize_carbon(vector<double> vecIn) {
     C_amont = Fortran_vector(Nc, 0.)	; //  (mmol / ml) : ST Sugar concentration at true upflow node
 	C_ST = Fortran_vector(Nt, 0.);
 	if(doTroubleshooting){
-		std::cout<<"initial size of vector: "<<vecIn.size()<<" nodes: "<<Nt<<" connections "<<Nc<<" "<<std::endl;
+		PM_cout<<"initial size of vector: "<<vecIn.size()<<" nodes: "<<Nt<<" connections "<<Nc<<" "<<std::endl;
 	}
     if(vecIn.size() == (Nt*neq_coef)){ //gave input vector with starting values 
-		if(doTroubleshooting){std::cout<<"setup full y0 "<<std::endl;}
+		if(doTroubleshooting){PM_cout<<"setup full y0 "<<std::endl;}
 		Y0= Fortran_vector(vecIn); 
 		
 		//Y0.display();
@@ -183,7 +71,7 @@ void PhloemFlux::initialize_carbon(vector<double> vecIn) {
 		Q_GrmaxBU.append(Q_GrmaxBU_temp);
 	}else{
 		if(vecIn.size() > 0){// plant grew since last phloem flow computatoin
-			if(doTroubleshooting){std::cout<<"complete y0 "<<std::endl;}
+			if(doTroubleshooting){PM_cout<<"complete y0 "<<std::endl;}
 			Y0 =  Fortran_vector(Nt*neq_coef, 0.) ;
 			Y0.sequentialFill(vecIn, Nt_old, Nt);
 			
@@ -192,7 +80,7 @@ void PhloemFlux::initialize_carbon(vector<double> vecIn) {
 			Fortran_vector Q_GrmaxBU_temp = Fortran_vector(Nt - Nt_old, 0.) ;
 			Q_GrmaxBU.append(Q_GrmaxBU_temp);
 		}else{//first phloem flow computation ==> vecIn is empty
-			if(doTroubleshooting){std::cout<<"setup empty y0 "<<std::endl;}
+			if(doTroubleshooting){PM_cout<<"setup empty y0 "<<std::endl;}
 			Y0 =  Fortran_vector(Nt*neq_coef, 0.) ;
 			Q_GrowthtotBU = Fortran_vector(Nt, 0.) ;
 			Q_GrmaxBU = Fortran_vector(Nt, 0.) ;
@@ -210,7 +98,7 @@ void PhloemFlux::initialize_carbon(vector<double> vecIn) {
 		}
 	}
 	
-	if(doTroubleshooting){cout<<"Y0_STinit "<<Y0[1]<<" "<<Nc<<" "<<Nt<<" "<<Nt_old<<endl;}
+	if(doTroubleshooting){PM_cout<<"Y0_STinit "<<Y0[1]<<" "<<Nc<<" "<<Nt<<" "<<Nt_old<<endl;}
 	Nt_old = Nt; //BU Nt
 	
 	Q_Exud = Fortran_vector(Nt, 0.)			; 
@@ -289,7 +177,7 @@ void PhloemFlux::initialize_hydric() {
 	
 }
 
-void UpdateResistances(double t) { // called if (resistance_changed)
+void PiafMunchContext::UpdateResistances(double t) { // called if (resistance_changed)
 	//eventually fill it to represent changes of resistances when adding compartment
 	resistance_changed = NONE ;
 }
@@ -37,15 +37,13 @@ N_Vector InPlace_NVector(Fortran_vector &v) {
 
 int check_flag(void *flagvalue, string funcname_, int opt);   // utilise en 'verbose' dans cvode
 const time_t current = time(NULL) ;
-Fortran_vector y ;
-void* cvode_mem ;        // espace de travail du solveur; eventuellement utilise par la fonction aux()
-void* arkode_mem;        // espace de travail du solveur; eventuellement utilise par la fonction aux()
-
-void (*ff)(double t ,double* y, double* ydot) ;
+thread_local Fortran_vector y ;
+thread_local void* cvode_mem ;        // espace de travail du solveur; eventuellement utilise par la fonction aux()
+thread_local void* arkode_mem;        // espace de travail du solveur; eventuellement utilise par la fonction aux()
 
 inline int ffff(realtype t, N_Vector yy, N_Vector yydot, void *f_data) {
-// Forme de f compatible avec cvode: noter decalage des indices entre double* y et NV_DATA_S(N_Vector y)
-    ff(t, NV_DATA_S(yy) - 1, NV_DATA_S(yydot) - 1) ;
+// Forme de f compatible avec cvode: noter decalage des indices entre double* y et NV_DATA_S(N_Vector y) ; f_data = &f (cf. CVodeSetUserData)
+    (*(void(**)(double, double*, double*))f_data)(t, NV_DATA_S(yy) - 1, NV_DATA_S(yydot) - 1) ;
 	return 0;
 }
 
@@ -58,7 +56,7 @@ inline int gg(realtype t, N_Vector yy, realtype *g, void *g_data) {  // Idem pou
     return 0;
 }
 
-SUNLinearSolver LS(NULL);
+thread_local SUNLinearSolver LS(NULL);
 /* Other Constants pour calcul KLU_DQ_Jac : */
 #define MIN_INC_MULT RCONST(1000.0)
 #define ZERO         RCONST(0.0)
@@ -122,18 +120,18 @@ static int Jac_(realtype t, N_Vector y, N_Vector fy, SUNMatrix J, void *user_dat
 			if ((ftemp_data[i] != fy_data[i]) || (i == j)) {
 				if (ftemp_data[i] != fy_data[i])   J_ij = (ftemp_data[i] - fy_data[i]) / inc;   else  J_ij = ZERO;
 				if (ntnz >= NNZ0) { // avec celui-ci en plus, on va depasser l'espace reserve pour J
-					if (ntnz == NNZ0) cout << "ntnz = "  << ntnz << " va depasser NNZ = " << NNZ0 << " => creation des tampons :" << endl;
+					if (ntnz == NNZ0) PM_cout << "ntnz = "  << ntnz << " va depasser NNZ = " << NNZ0 << " => creation des tampons :" << endl;
 					if (!KLU_Ai) {
 						assert(!KLU_Ax);
 						KLU_Ai = new sunindextype*[N]; KLU_Ax = new realtype*[N];
-//						cout << "KLU_Ai , _Ax = new ...type*[N]" << endl ;
+//						PM_cout << "KLU_Ai , _Ax = new ...type*[N]" << endl ;
 					}
 					n_KLU_ptrs_2++;
 					if (n_KLU_ptrs_2 == N) {
 						n_KLU_ptrs_2 = 0; // de la ligne KLU_Ai[1 + n_KLU_ptrs_1], qui n'est pas encore utilisee, et donc n'a pas encore ete initialisee :
 						n_KLU_ptrs_1++; assert(n_KLU_ptrs_1 < N);
 						KLU_Ai[n_KLU_ptrs_1] = new sunindextype[N]; KLU_Ax[n_KLU_ptrs_1] = new realtype[N];
-	//					cout << "KLU_Ai[...ptrs1] , _Ax[...ptrs1] = new ...type[N]" << endl;
+	//					PM_cout << "KLU_Ai[...ptrs1] , _Ax[...ptrs1] = new ...type[N]" << endl;
 					}
 					KLU_Ai[n_KLU_ptrs_1][n_KLU_ptrs_2] = i; KLU_Ax[n_KLU_ptrs_1][n_KLU_ptrs_2] = J_ij;
 				}
@@ -149,7 +147,7 @@ static int Jac_(realtype t, N_Vector y, N_Vector fy, SUNMatrix J, void *user_dat
 		}
 	}
 	if (ntnz > NNZ0) { // on a du stocker des valeurs dans les tampons KLU_A.[0 .. n_KLU_ptrs_1 ][ ]
-//		cout << "ntnz > NNZ : reallocation matrice J ; utilisation et destruction des tampons :" << endl;
+//		PM_cout << "ntnz > NNZ : reallocation matrice J ; utilisation et destruction des tampons :" << endl;
 		npnz = ntnz / N ; // (provisoirement) nombre de lignes  pleines de longueur N, pouvant contenir tous les ntnz 'zeros'
 		assert(npnz * N <= ntnz) ;
 		if (npnz * N < ntnz) npnz ++ ; // on dimensionne le nouveau 'NNZ' = npnz  en multiples entiers de N :
@@ -164,16 +162,16 @@ static int Jac_(realtype t, N_Vector y, N_Vector fy, SUNMatrix J, void *user_dat
 				NNZ++;
 			}
 			delete[] KLU_Ai[i]; delete[] KLU_Ax[i];
-//			cout << "delete[] KLU_Ai[i] , _Ax[i] ; " ;
+//			PM_cout << "delete[] KLU_Ai[i] , _Ax[i] ; " ;
 		}
 		for (j = 0; j <= n_KLU_ptrs_2; j++) { // la derniere ligne, eventuellement incomplete
 			rowvals[NNZ] = KLU_Ai[n_KLU_ptrs_1][j]; data[NNZ] = KLU_Ax[n_KLU_ptrs_1][j];
 			NNZ++;
 		}
 		delete[] KLU_Ai[n_KLU_ptrs_1]; delete[] KLU_Ax[n_KLU_ptrs_1];
-//		cout << "delete[] KLU_Ai[...ptrs1] , _Ax[...ptrs1] ; " ;
+//		PM_cout << "delete[] KLU_Ai[...ptrs1] , _Ax[...ptrs1] ; " ;
 		delete[] KLU_Ai; delete[] KLU_Ax;
-//		cout << "delete[] KLU_Ai , _Ax" << endl;
+//		PM_cout << "delete[] KLU_Ai , _Ax" << endl;
 		assert(NNZ == ntnz); // attention, ce n'est plus le NNZ officiel ! -- qui reste stocke en NNZ0
 	}
 	if (colptrs[N] != ntnz) {
@@ -191,7 +189,6 @@ static int Jac_(realtype t, N_Vector y, N_Vector fy, SUNMatrix J, void *user_dat
 
 int cvode_direct(void(*f)(double,double*,double*), Fortran_vector& y, Fortran_vector &T, void(*aux)(double,double*), Fortran_vector& atol, Fortran_vector& rtol, int solver,
 	     int nbVar_dot, Fortran_vector** Var_primitive, Fortran_vector** Var_dot, bool verbose, bool STALD, void(*rootfind)(double, double*, double*), int nrootfns, int mu, int ml) {
-	ff = f ;
   int itol = 1 ;
 /* 	itol = 1 (= CV_SS) : atol and rtol tous 2 scalaires ;
 		itol = 2 (= CV_SV) : atol vecteur, rtol scalaire ;
@@ -227,6 +224,8 @@ int cvode_direct(void(*f)(double,double*,double*), Fortran_vector& y, Fortran_ve
     if (check_flag(cvode_mem, "CVodeCreate", 0)) {_LogMessage("erreur CVodeCreate") ; return -1 ; }
   flag = CVodeInit(cvode_mem, ffff, T[1], yy); // alloue l'espace de travail du solveur
     if (check_flag(&flag, "CVodeInit", 1)) {_LogMessage("erreur CVodeInit") ; return -1 ; }
+  flag = CVodeSetUserData(cvode_mem, &f); // f est transmise a ffff via f_data
+    if (check_flag(&flag, "CVodeSetUserData", 1)) {_LogMessage("erreur CVodeSetUserData") ; return -1 ; }
 
 /* Call CVodeSVtolerances to specify the scalar relative tolerance
 * and vector absolute tolerances */
@@ -285,7 +284,7 @@ int cvode_direct(void(*f)(double,double*,double*), Fortran_vector& y, Fortran_ve
   for (i = 2 ; i <= nbt ; i++) {						// pour chaque instant ou l'on souhaite la solution
 	tout=T[i];
 	if (verbose) {
-			strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  starting step n#" << i-1 << " (tf = " << tout << ")" << endl ;
+			strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  starting step n#" << i-1 << " (tf = " << tout << ")" << endl ;
 			Update_Output(i == 2) ;
 	}
 	while (t < tout) {
@@ -295,7 +294,7 @@ int cvode_direct(void(*f)(double,double*,double*), Fortran_vector& y, Fortran_ve
 			  if (flag == CV_ROOT_RETURN) {
 				 flagr = CVodeGetRootInfo(cvode_mem, rootsfound);
 				   if (check_flag(&flagr, "CVodeGetRootInfo", 1)) { _LogMessage(" Erreur CVodeGetRootInfo") ;
-						strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output() ; return i ;
+						strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output() ; return i ;
 				   }
 				 for (j = 0 ; j < nrootfns ; j++) {
 					 if (rootsfound[j] == 1) {
@@ -309,7 +308,7 @@ int cvode_direct(void(*f)(double,double*,double*), Fortran_vector& y, Fortran_ve
 				   if (flag != CV_SUCCESS) {
 				  //    if (check_flag(&flag, "CVode", 1)) break ; // routine a  reprendre...
 					   (void)sprintf(message, "error-flag CVode = %d", flag) ; _LogMessage(message) ;
-						strftime(message, 50, "%H:-%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output(true) ;
+						strftime(message, 50, "%H:-%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output(true) ;
 					   return i ;
 				  }
 			  }
@@ -362,8 +361,8 @@ int cvode_direct(void(*f)(double,double*,double*), Fortran_vector& y, Fortran_ve
 	  for (j = 0 ; j < nbVar_dot ; j ++) 	 delete Var_primitive_sav[j] ;
 	delete[] Var_primitive_sav ;
   }
-//  _strtime_s(message, 100); cout << "at " << message << " :  exiting solver" << endl ; Update_Output() ;
-   strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output() ;
+//  _strtime_s(message, 100); PM_cout << "at " << message << " :  exiting solver" << endl ; Update_Output() ;
+   strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output() ;
 	return 0 ;
 }
 
@@ -371,7 +370,6 @@ int cvode_direct(void(*f)(double,double*,double*), Fortran_vector& y, Fortran_ve
 int cvode_spils(void(*f)(double, double*, double*), Fortran_vector &y, Fortran_vector &T, void(*aux)(double, double*), Fortran_vector& atol, Fortran_vector& rtol,
 	int solver, int GSType, int prectype, int nbVar_dot, Fortran_vector** Var_primitive, Fortran_vector** Var_dot,
 	bool verbose, bool STALD, void(*rootfind)(double, double*, double*), int nrootfns, int mu, int ml, int maxl) {
-	ff = f;
 	int itol = 1;
 	// 		itol = 1 (= CV_SS) : atol and rtol tous 2 scalaires ;
 	//		itol = 2 (= CV_SV) : atol vecteur, rtol scalaire ;
@@ -407,6 +405,8 @@ int cvode_spils(void(*f)(double, double*, double*), Fortran_vector &y, Fortran_v
 
 	flag = CVodeInit(cvode_mem, ffff, T[1], yy); // alloue l'espace de travail du solveur
 	if (check_flag(&flag, "CVodeInit", 1)) { _LogMessage("erreur CVodeInit"); return -1; }
+	flag = CVodeSetUserData(cvode_mem, &f); // f est transmise a ffff via f_data
+	if (check_flag(&flag, "CVodeSetUserData", 1)) { _LogMessage("erreur CVodeSetUserData"); return -1; }
 
 	/* Call CVodeSVtolerances to specify the scalar relative tolerance
 	* and vector absolute tolerances */
@@ -461,14 +461,14 @@ int cvode_spils(void(*f)(double, double*, double*), Fortran_vector &y, Fortran_v
 	if (check_flag(&flag, "CVodeSetLinearSolver", 1)) return -1;
 	if (prectype != PREC_NONE) {
 		flag = CVBandPrecInit(cvode_mem, neq, mu, ml);
-		cout << "CVBandPrecInit flag = " << flag << endl;
+		PM_cout << "CVBandPrecInit flag = " << flag << endl;
 		if (check_flag(&flag, "CVBandPrecInit", 1)) { _LogMessage("erreur CVBandPrecInit"); return -1; }
 	}
   flag = CVodeSetMaxConvFails(cvode_mem, 100) ; // pour prevenir l'erreur de non-convergence (error code = -4), sauf si la convergence n'est effectivement jamais atteinte !
   for (i = 2 ; i <= nbt ; i++) {						// pour chaque instant ou l'on souhaite la solution
 	tout=T[i];
 	if (verbose) {
-			strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  starting step n#" << i-1 << " (tf = " << tout << ")" << endl ;
+			strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  starting step n#" << i-1 << " (tf = " << tout << ")" << endl ;
 			Update_Output(i == 2) ;
 	}
 	while (t < tout) {
@@ -478,7 +478,7 @@ int cvode_spils(void(*f)(double, double*, double*), Fortran_vector &y, Fortran_v
 			  if (flag == CV_ROOT_RETURN) {
 				 flagr = CVodeGetRootInfo(cvode_mem, rootsfound);
 				   if (check_flag(&flagr, "CVodeGetRootInfo", 1)) { _LogMessage(" Erreur CVodeGetRootInfo") ;
-		       			strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output() ; return i ;
+		       			strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output() ; return i ;
 				   }
 				 for (j = 0 ; j < nrootfns ; j++) {
 					 if (rootsfound[j] == 1) {
@@ -487,14 +487,14 @@ int cvode_spils(void(*f)(double, double*, double*), Fortran_vector &y, Fortran_v
 					 }
 				 }
 				 
-				std::cout<<"aux for t < tout"<<std::endl;
+				PM_cout<<"aux for t < tout"<<std::endl;
 				aux(t, y_) ;
 			  }
 			  else {
 				  if (flag != CV_SUCCESS) {
 				  //    if (check_flag(&flag, "CVode", 1)) break ; // routine a  reprendre...
 					   (void)sprintf(message, "error-flag CVode = %d", flag) ; _LogMessage(message) ;
-					   	strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output() ;
+					   	strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output() ;
 					   return i ;
 				  }
 			  }
@@ -546,8 +546,8 @@ int cvode_spils(void(*f)(double, double*, double*), Fortran_vector &y, Fortran_v
 	  for (j = 0 ; j < nbVar_dot ; j ++) 	 delete Var_primitive_sav[j] ;
 	delete[] Var_primitive_sav ;
   }
-//  _strtime_s(message, 100); cout << "at " << message << " :  exiting solver" << endl ; Update_Output();
-	strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output();
+//  _strtime_s(message, 100); PM_cout << "at " << message << " :  exiting solver" << endl ; Update_Output();
+	strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl ; Update_Output();
 
 	return 0 ;
 }
@@ -590,7 +590,6 @@ int cvode_spils(void(*f)(double, double*, double*), Fortran_vector &y, Fortran_v
 
 int arkode(void(*f)(double, double*, double*), Fortran_vector& y, Fortran_vector &T, void(*aux)(double, double*), Fortran_vector& atol, Fortran_vector& rtol,
 	int nbVar_dot, Fortran_vector** Var_primitive, Fortran_vector** Var_dot, bool verbose,	void(*rootfind)(double, double*, double*), int nrootfns) {
-	ff = f;
 	int itol = 1;
 	/* 	itol = 1 (= CV_SS) : atol and rtol tous 2 scalaires ;
 	itol = 2 (= CV_SV) : atol vecteur, rtol scalaire ;
@@ -623,6 +622,8 @@ int arkode(void(*f)(double, double*, double*), Fortran_vector& y, Fortran_vector
 	}
 	arkode_mem = ERKStepCreate(ffff, T[1], yy);    // init. le solveur
 	if (check_flag(arkode_mem, "ERKStepCreate", 0)) { _LogMessage("erreur ERKStepCreate"); return -1; }
+	flag = ERKStepSetUserData(arkode_mem, &f); // f est transmise a ffff via f_data
+	if (check_flag(&flag, "ERKStepSetUserData", 1)) { _LogMessage("erreur ERKStepSetUserData"); return -1; }
 
 	/* Call CVodeSVtolerances to specify the scalar relative tolerance
 	* and vector absolute tolerances */
@@ -638,7 +639,7 @@ int arkode(void(*f)(double, double*, double*), Fortran_vector& y, Fortran_vector
 	for (i = 2; i <= nbt; i++) {						// pour chaque instant ou l'on souhaite la solution
 		tout = T[i];
 		if (verbose) {
-			strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  starting step n#" << i - 1 << " (tf = " << tout << ")" << endl;
+			strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  starting step n#" << i - 1 << " (tf = " << tout << ")" << endl;
 			Update_Output(i == 2);
 		}
 		while (t < tout) {
@@ -649,7 +650,7 @@ int arkode(void(*f)(double, double*, double*), Fortran_vector& y, Fortran_vector
 					flagr = ERKStepGetRootInfo(arkode_mem, rootsfound);
 					if (check_flag(&flagr, "ERKStepGetRootInfo", 1)) {
 						_LogMessage(" Erreur ERKStepGetRootInfo");
-				        strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl; Update_Output(); return i;
+				        strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl; Update_Output(); return i;
 					}
 					for (j = 0; j < nrootfns; j++) {
 						if (rootsfound[j] == 1) {
@@ -663,7 +664,7 @@ int arkode(void(*f)(double, double*, double*), Fortran_vector& y, Fortran_vector
 					if (flag != ARK_SUCCESS) {
 						//    if (check_flag(&flag, "CVode", 1)) break ; // routine a  reprendre...
 						(void)sprintf(message, "error-flag Arkode = %d", flag); _LogMessage(message);
-						strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl; Update_Output(true);
+						strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl; Update_Output(true);
 						return i;
 					}
 				}
@@ -705,8 +706,8 @@ int arkode(void(*f)(double, double*, double*), Fortran_vector& y, Fortran_vector
 		for (j = 0; j < nbVar_dot; j++) 	 delete Var_primitive_sav[j];
 		delete[] Var_primitive_sav;
 	}
-//	_strtime_s(message, 100); cout << "at " << message << " :  exiting solver" << endl; Update_Output();
-	strftime(message, 50, "%H:%M:%S", localtime(&current)) ; cout <<  "at " << message << " :  exiting solver" << endl; Update_Output();
+//	_strtime_s(message, 100); PM_cout << "at " << message << " :  exiting solver" << endl; Update_Output();
+	strftime(message, 50, "%H:%M:%S", localtime(&current)) ; PM_cout <<  "at " << message << " :  exiting solver" << endl; Update_Output();
 	return 0;
 }
 
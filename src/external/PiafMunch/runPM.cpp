@@ -25,29 +25,7 @@
 
 #include <PiafMunch/runPM.h>
 
-vector<int> I_Upflow, I_Downflow ; //  I_Upflow(resp.I_Downflow)[jf=1..Nc] = id# of conv. upflow (resp. conv. downflow) node of internode flux #jf
-int i,j;
-float rs = 1.1f ; // (if relevant) rate of geometric increment of output step -- to be adjusted to yield 100 steps between t0 and tf
-extern bool Adv_BioPhysics ; 
-extern double dEauPure;
-string term = "qt" ; // name of terminal for gnuplot (default "wxt" bugs with Windows)
-extern string GnuplotPath ; // (defined in PiafMunch2.cpp) Path to GnuPlot executable, including executable file name
-extern Fortran_vector r_ST_ref 	; // r_ST_ ref. values for C_TC =  0.5 mmol / ml sap solution
 
-// Network Architecture :
-extern int N1L ; // Organ type # 1L : 'leaf end' ; has imposed transpiration stream as a limit condition
-extern int N1R ; // Organ type # 1R : 'root tip' ; has imposed soil water potential as a limit condition
-// N[o = 1..8] = number of topological nodes of connectivity order o : N[1] = N1L + N1R ; N[0] = N[1] + N[2] + N[3] + ... + N[8] = Nt :
-extern int Nt, Nc, N[] ; // Nt = total number of nodes, Nc = total number of internode connections [= (1*N[1] + 2*N[2] + 3*N[3] + ... + 8*N[8]) / 2]
-extern Index_vector i_[] ; // i_[o = 0..8][k = 1..No] = id# of kth node in (1-based list)  list of all nodes of conn.ord. co(o). For o=0: No=N1L ; o=1: No=N1R ; o=2..8: No=N[o] :
-extern Index_vector &RootEnds, &LeafEnds ; // (= i_[1] and i_[0], resp.) : label which nodes are network ends = nodes of co=1 , which are either 'leaf' or 'root' ends :
-extern vector<int> I_Upflow, I_Downflow ; // I_Upflow(resp.I_Downflow)[jf=1..Nc] = id# du noeud amont (resp. aval) : jf = JF(i,i2) > 0 si I_Upflow[(abs(jf)]==i, i.e. si I_Downflow[(abs(jf)]==i2
-extern Fortran_vector kML						; // kinetic parameter / Michaelis - phloem loading					(mmol / ml)
-extern Fortran_vector vMU					; // kinetic parameter / phloem unloading								(mmol /h)
-//extern Fortran_vector	isTip ,Ag,  Lmax_org, Rmax_org, krm1, krm2 , StructC, exud_k; 
-extern Fortran_vector radius_ST ,  Length, vol_Seg;// Q_Grmax, Q_Rmmax, Q_Exudmax; 
-
-extern Fortran_vector Ag, Q_Grmax, Q_Rmmax, Q_Exudmax, exud_k, krm2, len_leaf; 
 // constants to express hydro resistance changes :
 #define NONE 0
 #define XYL 1
@@ -59,11 +37,10 @@ extern Fortran_vector Ag, Q_Grmax, Q_Rmmax, Q_Exudmax, exud_k, krm2, len_leaf;
 #define PARMB 64
 #define RABS 128
 
-std::weak_ptr<PhloemFlux> phloem_; 
-vector<double> extra_output_times, breakpoint_times ; // may contain already existing output time points
-extern int is, solver ; // (see below) solver config.# -- default = 1 = cvode (SPILS: SPFGMR, MODIFIED_GS, PREC_NONE... Try diff. value if calc. fails or too slow !
-void auxout(double t, double * y){phloem_.lock()->aux(t, y);} ;	// launch auxiliary calculations to store dynamics of temporary variables
-void fout(double t, double *y, double *y_dot){phloem_.lock()->f(t, y, y_dot);} ; // the function to be processed by the solver  (implemented in 'solve.cpp')
+thread_local PiafMunchContext* PM_context = NULL ;
+
+void auxout(double t, double * y){static_cast<PhloemFlux*>(PM_context)->aux(t, y);} ;	// launch auxiliary calculations to store dynamics of temporary variables
+void fout(double t, double *y, double *y_dot){static_cast<PhloemFlux*>(PM_context)->f(t, y, y_dot);} ; // the function to be processed by the solver  (implemented in 'solve.cpp')
 
 // Full list of printable/savable variables -- to be updated in case of hard-updating the model (number and nature of local compartments within each archit. element) :
 int NumAllNodeVariablesNames = 62 ; // 62 node variables :
@@ -81,111 +58,29 @@ string AllNodeVariablesNamesQList[] = {
 int NumAllConnVariablesNames = 5 ; // 5 internode connector flux variables :
 string AllConnVariablesNamesQList[] = { "C_Upflow (mmol / ml)", "JS_ST (mmol / h)", "JW_ST (ml / h)", "JW_Xyl (ml / h)", "TracerJS_ST (MBq / h)" } ;
 
-extern double *Q_ST, *Q_Mesophyll, *Q_RespMaint, *Q_Exudation, *Q_Growthtot, *Q_S_ST, *Q_Mucil ;		  // components of vector y as used in diff. system f()...
-extern double *Q_ST_dot, *Q_Mesophyll_dot, *Q_Rm_dot, *Q_Exud_dot, *Q_Gtot_dot, *Q_S_ST_dot, *Q_Mucil_dot ; //... and its derivatives.  ;
-extern double *Q_RespMaintmax, *TracerQ_Mesophyll, *TracerQ_RespMaint, *Q_S_Mesophyll, *Q_Growthtotmax ;		  // components of vector y as used in diff. system f()...
-extern double *Q_Rmmax_dot, *TracerQ_Mesophyll_dot, *TracerQ_Rm_dot, *Q_S_Mesophyll_dot, *Q_Gtotmax_dot ; //... and its derivatives.  ;
-extern double *vol_Sympl, *vol_Sympl_dot ;
-extern Fortran_vector Psi_Xyl, JW_ST, JS_ST, C_Sympl, C_ST, C_amont, JS_Sympl, JS_Apo, JS_ParMb, JS_PhlMb, Psi_Sympl, C_PhlApo, C_ParApo, P_ST, Absorb, RespMaint ;
-extern Fortran_vector JW_Trsv, JW_Xyl, JW_PhlMb, JW_ParMb, JW_Apo, JW_Sympl, P_Sympl, Psi_ST, P_Xyl, Psi_PhlApo, Psi_ParApo, P_PhlApo, P_ParApo ;
-extern Fortran_vector r_Xyl, r_ST, r_ST_ref, r_Trsv, r_PhlMb, r_ParMb, r_Apo, r_Sympl, vol_ST, vol_PhlApo, vol_ParApo ;
-extern Fortran_vector r_abs, PsiSoil, Transpirat, Input, Q_RespMaintSyn ;
-extern Fortran_vector P_ST_dot, P_Sympl_dot ; // variation rate of any variable X is noted: X_dot = dX/dt
-extern Fortran_vector C_SymplUpflow, C_ApoUpflow ; // to derive JS_Sympl, and maybe JS_Apo, from resp. water fluxes JW_xxx
-// tracer-specific add-ins :
-extern Fortran_vector TracerJS_ST, TracerC_Sympl, TracerC_ST, TracerJS_Sympl, TracerJS_Apo, TracerJS_ParMb, TracerJS_PhlMb, TracerC_PhlApo, TracerC_ParApo ;
-extern Fortran_vector TracerQ_RespMaintSyn, TracerInput, TracerRespMaint, TracerC_SymplUpflow, TracerC_ApoUpflow ;
-extern Fortran_vector TracerRatioSympl, TracerRatioQ_RespMaint ;
 
-// variables pointers are of type 'Fortran_vector*' (or NULL for those that are components of double* y in definition of function f).
-// Check for consistency between these lists AllxxxxVariablesRefsQList hereafter and AllxxxxVariablesNamesQList[] above:
-Fortran_vector* AllNodeVariablesRefsQList[] = {  // 62 node variables :
-	&Absorb, NULL, &Q_RespMaintSyn, &C_ST, &C_Sympl, &JS_PhlMb, &JW_Trsv, &JW_PhlMb, &JW_ParMb, &Psi_ST,
-	&P_Xyl, NULL, NULL, &RespMaint, &C_SymplUpflow, &JS_Sympl, &JW_Apo, &JW_Sympl , &P_ST, &P_Sympl,
-	&Psi_PhlApo, &Psi_ParApo, &Psi_Sympl, NULL, NULL, &P_PhlApo, &P_ParApo, NULL, NULL,
-	&C_PhlApo, &C_ParApo, NULL, NULL, &JS_Apo, &JS_ParMb, &C_ApoUpflow,
-	&P_ST_dot, &P_Sympl_dot,  NULL, NULL, NULL, &Input, &Transpirat, &PsiSoil,
-	// tracer-specific add-ons :
-	NULL, &TracerQ_RespMaintSyn, &TracerC_ST, &TracerC_Sympl, &TracerJS_PhlMb, NULL, NULL, &TracerRespMaint,
-	&TracerInput, &TracerJS_Sympl, &TracerJS_ParMb, NULL, NULL, &TracerC_PhlApo,
-	&TracerC_ParApo, &TracerJS_Apo , &TracerC_SymplUpflow, &TracerC_ApoUpflow
-} ;
-Fortran_vector* AllConnVariablesRefsQList[] = {&C_amont, &JS_ST,  &JW_ST, &JW_Xyl, &TracerJS_ST} ; // 5 internode-connector variables
-
-// temporary storage of results for output :
-Fortran_matrix Q_ST_t, Q_Mesophyll_t, Q_RespMaint_t, Q_Exudation_t, Q_Growthtot_t, Q_ST_dot_t, Q_Mesophyll_dot_t, Q_Rm_dot_t, Q_Exud_dot_t, Q_Gtot_dot_t, vol_Sympl_t, vol_Sympl_dot_t ;
-Fortran_matrix JW_ST_t, JS_ST_t, C_Sympl_t, C_ST_t, JS_Sympl_t, JS_Apo_t, JS_ParMb_t, JS_PhlMb_t, Psi_Sympl_t, C_PhlApo_t, C_ParApo_t, P_ST_t, Absorb_t, RespMaint_t ;
-Fortran_matrix JW_Trsv_t, JW_Xyl_t, JW_PhlMb_t, JW_ParMb_t, JW_Apo_t, JW_Sympl_t, P_Sympl_t, Psi_ST_t, P_Xyl_t, Psi_PhlApo_t, Psi_ParApo_t, P_PhlApo_t, P_ParApo_t ;
-Fortran_matrix PsiSoil_t, Transpirat_t, Input_t, Q_RespMaintSyn_t, P_ST_dot_t, P_Sympl_dot_t, C_SymplUpflow_t, C_ApoUpflow_t, C_amont_t ;
-// tracer-specific add-ins :
-Fortran_matrix Q_RespMaintmax_t, TracerQ_Mesophyll_t, TracerQ_RespMaint_t, Q_S_Mesophyll_t, Q_Growthtotmax_t ;		  // components of vector y as used in diff. system f()...
-// Fortran_matrix Q_Rmmax_dot_t, TracerQ_Mesophyll_dot_t, TracerQ_Rm_dot_t, Q_S_Mesophyll_dot_t, Q_Gtotmax_dot_t ;		  // components of vector y as used in diff. system f()...
-Fortran_matrix TracerJS_ST_t, TracerC_Sympl_t, TracerC_ST_t, TracerJS_Sympl_t, TracerJS_Apo_t, TracerJS_ParMb_t, TracerJS_PhlMb_t, TracerC_PhlApo_t, TracerC_ParApo_t, TracerC_SymplUpflow_t, TracerC_ApoUpflow_t ;
-Fortran_matrix TracerPhotSynth_t, TracerQ_RespMaintSyn_t, TracerInput_t, TracerRespMaint_t ;
 // Fortran_matrix TracerRatioSympl_t, TracerRatioQ_RespMaint_t ;
 
-Fortran_matrix* AllNodeMatricesRefsQList[] = {
-	&Absorb_t, &Q_RespMaint_t, &Q_RespMaintSyn_t, &C_ST_t, &C_Sympl_t, &JS_PhlMb_t, &JW_Trsv_t, &JW_PhlMb_t, &JW_ParMb_t, &Psi_ST_t,
-	&P_Xyl_t, &Q_Mesophyll_t, &Q_ST_t, &RespMaint_t, &C_SymplUpflow_t, &JS_Sympl_t, &JW_Apo_t, &JW_Sympl_t, &P_ST_t, &P_Sympl_t,
-	&Psi_PhlApo_t, &Psi_ParApo_t, &Psi_Sympl_t, &vol_Sympl_t, &vol_Sympl_dot_t, &P_PhlApo_t, &P_ParApo_t, &Q_Exudation_t, &Q_Growthtot_t,
-	&C_PhlApo_t, &C_ParApo_t, &Q_Exud_dot_t, &Q_Gtot_dot_t, &JS_Apo_t, &JS_ParMb_t, &C_ApoUpflow_t,
-	&P_ST_dot_t, &P_Sympl_dot_t, &Q_Rm_dot_t, &Q_ST_dot_t, &Q_Mesophyll_dot_t, &Input_t, &Transpirat_t, &PsiSoil_t,
-	// tracer-specific add-ons :
-	&TracerQ_RespMaint_t, &TracerQ_RespMaintSyn_t, &TracerC_ST_t, &TracerC_Sympl_t, &TracerJS_PhlMb_t, &TracerQ_Mesophyll_t, &Q_RespMaintmax_t, &TracerRespMaint_t,
-	&TracerInput_t, &TracerJS_Sympl_t, &TracerJS_ParMb_t, &Q_S_Mesophyll_t, &Q_Growthtotmax_t, &TracerC_PhlApo_t,
-	&TracerC_ParApo_t, &TracerJS_Apo_t, &TracerC_SymplUpflow_t, &TracerC_ApoUpflow_t
-};
-Fortran_matrix* AllConnMatricesRefsQList[] = {&C_amont_t, &JS_ST_t,  &JW_ST_t, &JW_Xyl_t, &TracerJS_ST_t} ;
-Index_vector Breakpoint_index(1, 1) ; // aux. for output time settings
-double * y_dot = NULL ;	// used in f() as called by aux() which is called by odesolve() -- contains all derivatives of vector Y (whose starting values are Y0 below) below.
-Fortran_vector Y0	; // (set in GUI) initial condition vector is made of Q_ST_0, Q_Mesophyll_0, Q_RespMaint_0, Q_Exudation_0 & Q_Growthtot_0, and homologous tracer init values, and vol_Sympl_0 :
-Fortran_vector atol_, rtol ; // integration accuracy parameters (set in GUI)
-double t0, tf, pas;		// solve for t = [t0, tf], save result at each time step (hours)
-extern double T;
-float t1 ; int nbv ; // pas = initial output step = between first 2 output steps t0 and t1
-bool LogScale = false ; // set to 'true' if log scale wanted (in 'PiafMunch2.cpp')
-Fortran_vector OutputTimes, SegmentTimes, truc ; // will be vector of, resp.: all output times including user-added extra- or breakpoint times ; output times for current integration time segment ; and an aux.
-
-
-extern int resistance_changed ;
-extern int jf, i, j ; double x ; bool to_store(true) ; FILE* file = NULL ; extern string S ;
-int nl = 0 ; // # of current line in matrices currently under construction in aux() -- one for each element SegmentTimes[nl] of time vector SegmentTimes
-extern vector<int> k_ ; // k_[i = 1 : Nt] = index of node #i in list i_[o(i)]   where o(i) = 0 for LeafEnds (k_[i] = - k then) ; o(i) = co(i) else  -- for the moment, filled only for (o = 0 or 1)   --   k_[i] = 0 else
-
-// Selected nodes/connectors and variables for plotting or saving output :
-int nsp, nvp, nss, nvs, fsp, fvp, fss, fvs, rsp(0), lsp(0), xsp ;
-list<int> SelectedSaveNodesQList ; list<string> SelectedSaveNodeVariablesNamesQList ;
-list<int> SelectedSaveConnsQList ; list<string> SelectedSaveConnVariablesNamesQList ;
-list<int> SelectedPlotNodesQList ; list<string> SelectedPlotNodeVariablesNamesQList ;
-list<int> SelectedPlotConnsQList ; list<string> SelectedPlotConnVariablesNamesQList ;
-list<Fortran_vector*> SelectedPlotNodeVariablesRefsQList ; list<Fortran_vector*> SelectedPlotConnVariablesRefsQList ;
-list<int> SelectedPlotNodeVariablesNamesIndicesInQList ; list<int> SelectedPlotConnVariablesNamesIndicesInQList ;
-list<Fortran_vector*> SelectedSaveNodeVariablesRefsQList ; list<Fortran_vector*> SelectedSaveConnVariablesRefsQList ;
-list<int> SelectedSaveNodeVariablesNamesIndicesInQList ; list<int> SelectedSaveConnVariablesNamesIndicesInQList ;
-// following matrices will store dynamics of variables to plot   -- filled in aux() :
-list<Fortran_matrix*> SelectedPlotNodeMatricesRefsQList, SelectedPlotConnMatricesRefsQList ;
-list<int> SelectedPlotNetworkEnds_k, SelectedSaveNetworkEnds_k ;
-
-extern string IniTitle ; // Path/name of .ini configuration file
-list<int>::iterator it, itk ; list<Fortran_vector*>::iterator itv ; list<string>::iterator its ; list<Fortran_matrix*>::iterator itm ;
-Fortran_vector* FV ; Fortran_matrix* FM ; string QS ;
-bool AutoQuit(false); // will be TRUEd if launched with '-q' (which will also disable Plotting)
-
 
 int PhloemFlux::startPM(double StartTime, double EndTime, int OutputStep,double TairK, bool verbose, std::string filename) {
+	struct Binding { // binds this thread to the state of this instance, until startPM returns or throws
+		PiafMunchContext* previous = PM_context ;
+		Binding(PiafMunchContext* c) { PM_context = c ; }
+		~Binding() { PM_context = previous ; Sparse_registers_clear() ; }
+	} binding(this) ;
 	//std::string nametroubleshootingfile = "outputPM"+"_"+ std::to_string(simTime)+".txt"
 	std::ofstream out(filename);
-	std::streambuf *coutbuf = std::cout.rdbuf(); //save old buf
+	std::streambuf *coutbuf = PM_cout.rdbuf(); //save old buf
 	if(doTroubleshooting){
-		std::cout.rdbuf(out.rdbuf()); //redirect std::cout to out.txt!
-		cout<<"extainr TairK "<<TairK<<" "<<StartTime<<" "<<EndTime<<" "<<OutputStep<<" verbose "<<verbose<<std::endl;
+		PM_cout.rdbuf(out.rdbuf()); //redirect the log of this thread to out.txt, std::cout is left untouched
+		PM_cout<<"extainr TairK "<<TairK<<" "<<StartTime<<" "<<EndTime<<" "<<OutputStep<<" verbose "<<verbose<<std::endl;
 	}
 	
     t0  = StartTime; tf  = EndTime;	nbv = OutputStep; T = TairK; TairK_phloem = TairK;
 	
 	nl = 0;
 	if(doTroubleshooting){
-		std::cout <<"set out put vec "<<t0<<" "<<t1<<" "<<tf<<" "<<nbv<<std::endl;
+		PM_cout <<"set out put vec "<<t0<<" "<<t1<<" "<<tf<<" "<<nbv<<std::endl;
 	}
 	initializePM_(tf-t0, TairK);
 	initialize_carbon(this->Q_outv) ;		// sizes C-fluxes-related variable vectors
@@ -195,13 +90,13 @@ int PhloemFlux::startPM(double StartTime, double EndTime, int OutputStep,double
     pas = (tf-t0)/double(nbv);
 	t1 = t0 + pas ; //nbv = (int)((tf-t0)/pas) ; // pas = initial output step = between first 2 output steps t0 and t1 as set in GUI
 	if(doTroubleshooting){
-		std::cout <<"set out put vec "<<t0<<" "<<t1<<" "<<tf<<" "<<pas<<" "<<nbv<<std::endl;}
+		PM_cout <<"set out put vec "<<t0<<" "<<t1<<" "<<tf<<" "<<pas<<" "<<nbv<<std::endl;}
 	
 	OutputSettings() ; // sets up file and graph outputs, including possible breakpoint- and/or extra-output- times as stated above
 
     // *************** SOLVING THE DIFFERENTIAL EQUATION SYSTEM ************************************* :
     int neq = Y0.size() ;							// number of differential eq. = problem size (= 8*Nt apres ajouts FAD)
-    if(doTroubleshooting){cout<<"neq "<<neq<<" "<<Nc<<" "<<Nt<<endl;}
+    if(doTroubleshooting){PM_cout<<"neq "<<neq<<" "<<Nc<<" "<<Nt<<endl;}
 	
 	assert((Nt == (neq/neq_coef))&&"Wrong seg and node number");
 	assert((Nc == (Nt -1))&&"Wrong seg and node number");
@@ -217,15 +112,14 @@ int PhloemFlux::startPM(double StartTime, double EndTime, int OutputStep,double
 		//throw std::runtime_error("Breakpoint_index.size() ");
 
 	if(doTroubleshooting){
-		std::cout <<"add pointer "<<std::endl;
+		PM_cout <<"add pointer "<<std::endl;
 	}
-	phloem_ = this->Phloem();
     for(is = 1 ; is < Breakpoint_index.size() ; is ++) { // allows several integration segments in relation to breakpoints (if any -- OK if none)
         SegmentTimes = subvector(OutputTimes, Breakpoint_index(is), Breakpoint_index(is+1))  ; // time segment between 2 breakpoints (Breakpoint_index(1) = 1 ; Breakpoint_index(Breakpoint_index.size()) = 1 + nbv)
-        cout << endl << "starting integration on time segment #" << is << " = [" << SegmentTimes[1] << ", " << SegmentTimes[SegmentTimes.size()] << "] "<< Breakpoint_index.size()<<" "<<SegmentTimes.size()<< endl ;
+        PM_cout << endl << "starting integration on time segment #" << is << " = [" << SegmentTimes[1] << ", " << SegmentTimes[SegmentTimes.size()] << "] "<< Breakpoint_index.size()<<" "<<SegmentTimes.size()<< endl ;
          // ***** the following solver configs are ranked from the most efficient (in most tested situations) to the least (in most tested situations). Can change in different situations ! *****
         //   see  SUNDIALS  documentation  for  cvode  solver options (SPxxxx, xxxx_GS, PREC_xxxx, BAND, etc.)
-		if(doTroubleshooting){cout <<"solver, Y0: "<<solver <<endl;}
+		if(doTroubleshooting){PM_cout <<"solver, Y0: "<<solver <<endl;}
 		switch (solver) {
 			case 1: j = cvode_spils(fout, Y0, SegmentTimes, auxout, atol_, rtol, SPFGMR, MODIFIED_GS, PREC_NONE, 2, Var_integrale, Var_derivee); break; // STALD = true, verbose = true, rootfind = NULL
 			case 2: j = cvode_spils(fout, Y0, SegmentTimes, auxout, atol_, rtol, SPGMR, MODIFIED_GS, PREC_NONE, 2, Var_integrale, Var_derivee); break; // STALD = true, verbose = true, rootfind = NULL
@@ -262,18 +156,18 @@ int PhloemFlux::startPM(double StartTime, double EndTime, int OutputStep,double
 			case 33 : j = cvode_spils(fout, Y0, SegmentTimes, auxout, atol_, rtol, SPTFQMR, 1, PREC_LEFT, 2, Var_integrale, Var_derivee) ; break ; //
 				case 34: j = cvode_direct(fout, Y0, SegmentTimes, auxout, atol_, rtol, BAND, 2, Var_integrale, Var_derivee, true, true, NULL, 0, neq / 300, neq / 300); break; //
 			case 35: j = cvode_spils(fout, Y0, SegmentTimes, auxout, atol_, rtol, SPTFQMR, 1, PREC_BOTH, 2, Var_integrale, Var_derivee); break; //
-			default : cout << endl << "!! Error !! solver # must be within the range [1 , 35] !!" << endl ; j = -1 ; exit(-1) ;
+			default : PM_cout << endl << "!! Error !! solver # must be within the range [1 , 35] !!" << endl ; j = -1 ; exit(-1) ;
         }		
-		if (j < 0) return (-1); // solver init error
+		if (j < 0) {PM_cout.rdbuf(coutbuf); return (-1);} // solver init error
 		if (j > 0) break ; // simulation run-time error
         
     }
     // ********************* OUTPUT *********************************
-    std::cout<<"MEMORY LIBERATIONS"<<std::endl;
+    PM_cout<<"MEMORY LIBERATIONS"<<std::endl;
     // MEMORY LIBERATIONS:
     delete [] y_dot;
 	//for python:
-    std::cout<<"fortran to python vector"<<std::endl;
+    PM_cout<<"fortran to python vector"<<std::endl;
 	this->Q_outv = Y0.toCppVector();//att: now has several outputs
 	
 	this->Q_out_dotv = std::vector<double>(Y0.size(),0);
@@ -289,14 +183,14 @@ int PhloemFlux::startPM(double StartTime, double EndTime, int OutputStep,double
 	this->Flv = Input.toCppVector() ;
 	this->r_STv = r_ST.toCppVector() ;
 	this->JW_STv = JW_ST.toCppVector() ;
-    std::cout<<"computeOrgGrowth"<<std::endl;
+    PM_cout<<"computeOrgGrowth"<<std::endl;
 	computeOrgGrowth(tf-t0);
-	if(doTroubleshooting){std::cout.rdbuf(coutbuf);} //reset to standard output again
+	PM_cout.rdbuf(coutbuf); //reset to standard output again
 	return(1) ;
 	
 }
 
-void OutputSettings()  {
+void PiafMunchContext::OutputSettings()  {
 	OutputTimes = Fortran_vector(nbv + 1) ;
 	OutputTimes[1]=t0 ; if(nbv > 0) OutputTimes[2] = t1 ;
 	for(i=2 ; i <= nbv ; i++) {
@@ -305,7 +199,7 @@ void OutputSettings()  {
 	}
 	OutputTimes[nbv + 1] = tf;
 	if(Breakpoint_index[Breakpoint_index.size()]  != OutputTimes.size())  Breakpoint_index.append(Index_vector(1, OutputTimes.size())) ;
-	cout << "Output times :" << endl ; for(i=0 ; i < OutputTimes.size() ; i ++) cout << " " <<  OutputTimes[i+1] ; // if newly inserted extra output time (just after breakpoint) is too close, it may print as the same but actually is not
+	PM_cout << "Output times :" << endl ; for(i=0 ; i < OutputTimes.size() ; i ++) PM_cout << " " <<  OutputTimes[i+1] ; // if newly inserted extra output time (just after breakpoint) is too close, it may print as the same but actually is not
 	nbv = OutputTimes.size() - 1 ; // at this point,  output times vector truc = OutputTimes ; and Breakpoint_index = {1, [...,] nbv+1}  with  [...,] = extra breakpoints indices (empty if none)
 	
 }
@@ -319,8 +213,8 @@ void PhloemFlux::aux(double t, double * y) {	// launch auxiliary calculations to
 		for (int it = 1 ; it <= Nt  ; it++){
 			if(Q_ST[j]<0.)
 			{
-				std::cout<< "at t = " << t << " : Y0.size() = " << Y0.size()<<std::endl;
-				std::cout<<"negative Q_ST value at j = "<<j<<", Q_ST[j] = "<< Q_ST[j] <<std::endl;
+				PM_cout<< "at t = " << t << " : Y0.size() = " << Y0.size()<<std::endl;
+				PM_cout<<"negative Q_ST value at j = "<<j<<", Q_ST[j] = "<< Q_ST[j] <<std::endl;
 				assert(false);
 			}
 		}
@@ -331,14 +225,14 @@ void PhloemFlux::aux(double t, double * y) {	// launch auxiliary calculations to
 		Y0[j] = y[j] ; 
 		if((j <= Nt)&&(Y0[j] < 0.)){assert(false && "negative C_ST value");}
 	}// update Y0
-	std::cout << "at t = " << t << " : Y0.size() = " << Y0.size();
-	std::cout<<std::endl;
+	PM_cout << "at t = " << t << " : Y0.size() = " << Y0.size();
+	PM_cout<<std::endl;
 }
 
 
 void PhloemFlux::initializePM_(double dt, double TairK){	
 	//all is in mmol/ml (=> M) and in d-1
-	if(doTroubleshooting){cout<<"initializePM_1 "<<endl;}
+	if(doTroubleshooting){PM_cout<<"initializePM_1 "<<endl;}
 	Adv_BioPhysics = false;
 	vector<CPlantBox::Vector2i> segmentsPlant = plant->segments;
 	Nc = segmentsPlant.size(); Nt = plant->nodes.size();
@@ -366,7 +260,7 @@ void PhloemFlux::initializePM_(double dt, double TairK){
 	krm2=Fortran_vector(Nt, 0.);
 	Csoil_node.resize(Nt,0.);
 	deltaSucOrgNode_ = waterLimitedGrowth(dt);//water limited growth
-	if(doTroubleshooting){cout<<"initializePM_new "<<Nc<<" "<<Nt<<endl;}
+	if(doTroubleshooting){PM_cout<<"initializePM_new "<<Nc<<" "<<Nt<<endl;}
 	int nodeID;
 	double StructSucrose;//double deltaStructSucrose;
 	double cmH2O_to_hPa = 0.980638	;//cm to hPa
@@ -443,7 +337,7 @@ void PhloemFlux::initializePM_(double dt, double TairK){
 					Csoil_node.at(segmentsPlant[k-1].y ) = CsoilDefault;
 				}
 			}
-			if(doTroubleshooting){std::cout<<"QexudMax "<<Q_Exudmax[nodeID ]<<std::endl;}
+			if(doTroubleshooting){PM_cout<<"QexudMax "<<Q_Exudmax[nodeID ]<<std::endl;}
 			
 			
 			//Rm, maintenance respiration 
@@ -467,11 +361,11 @@ void PhloemFlux::initializePM_(double dt, double TairK){
 					}
 			}		
 			StructSucrose = rhoSucrose_f(st,ot) * vol_Seg[nodeID]; 
-			if(doTroubleshooting){std::cout<<"LeafShape "<<(k-1)<<" "<<l_blade<<" "<<vol_ParApo[nodeID]<<" "<<surfMeso<<std::endl;}
+			if(doTroubleshooting){PM_cout<<"LeafShape "<<(k-1)<<" "<<l_blade<<" "<<vol_ParApo[nodeID]<<" "<<surfMeso<<std::endl;}
 			
 			Q_Rmmax[nodeID] = krm1 * StructSucrose;
 			if(doTroubleshooting){
-				std::cout<<"forRmmax "<<nodeID<<" "<< vol_Seg[nodeID]<<" "<<krm1<<" "<<krm2[nodeID]<<" "<<rhoSucrose_f(st,ot)<<" "<<Q_Rmmax[nodeID]<<std::endl;
+				PM_cout<<"forRmmax "<<nodeID<<" "<< vol_Seg[nodeID]<<" "<<krm1<<" "<<krm2[nodeID]<<" "<<rhoSucrose_f(st,ot)<<" "<<Q_Rmmax[nodeID]<<std::endl;
 			}
 			
 			//Gr, growth and growth respiration
@@ -479,29 +373,29 @@ void PhloemFlux::initializePM_(double dt, double TairK){
 			
 			Q_Grmax[nodeID] = deltaSucOrgNode_.at(k).at(-1)/Gr_Y/dt;
 			if(doTroubleshooting){
-				std::cout<<"forGrmax"<<nodeID<<" "<< deltaSucOrgNode_.at(k).at(-1)<<" "<<Q_Grmax[nodeID]<<std::endl;
+				PM_cout<<"forGrmax"<<nodeID<<" "<< deltaSucOrgNode_.at(k).at(-1)<<" "<<Q_Grmax[nodeID]<<std::endl;
 			}
 		
 		//Test
 			if(exud_k[nodeID]<0.){
-				std::cout<<"exud_k[nodeID]: loop n#"<<k<<", node "<<nodeID<<" "<<exud_k[nodeID]<<" "<<(exud_k[nodeID]<0.);
-				std::cout<<" "<<" "<<(exud_k[nodeID]==0.)<<" "<<" "<<(exud_k[nodeID]>0.)<<std::endl;
+				PM_cout<<"exud_k[nodeID]: loop n#"<<k<<", node "<<nodeID<<" "<<exud_k[nodeID]<<" "<<(exud_k[nodeID]<0.);
+				PM_cout<<" "<<" "<<(exud_k[nodeID]==0.)<<" "<<" "<<(exud_k[nodeID]>0.)<<std::endl;
 				assert(false);
 			}
 			if(krm2[nodeID]<0.){
-				std::cout<<"krm2: loop n#"<<k<<", node "<<nodeID<<" "<<krm2[nodeID]<<std::endl;
+				PM_cout<<"krm2: loop n#"<<k<<", node "<<nodeID<<" "<<krm2[nodeID]<<std::endl;
 				assert(false);
 			}
 			if(Q_Grmax[nodeID ]<0.){
-				std::cout<<"gr: loop n#"<<k<<", node "<<nodeID<<" "<<Q_Grmax[nodeID]<<" "<< deltaSucOrgNode_.at(k).at(-1)<<std::endl;
+				PM_cout<<"gr: loop n#"<<k<<", node "<<nodeID<<" "<<Q_Grmax[nodeID]<<" "<< deltaSucOrgNode_.at(k).at(-1)<<std::endl;
 				assert(false);
 			}
 			if(Q_Exudmax[nodeID ]<0.){
-				std::cout<<"exud: loop n#"<<k<<", node "<<nodeID<<" "<<Q_Exudmax[nodeID]<<" "<< l<<" "<<Radii[k-1]<<std::endl;
+				PM_cout<<"exud: loop n#"<<k<<", node "<<nodeID<<" "<<Q_Exudmax[nodeID]<<" "<< l<<" "<<Radii[k-1]<<std::endl;
 				assert(false);
 			}
 			if(Q_Rmmax[nodeID ]< 0.){
-				std::cout<<"rm: loop n#"<<k<<", node "<<nodeID<<" "<<Q_Rmmax[nodeID]<<" "<< krm1<<" "<<StructSucrose<<std::endl;
+				PM_cout<<"rm: loop n#"<<k<<", node "<<nodeID<<" "<<Q_Rmmax[nodeID]<<" "<< krm1<<" "<<StructSucrose<<std::endl;
 				assert(false);
 			}
 			//
@@ -532,7 +426,7 @@ void rootfind(double t, double* y, double* g) {return ; } // required but not us
 
 void PhloemFlux::computeOrgGrowth(double t){
 	
-	if(doTroubleshooting){std::cout<<"PhloemFlux::computeOrgGrowth_start"<<std::endl;}
+	if(doTroubleshooting){PM_cout<<"PhloemFlux::computeOrgGrowth_start"<<std::endl;}
 	int nNode = plant->getNumberOfNodes();
 	auto orgs = plant->getOrgans(-1, true); //get all organs, even small ones
 	int nOrg = orgs.size();
@@ -564,7 +458,7 @@ void PhloemFlux::computeOrgGrowth(double t){
 		int stold = org->getParameter("subType");
 		int st = plant->st2newst[std::make_tuple(ot,stold)];
 		int nNodes = org->getNumberOfNodes();
-		if(doTroubleshooting){std::cout<<"org "<<orgID<<" "<<st<<" "<<ot<<" "<<nNodes<<std::endl;}
+		if(doTroubleshooting){PM_cout<<"org "<<orgID<<" "<<st<<" "<<ot<<" "<<nNodes<<std::endl;}
 		
 		if(ot == 2){
 			nodeIds_.push_back(org->getNodeId(nNodes-1));			
@@ -578,13 +472,13 @@ void PhloemFlux::computeOrgGrowth(double t){
 			double deltaSucmax_1 = 0;
 			if(deltaSucOrgNode_.at(nodeIds_.at(k)).count(org->getId()) !=0){
 				deltaSucmax_1 = deltaSucOrgNode_.at(nodeIds_.at(k)).at(org->getId());//maxsuc needed for Gr
-				if(doTroubleshooting){std::cout<<"deltaSucmax_1 "<<org->getId()<<" "<<k<<" "<<deltaSucmax_1<<std::endl;}
+				if(doTroubleshooting){PM_cout<<"deltaSucmax_1 "<<org->getId()<<" "<<k<<" "<<deltaSucmax_1<<std::endl;}
 			}
 			double deltaSucmax_ = deltaSucmax_1 /Gr_Y;//max suc needed for Gtot
 			double deltaSuc = min(Q_Growthtot[nodeIds_.at(k) +1] - Q_GrowthtotBU[nodeIds_.at(k) +1], deltaSucmax_);
 			if((deltaSucmax_ > Q_Grmax[nodeIds_.at(k) +1]))
 			{
-				std::cout<<"error Q_Grmax "<<k<<" "<<(nodeIds_.at(k)+1)<<" "<<deltaSucmax_<<" "<<Q_Grmax[nodeIds_.at(k) +1]<<std::endl;
+				PM_cout<<"error Q_Grmax "<<k<<" "<<(nodeIds_.at(k)+1)<<" "<<deltaSucmax_<<" "<<Q_Grmax[nodeIds_.at(k) +1]<<std::endl;
 				assert(false);
 			}
 			if((deltaSuc < 0.)&&(deltaSuc > -1e-5)){deltaSuc=0.;}
@@ -609,10 +503,10 @@ void PhloemFlux::computeOrgGrowth(double t){
 				if(org->getNodeIds().size() == 1)
 				{
 					Q_GrUnbornv_i.at(org->getNodeIds().at(0)) += deltaSuc;
-					std::cout<<"Q_GrUnbornv_i for org "<<org->getId()<<" on node "<<org->getNodeIds().at(0)<<" deltasuc "<<deltaSuc<<std::endl;
-					std::cout<<"unborn id "<<orgID<<" or "<<orgID2<<std::endl;
-					std::cout<<"unborn age "<<org->getAge()<<" "<<t<<" "<<org->isAlive()<<" "<<org->isActive()<<std::endl;
-					std::cout<<"compute suc "<<Q_GrowthtotBU[nodeIds_.at(k) +1]<<" "<<Q_Growthtot[nodeIds_.at(k) +1]<<std::endl;
+					PM_cout<<"Q_GrUnbornv_i for org "<<org->getId()<<" on node "<<org->getNodeIds().at(0)<<" deltasuc "<<deltaSuc<<std::endl;
+					PM_cout<<"unborn id "<<orgID<<" or "<<orgID2<<std::endl;
+					PM_cout<<"unborn age "<<org->getAge()<<" "<<t<<" "<<org->isAlive()<<" "<<org->isActive()<<std::endl;
+					PM_cout<<"compute suc "<<Q_GrowthtotBU[nodeIds_.at(k) +1]<<" "<<Q_Growthtot[nodeIds_.at(k) +1]<<std::endl;
 				}
 			}
 			
@@ -625,9 +519,9 @@ void PhloemFlux::computeOrgGrowth(double t){
 		double l_check = org->orgVolume2Length(vol);
 		
 		if((abs(l_ - l_check)>1e-5) || (abs(vol - vol_check)>1e-5)){
-			std::cout<<"(abs(l_ - l_check)<1e-5) || (abs(vol - vol_check)<1e-5)"<<std::endl;
-			std::cout<<ot<<" "<<(abs(l_ - l_check)<1e-5)<<" "<< (abs(vol - vol_check)<1e-5)<<std::endl;
-			std::cout<<l_<<" "<<l_check<<" "<<vol<<" "<<vol_check<<std::endl;
+			PM_cout<<"(abs(l_ - l_check)<1e-5) || (abs(vol - vol_check)<1e-5)"<<std::endl;
+			PM_cout<<ot<<" "<<(abs(l_ - l_check)<1e-5)<<" "<< (abs(vol - vol_check)<1e-5)<<std::endl;
+			PM_cout<<l_<<" "<<l_check<<" "<<vol<<" "<<vol_check<<std::endl;
 			assert(false);
 		}
 		double newl = l_;
@@ -643,8 +537,8 @@ void PhloemFlux::computeOrgGrowth(double t){
 		double orgGr = newl - l_;
 		double delta_lmax = newl_max - l_;
 		if(doTroubleshooting){
-			std::cout<<"deltavolorg "<<delta_volOrg<<" "<<delta_volOrgmax<<std::endl;
-			std::cout<<"vol increase "<<vol<<" "<<l_<<" "<<newl<<" "<<newl_max<<" "<<orgGr<<" "<<delta_lmax<<std::endl;
+			PM_cout<<"deltavolorg "<<delta_volOrg<<" "<<delta_volOrgmax<<std::endl;
+			PM_cout<<"vol increase "<<vol<<" "<<l_<<" "<<newl<<" "<<newl_max<<" "<<orgGr<<" "<<delta_lmax<<std::endl;
 		}
 		
 		if((orgGr < 0.)&&(orgGr > -1e-10)){orgGr=0.;}
@@ -663,8 +557,8 @@ void PhloemFlux::computeOrgGrowth(double t){
 		}
 		if((BackUpMaxGrowth[orgID2] - newl)< -1e-10)
 		{
-			std::cout <<ot<<" "<<st<<" "<<orgID<<" "<<orgID2<<" "<<newl<<" "<<BackUpMaxGrowth[orgID2] <<" ";
-			std::cout<<(BackUpMaxGrowth[orgID2]- newl)<<std::endl;
+			PM_cout <<ot<<" "<<st<<" "<<orgID<<" "<<orgID2<<" "<<newl<<" "<<BackUpMaxGrowth[orgID2] <<" ";
+			PM_cout<<(BackUpMaxGrowth[orgID2]- newl)<<std::endl;
 			throw std::runtime_error("PhloemFlux::computeOrgGrowth: new target length of organ too high");
 		}
 		delta_ls_org.at(orgID2) 	+= orgGr;
@@ -685,76 +579,76 @@ void PhloemFlux::computeOrgGrowth(double t){
 		if(orp!= NULL) {orp->f_gf->CW_Gr = cWGrLeaf;}
 	}
 	if(doTroubleshooting){
-		std::cout<<"cWGrRoot "<<std::endl;
+		PM_cout<<"cWGrRoot "<<std::endl;
 		for(auto it = cWGrRoot.cbegin(); it != cWGrRoot.cend(); ++it)
 		{
-			std::cout << it->first << " " << it->second<< "\n";
+			PM_cout << it->first << " " << it->second<< "\n";
 		}
-		std::cout<<"cWGrStem "<<std::endl;
+		PM_cout<<"cWGrStem "<<std::endl;
 		for(auto it = cWGrStem.cbegin(); it != cWGrStem.cend(); ++it)
 		{
-			std::cout << it->first << " " << it->second << "\n";
+			PM_cout << it->first << " " << it->second << "\n";
 		}
-		std::cout<<"cWGrLeaf "<<std::endl;
+		PM_cout<<"cWGrLeaf "<<std::endl;
 		for(auto it = cWGrLeaf.cbegin(); it != cWGrLeaf.cend(); ++it)
 		{
-			std::cout << it->first << " " << it->second<< "\n";
+			PM_cout << it->first << " " << it->second<< "\n";
 		}
 	}
 	for(int u = 0; u < Q_GrUnbornv_i.size();u++)
 	{
 		if((Q_GrmaxUnbornv_i.at(u)-Q_GrUnbornv_i.at(u)) < -1e-10 )
 		{
-			std::cout<<std::endl;std::cout<<"sucsink unborn on node"<<std::endl;
+			PM_cout<<std::endl;PM_cout<<"sucsink unborn on node"<<std::endl;
 			for(int u_ = 0; u_ < Q_GrUnbornv_i.size();u_++)
 			{
-				std::cout<<Q_GrUnbornv_i.at(u_)<<" ";
+				PM_cout<<Q_GrUnbornv_i.at(u_)<<" ";
 			}
-			std::cout<<std::endl;std::cout<<"sucsink max unborn on node "<<std::endl;
+			PM_cout<<std::endl;PM_cout<<"sucsink max unborn on node "<<std::endl;
 			for(int u_ = 0; u_ < Q_GrmaxUnbornv_i.size();u_++)
 			{
-				std::cout<<Q_GrmaxUnbornv_i.at(u_)<<" ";
+				PM_cout<<Q_GrmaxUnbornv_i.at(u_)<<" ";
 			}
-			std::cout<<std::endl;std::cout<<"sucsink unborn per org"<<std::endl;
+			PM_cout<<std::endl;PM_cout<<"sucsink unborn per org"<<std::endl;
 			for(int u_ = 0; u_ < BackUpMaxGrowth.size();u_++)
 			{
-				std::cout<<BackUpMaxGrowth.at(u_)<<" ";
+				PM_cout<<BackUpMaxGrowth.at(u_)<<" ";
 			}
-			std::cout<<std::endl;std::cout<<"get id"<<std::endl;
+			PM_cout<<std::endl;PM_cout<<"get id"<<std::endl;
 			for(int u_ = 0; u_ < orgs.size();u_++)
 			{
-				std::cout<<orgs.at(u_)->getId()<<" ";
+				PM_cout<<orgs.at(u_)->getId()<<" ";
 			}
-			std::cout<<std::endl;std::cout<<"num of nodes"<<std::endl;
+			PM_cout<<std::endl;PM_cout<<"num of nodes"<<std::endl;
 			for(int u_ = 0; u_ < orgs.size();u_++)
 			{
-				std::cout<<orgs.at(u_)->getNumberOfNodes()<<" ";
+				PM_cout<<orgs.at(u_)->getNumberOfNodes()<<" ";
 			}
-			std::cout<<std::endl;std::cout<<"global init ID"<<std::endl;
+			PM_cout<<std::endl;PM_cout<<"global init ID"<<std::endl;
 			for(int u_ = 0; u_ < orgs.size();u_++)
 			{
-				std::cout<<orgs.at(u_)->getNodeId(0)<<" ";
+				PM_cout<<orgs.at(u_)->getNodeId(0)<<" ";
 			}
-			std::cout<<std::endl;std::cout<<"global init ID"<<std::endl;
+			PM_cout<<std::endl;PM_cout<<"global init ID"<<std::endl;
 			for(int u_ = 0; u_ < orgs.size();u_++)
 			{
-				std::cout<<orgs.at(u_)->getNodeId(0)<<" ";
+				PM_cout<<orgs.at(u_)->getNodeId(0)<<" ";
 			}
-			std::cout<<std::endl;std::cout<<"getage"<<std::endl;
+			PM_cout<<std::endl;PM_cout<<"getage"<<std::endl;
 			for(int u_ = 0; u_ < orgs.size();u_++)
 			{
-				std::cout<<orgs.at(u_)->getAge()<<" ";
+				PM_cout<<orgs.at(u_)->getAge()<<" ";
 			}
-			std::cout<<std::endl;
-			std::cout<<u<<" "<<Q_GrUnbornv_i.at(u)<<" "<<Q_GrmaxUnbornv_i.at(u)<<std::endl;
+			PM_cout<<std::endl;
+			PM_cout<<u<<" "<<Q_GrUnbornv_i.at(u)<<" "<<Q_GrmaxUnbornv_i.at(u)<<std::endl;
 			auto org = orgs.at(u);
-			std::cout<<org->organType()<<" "<<org->getParameter("subType")<<" "<<org->getParent()->getId()<<std::endl;
-			std::cout<<org->parentNI<<" "<<org->getId()<<" "<<org->getNumberOfNodes()<<" "<<org->getAge()<<std::endl;
+			PM_cout<<org->organType()<<" "<<org->getParameter("subType")<<" "<<org->getParent()->getId()<<std::endl;
+			PM_cout<<org->parentNI<<" "<<org->getId()<<" "<<org->getNumberOfNodes()<<" "<<org->getAge()<<std::endl;
 			
 			throw runtime_error("PhloemFlux::computeOrgGrowth: Q_GrUnbornv_i.at(u) > Q_GrmaxUnbornv_i.at(u)");
 		}
 	}
-	if(doTroubleshooting){std::cout<<"PhloemFlux::computeOrgGrowth_end"<<std::endl;}
+	if(doTroubleshooting){PM_cout<<"PhloemFlux::computeOrgGrowth_end"<<std::endl;}
 }
 
 
@@ -762,7 +656,7 @@ void PhloemFlux::computeOrgGrowth(double t){
 std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 {
 	
-	if(doTroubleshooting){std::cout<<"PhloemFlux::waterLimitedGrowth_start"<<std::endl;}
+	if(doTroubleshooting){PM_cout<<"PhloemFlux::waterLimitedGrowth_start"<<std::endl;}
 	int Nr = plant->nodes.size();
 	std::map<int,double> initMap = { { -1,0. } };//-1 : total need per node
 	std::vector<std::map<int,double>> deltaSucOrgNode(Nr, initMap);//, 0.);
@@ -797,8 +691,8 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 			//if(orp!= NULL) {orp->f_gf->CW_Gr = cWGrRoot;}	
 			if(f_gf_ind != 3)//(f_gf_ind != 3)
 			{
-				std::cout<<"org id "<<org->getId()<<" ot "<<ot<<" st "<<st<<" Linit "<<Linit<<" numNodes ";
-				std::cout<<org->getNumberOfNodes()<<" "<<rmax<<" f_gf_ind "<<f_gf_ind<<std::endl;
+				PM_cout<<"org id "<<org->getId()<<" ot "<<ot<<" st "<<st<<" Linit "<<Linit<<" numNodes ";
+				PM_cout<<org->getNumberOfNodes()<<" "<<rmax<<" f_gf_ind "<<f_gf_ind<<std::endl;
 				assert((f_gf_ind == 3)&&"PhloemFlux::waterLimitedGrowth: organ does not use carbon-limited growth");
 			}
 			f_gf_ind = 1; // take negative exponential growth dynamic [f_gf_ind == 1] to compute max growth 
@@ -811,28 +705,28 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 					(org->getOrganRandomParameter()->f_gf->CW_Gr.find(org->getId())->second<0.)))&&
 					org->isActive()&&useCWGr)
 			{
-				std::cout<<org->getId()<<" "<<org->getOrganRandomParameter()->f_gf->CW_Gr.find(org->getId())->second<<std::endl;
-				std::cout<<org->calcLength(1)<<" "<< ot <<" "<<org->getAge()<<std::endl;
+				PM_cout<<org->getId()<<" "<<org->getOrganRandomParameter()->f_gf->CW_Gr.find(org->getId())->second<<std::endl;
+				PM_cout<<org->calcLength(1)<<" "<< ot <<" "<<org->getAge()<<std::endl;
 				throw std::runtime_error("PhloemFlux::waterLimitedGrowth: sucrose for growth has not been used at last time step");
 			}
 			
 			
 			if(doTroubleshooting){
-				std::cout<<"start new org "<<org->getId()<<" "<<org->parentNI<<" "<<age<<" "<<ot<<" "<<org->getParameter("subType")<<" ";
-				std::cout<<orgLT<<" "<<org->getLength(true)<<" "<<Linit;
-				std::cout<<" "<<age_<<" "<<t<<" "<<dt<<std::endl;} 
+				PM_cout<<"start new org "<<org->getId()<<" "<<org->parentNI<<" "<<age<<" "<<ot<<" "<<org->getParameter("subType")<<" ";
+				PM_cout<<orgLT<<" "<<org->getLength(true)<<" "<<Linit;
+				PM_cout<<" "<<age_<<" "<<t<<" "<<dt<<std::endl;} 
 				
 			if (age+dt>orgLT) { // root life time
 				dt=orgLT-age; // remaining life span
 			}
-			if(doTroubleshooting){std::cout<<"new dt "<<dt<<std::endl;} 
+			if(doTroubleshooting){PM_cout<<"new dt "<<dt<<std::endl;} 
 			
 			//no probabilistic branching models and no other scaling via getRootRandomParameter()->f_se->getValue(nodes.back(), shared_from_this());
 			if(ot == CPlantBox::Organism::ot_stem){
 				
 				double delayNGStart = org->getParameter("delayNGStart");
 				double delayNGEnd = org->getParameter("delayNGEnd");
-				if(doTroubleshooting){std::cout<<"stem: "<<delayNGStart<<" "<< delayNGEnd <<std::endl;} 
+				if(doTroubleshooting){PM_cout<<"stem: "<<delayNGStart<<" "<< delayNGEnd <<std::endl;} 
 				if((age+dt) > delayNGStart){//simulation ends after start of growth pause
 					if((age+dt)  < delayNGEnd){dt = 0;//during growth pause
 					}else{
@@ -844,18 +738,18 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 							afterPause = std::min(dt, std::max(age +dt  - delayNGEnd, 0.)); //part of the simulation after end of pause
 						}
 						dt = beforePause + afterPause;//part of growth pause during simulation
-							if(doTroubleshooting){std::cout<<"part of growth pause during simulation: "<<beforePause <<" "<< afterPause <<std::endl;} 
+							if(doTroubleshooting){PM_cout<<"part of growth pause during simulation: "<<beforePause <<" "<< afterPause <<std::endl;} 
 						
 					}
 				}
-				if(doTroubleshooting){std::cout<<"stemeffect of growth pause: "<<dt <<std::endl;} 
+				if(doTroubleshooting){PM_cout<<"stemeffect of growth pause: "<<dt <<std::endl;} 
 			}
 			if(dt < 0){
-				std::cout<<dt<<" "<<org->getId()<<" "<<age<<" "<<ot<<" "<<org->getParameter("subType")<<" ";
-				std::cout<<orgLT<<" "<<org->getLength(true)<<" "<<Linit;
-				std::cout<<" "<<age_<<" "<<t<<" "<<dt<<std::endl;
+				PM_cout<<dt<<" "<<org->getId()<<" "<<age<<" "<<ot<<" "<<org->getParameter("subType")<<" ";
+				PM_cout<<orgLT<<" "<<org->getLength(true)<<" "<<Linit;
+				PM_cout<<" "<<age_<<" "<<t<<" "<<dt<<std::endl;
 				if(ot == CPlantBox::Organism::ot_stem){
-					std::cout<<"delay: "<<org->getParameter("delayNGStart")<<" "<< org->getParameter("delayNGEnd") <<std::endl;
+					PM_cout<<"delay: "<<org->getParameter("delayNGStart")<<" "<< org->getParameter("delayNGEnd") <<std::endl;
 				}
 				throw std::runtime_error("PhloemFlux::waterLimitedGrowth: dt <0");
 			}
@@ -866,10 +760,10 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 			double e = std::max(0.,targetlength-LinitTemp);// unimpeded elongation in time step dt
 			BackUpMaxGrowth[orgID2] = Linit + e;
 			std::vector<int> nodeIds_;// = org->getNodeIds();
-			if(doTroubleshooting){std::cout<<"rmax: "<<rmax<<" "<<1<<std::endl;} 
+			if(doTroubleshooting){PM_cout<<"rmax: "<<rmax<<" "<<1<<std::endl;} 
 			if((e + Linit)> org->getParameter("k") + 1e-10){
-				std::cout<<"Photosynthesis::rmaxSeg: target length too high "<<e<<" "<<dt<<" "<<Linit;
-				std::cout<<" "<<org->getParameter("k")<<" "<<org->getId()<<std::endl;
+				PM_cout<<"Photosynthesis::rmaxSeg: target length too high "<<e<<" "<<dt<<" "<<Linit;
+				PM_cout<<" "<<org->getParameter("k")<<" "<<org->getId()<<std::endl;
 				assert(false);
 			}
 			//delta_length to delta_vol
@@ -896,13 +790,13 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
                     }
                     
                     if(doTroubleshooting){
-                        std::cout<<"4growth areaLEAF "<<nn1<<" "<<nnEnd<<" "<< org->getNodeIds().size()<<std::endl;
-                        std::cout<<org->getLength(nnEnd) <<" "<< org->getLength(nn1)<<" "<<L_growth_area<<std::endl;
-                        std::cout<<"leafGrowthZone "<<leafGrowthZone<<std::endl;
-                        std::cout<<"nodeIds_.size() "<<nodeIds_.size()<<std::endl;
+                        PM_cout<<"4growth areaLEAF "<<nn1<<" "<<nnEnd<<" "<< org->getNodeIds().size()<<std::endl;
+                        PM_cout<<org->getLength(nnEnd) <<" "<< org->getLength(nn1)<<" "<<L_growth_area<<std::endl;
+                        PM_cout<<"leafGrowthZone "<<leafGrowthZone<<std::endl;
+                        PM_cout<<"nodeIds_.size() "<<nodeIds_.size()<<std::endl;
 
-                        for(int k=0;k< nodeIds_.size();k++){std::cout<<nodeIds_[k]<<" ";}
-                        std::cout<<std::endl;
+                        for(int k=0;k< nodeIds_.size();k++){PM_cout<<nodeIds_[k]<<" ";}
+                        PM_cout<<std::endl;
                     }
                 }
                 if(ot == 3)//only for nodes in the growing phytomeres
@@ -915,38 +809,38 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
                         auto stemParams = std::static_pointer_cast<CPlantBox::Stem>(org)->param();
                         int PhytoIdx = 0; bool foundPhytoIdx = false;
                        if(doTroubleshooting){
-                                 std::cout<<"let's search for phytoID" <<std::endl;
+                                 PM_cout<<"let's search for phytoID" <<std::endl;
                        }
                         for(;((PhytoIdx < stemParams->ln.size())&(!foundPhytoIdx));PhytoIdx++)
                         {
                             double maxPhytoLen = stemParams->ln.at(PhytoIdx);
                             double currentPhytoLen = org->getLength(org->getChild(PhytoIdx+1)->parentNI) - org->getLength(org->getChild(std::max(0,PhytoIdx))->parentNI);
                             if(doTroubleshooting){
-                                std::cout<<"at "<<PhytoIdx<<" phytomer lengths max" <<maxPhytoLen<<" current "<< currentPhytoLen <<" at kids "<< org->getLength(org->getChild(PhytoIdx+1)->parentNI)<<" "<< org->getLength(org->getChild(std::max(0,PhytoIdx))->parentNI) <<std::endl;
+                                PM_cout<<"at "<<PhytoIdx<<" phytomer lengths max" <<maxPhytoLen<<" current "<< currentPhytoLen <<" at kids "<< org->getLength(org->getChild(PhytoIdx+1)->parentNI)<<" "<< org->getLength(org->getChild(std::max(0,PhytoIdx))->parentNI) <<std::endl;
                             }
                             foundPhytoIdx = (maxPhytoLen - currentPhytoLen > 1e-10);//first still growing phytomere
                             if(doTroubleshooting){
-                                std::cout<<"(maxPhytoLen - currentPhytoLen > 1e-10) "<<(maxPhytoLen - currentPhytoLen < 1e-10)<<std::endl;
+                                PM_cout<<"(maxPhytoLen - currentPhytoLen > 1e-10) "<<(maxPhytoLen - currentPhytoLen < 1e-10)<<std::endl;
                             }
                             if(maxPhytoLen - currentPhytoLen < -1e-10){throw std::runtime_error("maxPhytoLen - currentPhytoLen < -1e10;");}
                             
                         }
                         nn1 = org->getChild(std::max(0,PhytoIdx-1))->parentNI;
                         if(doTroubleshooting){
-                                std::cout<<"retained phytoID "<<std::max(0,PhytoIdx-1) <<" "<< nn1<<std::endl;
+                                PM_cout<<"retained phytoID "<<std::max(0,PhytoIdx-1) <<" "<< nn1<<std::endl;
                             }
                         
                         auto allIDs = org->getNodeIds();
                         nodeIds_.insert(nodeIds_.end(), std::begin(allIDs)+ nn1 ,std::end(allIDs) ); 
                         if(doTroubleshooting){
-                            std::cout<<"stem parameters "<<org->getParameter("nodalGrowth")<<" "<< PhytoIdx <<std::endl;
-                            std::cout<<"phytomer lengths max" <<std::endl;
-                            for(int k=0;k< stemParams->ln.size();k++){std::cout<<stemParams->ln.at(k)<<" ";}std::cout<<std::endl;
-                            std::cout<<"phytomer lengths real" <<std::endl;
-                            for(int k=0;k< stemParams->ln.size();k++){std::cout<<org->getLength(org->getChild(k)->parentNI) - org->getLength(org->getChild(std::max(0,k))->parentNI)<<" ";}std::cout<<std::endl;
-                            std::cout<<"pnis" <<std::endl;
-                            for(int k=0;k< stemParams->ln.size();k++){std::cout<<org->getChild(k)->parentNI<<" ";}
-                            std::cout<<std::endl;
+                            PM_cout<<"stem parameters "<<org->getParameter("nodalGrowth")<<" "<< PhytoIdx <<std::endl;
+                            PM_cout<<"phytomer lengths max" <<std::endl;
+                            for(int k=0;k< stemParams->ln.size();k++){PM_cout<<stemParams->ln.at(k)<<" ";}PM_cout<<std::endl;
+                            PM_cout<<"phytomer lengths real" <<std::endl;
+                            for(int k=0;k< stemParams->ln.size();k++){PM_cout<<org->getLength(org->getChild(k)->parentNI) - org->getLength(org->getChild(std::max(0,k))->parentNI)<<" ";}PM_cout<<std::endl;
+                            PM_cout<<"pnis" <<std::endl;
+                            for(int k=0;k< stemParams->ln.size();k++){PM_cout<<org->getChild(k)->parentNI<<" ";}
+                            PM_cout<<std::endl;
                         }
                         
 
@@ -955,28 +849,28 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
                     }
                      if(doTroubleshooting){
                          
-                    std::cout<<"4growth areaSTEM "<<nn1<<" "<<nnEnd<<" "<< org->getNodeIds().size()<<std::endl;
-                    std::cout <<"lengthtot "<<org->getLength(nnEnd) <<" lengthAtlim "<< org->getLength(nn1)<<std::endl;
-                    std::cout<<" lengthAfterlim "<< org->getLength(std::min(nn1+1,nnEnd))<<" Length_th "<<Linit<<std::endl;
-                    std::cout<<"nodeIds_.size() "<<nodeIds_.size()<<std::endl;
+                    PM_cout<<"4growth areaSTEM "<<nn1<<" "<<nnEnd<<" "<< org->getNodeIds().size()<<std::endl;
+                    PM_cout <<"lengthtot "<<org->getLength(nnEnd) <<" lengthAtlim "<< org->getLength(nn1)<<std::endl;
+                    PM_cout<<" lengthAfterlim "<< org->getLength(std::min(nn1+1,nnEnd))<<" Length_th "<<Linit<<std::endl;
+                    PM_cout<<"nodeIds_.size() "<<nodeIds_.size()<<std::endl;
 
-                    for(int k=0;k< nodeIds_.size();k++){std::cout<<nodeIds_[k]<<" ";}
-                    std::cout<<"seg lengths "<<nodeIds_.size()<<std::endl;
+                    for(int k=0;k< nodeIds_.size();k++){PM_cout<<nodeIds_[k]<<" ";}
+                    PM_cout<<"seg lengths "<<nodeIds_.size()<<std::endl;
 
-                    for(int k=0;k< nodeIds_.size();k++){std::cout<<" ("<<org->getLength(k)<<"-"<<org->getLength(k) - org->getLength(std::max(0,k-1))<<"); ";}
-                    std::cout<<std::endl;
+                    for(int k=0;k< nodeIds_.size();k++){PM_cout<<" ("<<org->getLength(k)<<"-"<<org->getLength(k) - org->getLength(std::max(0,k-1))<<"); ";}
+                    PM_cout<<std::endl;
                 }
                 }
                 try{
                     L_growth_area = org->getLength(nnEnd) - org->getLength(nn1);
                 }catch(...){
-                    std::cout<<"error for L_growth_area = org->getLength(nnEnd) - org->getLength(nn1);"<<std::endl;
-                    std::cout<<nn1<<" "<<nnEnd<<" "<< org->getNodeIds().size()<<std::endl;
+                    PM_cout<<"error for L_growth_area = org->getLength(nnEnd) - org->getLength(nn1);"<<std::endl;
+                    PM_cout<<nn1<<" "<<nnEnd<<" "<< org->getNodeIds().size()<<std::endl;
                     throw std::runtime_error("error for L_growth_area = org->getLength(nnEnd) - org->getLength(nn1);");
                 }
                 if(doTroubleshooting){
-                std::cout<<"4growth area "<<nn1<<" "<<nnEnd<<" "<< org->getNodeIds().size()<<std::endl;
-                std::cout<<org->getLength(nnEnd) <<" "<< org->getLength(nn1)<<" "<<L_growth_area<<std::endl;
+                PM_cout<<"4growth area "<<nn1<<" "<<nnEnd<<" "<< org->getNodeIds().size()<<std::endl;
+                PM_cout<<org->getLength(nnEnd) <<" "<< org->getLength(nn1)<<" "<<L_growth_area<<std::endl;
                 }
             
             }
@@ -984,12 +878,12 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 			double deltaVol_tot = 0.;
 			
 			if(doTroubleshooting){
-				std::cout<<"Linit_realized"<<Linit_realized<<" "<<targetlength<<" "<<org->orgVolume(targetlength, false) ;
-				std::cout<<" "<< org->orgVolume(Linit, false)<<" "<<deltavol<<" "<<nNodes<<" "<<org->getEpsilon()<<std::endl;
-				std::cout<<"nodeIds_.size() "<<nodeIds_.size()<<std::endl;
+				PM_cout<<"Linit_realized"<<Linit_realized<<" "<<targetlength<<" "<<org->orgVolume(targetlength, false) ;
+				PM_cout<<" "<< org->orgVolume(Linit, false)<<" "<<deltavol<<" "<<nNodes<<" "<<org->getEpsilon()<<std::endl;
+				PM_cout<<"nodeIds_.size() "<<nodeIds_.size()<<std::endl;
 			
-				for(int k=0;k< nodeIds_.size();k++){std::cout<<nodeIds_[k]<<" ";}
-				std::cout<<std::endl;
+				for(int k=0;k< nodeIds_.size();k++){PM_cout<<nodeIds_[k]<<" ";}
+				PM_cout<<std::endl;
 			}
 			for(int k=1;k< nodeIds_.size();k++)//don't take  first node
 			{
@@ -1006,7 +900,7 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 				bool isRootTip = ((ot==2)&&(k==(nodeIds_.size()-1)));
 				if((nNodes==1)||isRootTip){Flen.at(nodeId) = 1.;
 					if(doTroubleshooting){
-						std::cout<<"		root or short organ "<<nodeId<<" "<<org->parentNI<<std::endl;
+						PM_cout<<"		root or short organ "<<nodeId<<" "<<org->parentNI<<std::endl;
 					}
 				}else{
 					
@@ -1018,13 +912,13 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
                     Lseg = nodej.minus(nodei).length();
 					Flen.at(nodeId) = (Lseg/L_growth_area) * double(ot != 2) ;
 					if(doTroubleshooting){
-						std::cout<<"		long stem or leaf "<<nodeId<<" "<<nodeId_h<<" "<<Lseg<<std::endl;
+						PM_cout<<"		long stem or leaf "<<nodeId<<" "<<nodeId_h<<" "<<Lseg<<std::endl;
 					}
 				}//att! for this division we need the realized length, not the theoretical one
 				
 				if(psiXyl.size()>0){
 					if(doTroubleshooting){
-						std::cout<<"do Fpdi "<<psiXyl.size()<<" "<<nodeId<<" "<<psiXyl.at(nodeId)<<" "<<psi_osmo_proto<<" "<<psiMin <<std::endl;
+						PM_cout<<"do Fpdi "<<psiXyl.size()<<" "<<nodeId<<" "<<psiXyl.at(nodeId)<<" "<<psi_osmo_proto<<" "<<psiMin <<std::endl;
 					}
 					psi_p_symplasm.at(nodeId) =  psiXyl.at(nodeId) - psi_osmo_proto;
                     if(-psi_osmo_proto - psiMin>1e-5){
@@ -1033,7 +927,7 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
                     //}
                     if(doTroubleshooting)
                     {
-                        std::cout<<"4Fpsi "<<psi_p_symplasm.at(nodeId)<<" "<<psi_osmo_proto<<Fpsi.at(nodeId)<<std::endl;
+                        PM_cout<<"4Fpsi "<<psi_p_symplasm.at(nodeId)<<" "<<psi_osmo_proto<<Fpsi.at(nodeId)<<std::endl;
                     }
 					if((Fpsi.at(nodeId) >(1+1e-6))||(Fpsi.at(nodeId) < -1e-6))
                     {
@@ -1048,11 +942,11 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 							&&(deltavolSeg == deltavolSeg)){
 						deltavolSeg=0.;	//within margin of error
 					}else{
-						std::cout<<org->getId()<<" t:"<<dt<<" ot:"<<ot<<" Li:"<<Linit<<" Le:"<<targetlength<<std::endl;
-						std::cout<<"		k "<<k<<" "<<" id:"<<nodeId<<" Flen:"<<Flen.at(nodeId) <<" Fpsi:"<< Fpsi.at(nodeId);
-						std::cout<<" Rtip:"<<isRootTip<<" Lseg:"<<Lseg<<" rorg"<<e<<" "<<deltavolSeg;
-						std::cout<<" "<<e<<" "<<(targetlength-Linit)<<std::endl;
-						std::cout<<"coucou"<<std::endl;
+						PM_cout<<org->getId()<<" t:"<<dt<<" ot:"<<ot<<" Li:"<<Linit<<" Le:"<<targetlength<<std::endl;
+						PM_cout<<"		k "<<k<<" "<<" id:"<<nodeId<<" Flen:"<<Flen.at(nodeId) <<" Fpsi:"<< Fpsi.at(nodeId);
+						PM_cout<<" Rtip:"<<isRootTip<<" Lseg:"<<Lseg<<" rorg"<<e<<" "<<deltavolSeg;
+						PM_cout<<" "<<e<<" "<<(targetlength-Linit)<<std::endl;
+						PM_cout<<"coucou"<<std::endl;
 						throw std::runtime_error("(deltavolSeg<0.)||(deltavolSeg != deltavolSeg)");
 					}
 					
@@ -1067,41 +961,41 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 				Flen_tot += Flen.at(nodeId);
 				deltaVol_tot += deltavolSeg;
 				if(doTroubleshooting){
-					std::cout<<"		k "<<k<<" "<<" id:"<<nodeId<<" idh:"<<nodeId_h<<" Flen:"<<Flen.at(nodeId) <<" Fpsi:"<< Fpsi.at(nodeId);
-					std::cout<<" Rtip:"<<isRootTip<<" Lseg:"<<Lseg<<" "<<deltavolSeg<<std::endl;
+					PM_cout<<"		k "<<k<<" "<<" id:"<<nodeId<<" idh:"<<nodeId_h<<" Flen:"<<Flen.at(nodeId) <<" Fpsi:"<< Fpsi.at(nodeId);
+					PM_cout<<" Rtip:"<<isRootTip<<" Lseg:"<<Lseg<<" "<<deltavolSeg<<std::endl;
 					
-						std::cout<<"		"<<org->getId()<<" ot:"<<ot<<" Li:"<<Linit<<" Le:"<<targetlength;
-						std::cout<<" rorg "<<e<<" "<<deltavol<<" "<<(targetlength-Linit)<<std::endl;
-						std::cout<<"		"<<org->getLength(true)<<" "<<org->getEpsilon()<<std::endl;
+						PM_cout<<"		"<<org->getId()<<" ot:"<<ot<<" Li:"<<Linit<<" Le:"<<targetlength;
+						PM_cout<<" rorg "<<e<<" "<<deltavol<<" "<<(targetlength-Linit)<<std::endl;
+						PM_cout<<"		"<<org->getLength(true)<<" "<<org->getEpsilon()<<std::endl;
 				}
 			}
 			if(doTroubleshooting){
-				std::cout<<"Flen_tot "<<Flen_tot<<" "<<(Flen_tot == 1.)<<std::endl;
-				std::cout<<"Flen_tot "<<( 1. - Flen_tot )<<std::endl;
-				// std::cout<<"Flen_tot "<<(Flen_tot < 1.)<<" "<<(Flen_tot > 1.)<<std::endl;
-				// std::cout<<"Flen_tot "<<(Flen_tot <= 1.)<<" "<<(Flen_tot >= 1.)<<std::endl;
+				PM_cout<<"Flen_tot "<<Flen_tot<<" "<<(Flen_tot == 1.)<<std::endl;
+				PM_cout<<"Flen_tot "<<( 1. - Flen_tot )<<std::endl;
+				// PM_cout<<"Flen_tot "<<(Flen_tot < 1.)<<" "<<(Flen_tot > 1.)<<std::endl;
+				// PM_cout<<"Flen_tot "<<(Flen_tot <= 1.)<<" "<<(Flen_tot >= 1.)<<std::endl;
 			}
 			if((std::abs(Flen_tot - 1.)>1e-10)||(std::abs(Flen_tot - 1.)<-1e-10))
             {
-				std::cout<<"Flen_tot "<<Flen_tot<<" "<<(Flen_tot == 1.)<<std::endl;
-				std::cout<<"Flen_tot "<<( 1. - Flen_tot )<<std::endl;
+				PM_cout<<"Flen_tot "<<Flen_tot<<" "<<(Flen_tot == 1.)<<std::endl;
+				PM_cout<<"Flen_tot "<<( 1. - Flen_tot )<<std::endl;
                 throw std::runtime_error("(Flen_tot != 1.)&&wrong tot Flen");
             }
 			if(doTroubleshooting){
-				std::cout<<"vol_tot "<<deltaVol_tot<<" "<<deltavol<<" "<<(deltaVol_tot -deltavol)<<std::endl;
+				PM_cout<<"vol_tot "<<deltaVol_tot<<" "<<deltavol<<" "<<(deltaVol_tot -deltavol)<<std::endl;
 			}
 			assert(((deltaVol_tot -deltavol)<1e-10)&&"deltavol_tot too high");//deltaVol_tot <=deltavol
 		}else{
 			BackUpMaxGrowth[orgID2] =org->getLength(false);
 			if(doTroubleshooting){
-				std::cout<<"skip organ "<<org->getId()<<" "<<orgID2<<" "<<org->getAge();
-				std::cout<<" "<<org->isAlive()<<" "<<org->isActive()<<" "<<org->getNumberOfNodes()<<std::endl;
+				PM_cout<<"skip organ "<<org->getId()<<" "<<orgID2<<" "<<org->getAge();
+				PM_cout<<" "<<org->isAlive()<<" "<<org->isActive()<<" "<<org->getNumberOfNodes()<<std::endl;
 			}
 		}
 		orgID2 += 1;
 	}
 		
-	if(doTroubleshooting){std::cout<<"PhloemFlux::waterLimitedGrowth_end"<<std::endl;}
+	if(doTroubleshooting){PM_cout<<"PhloemFlux::waterLimitedGrowth_end"<<std::endl;}
 	
     for (int u = 0; u< deltaSucOrgNode.size();u++) {
 		double totSucNeed1 = 0;
@@ -1114,7 +1008,7 @@ std::vector<std::map<int,double>> PhloemFlux::waterLimitedGrowth(double t)
 		if((std::abs(totSucNeed1 - totSucNeed2)>1e-10))
 		{
 			for (auto const &pair: deltaSucOrgNode.at(u)) {
-				std::cout << "{" << pair.first << ": " << pair.second << "}\n";
+				PM_cout << "{" << pair.first << ": " << pair.second << "}\n";
 			}
 			throw runtime_error("PhloemFlux::waterLimitedGrowth: wrong values in deltaSucOrgNode map");
 		}
@@ -1139,7 +1033,7 @@ void PhloemFlux::setKr_st(std::vector<std::vector<double>> values, double kr_len
 			kr_st_f = std::bind(&PhloemFlux::kr_st_const, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
             if (verbose)
             {
-                std::cout << "Kr_st is constant " << values[0][0] << " 1 day-1 \n";
+                PM_cout << "Kr_st is constant " << values[0][0] << " 1 day-1 \n";
             }
 		} 
 	} else {
@@ -1147,17 +1041,17 @@ void PhloemFlux::setKr_st(std::vector<std::vector<double>> values, double kr_len
 			kr_st_f = std::bind(&PhloemFlux::kr_st_perOrgType, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
 			if (verbose)
             {
-                std::cout << "Kr_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " 1 day-1 \n";
+                PM_cout << "Kr_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " 1 day-1 \n";
             }
 		} else {
 			if (verbose)
             {
-                std::cout << "Exchange zone in roots: kr_st > 0 until "<< kr_length_<<"cm from root tip "<<(kr_length_ > 0)<<" "<<(kr_length_ > 0.)<<std::endl;
+                PM_cout << "Exchange zone in roots: kr_st > 0 until "<< kr_length_<<"cm from root tip "<<(kr_length_ > 0)<<" "<<(kr_length_ > 0.)<<std::endl;
             }
 			if(kr_length_ > 0.){
 				if (verbose)
             {
-                std::cout << "Exchange zone in roots: kr > 0 until "<< kr_length_<<"cm from root tip"<<std::endl;
+                PM_cout << "Exchange zone in roots: kr > 0 until "<< kr_length_<<"cm from root tip"<<std::endl;
                 }
 				plant->kr_length = kr_length_; //in MappedPlant. define distance to root tipe where kr > 0 as cannot compute distance from age in case of carbon-limited growth
 				plant->calcExchangeZoneCoefs();	
@@ -1167,7 +1061,7 @@ void PhloemFlux::setKr_st(std::vector<std::vector<double>> values, double kr_len
 			}
 			if (verbose)
             {
-                std::cout << "Kr_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " 1 day-1 \n";
+                PM_cout << "Kr_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " 1 day-1 \n";
             }
 		}
 	}
@@ -1181,7 +1075,7 @@ void PhloemFlux::setKx_st(std::vector<std::vector<double>> values, bool verbose)
 			kx_st_f = std::bind(&PhloemFlux::kx_st_const, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Kx_st is constant " << values[0][0] << " cm3 day-1 \n";
+                PM_cout << "Kx_st is constant " << values[0][0] << " cm3 day-1 \n";
             }
 		} 
 	} else {
@@ -1189,13 +1083,13 @@ void PhloemFlux::setKx_st(std::vector<std::vector<double>> values, bool verbose)
 			kx_st_f = std::bind(&PhloemFlux::kx_st_perOrgType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Kx_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " cm3 day-1 \n";
+                PM_cout << "Kx_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " cm3 day-1 \n";
             }
 		} else {
 			kx_st_f  = std::bind(&PhloemFlux::kx_st_perType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Kx_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " cm3 day-1 \n";
+                PM_cout << "Kx_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " cm3 day-1 \n";
             }
 		}
 	}
@@ -1210,7 +1104,7 @@ void PhloemFlux::setAcross_st(std::vector<std::vector<double>> values, bool verb
 			Across_st_f = std::bind(&PhloemFlux::Across_st_const, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Across_st is constant " << values[0][0] << " cm2\n";
+                PM_cout << "Across_st is constant " << values[0][0] << " cm2\n";
             }
 		} 
 	} else {
@@ -1218,13 +1112,13 @@ void PhloemFlux::setAcross_st(std::vector<std::vector<double>> values, bool verb
 			Across_st_f = std::bind(&PhloemFlux::Across_st_perOrgType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Across_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " cm2 \n";
+                PM_cout << "Across_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " cm2 \n";
             }
 		} else {
 			Across_st_f  = std::bind(&PhloemFlux::Across_st_perType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Across_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " cm2 \n";
+                PM_cout << "Across_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " cm2 \n";
             }
 		}
 	}
@@ -1239,7 +1133,7 @@ void PhloemFlux::setPerimeter_st(std::vector<std::vector<double>> values, bool v
 			Perimeter_st_f = std::bind(&PhloemFlux::Perimeter_st_const, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Perimeter_st is constant " << values[0][0] << " cm\n";
+                PM_cout << "Perimeter_st is constant " << values[0][0] << " cm\n";
             }
 		} 
 	} else {
@@ -1247,13 +1141,13 @@ void PhloemFlux::setPerimeter_st(std::vector<std::vector<double>> values, bool v
 			Perimeter_st_f = std::bind(&PhloemFlux::Perimeter_st_perOrgType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Perimeter_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " cm\n";
+                PM_cout << "Perimeter_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " cm\n";
             }
 		} else {
 			Perimeter_st_f  = std::bind(&PhloemFlux::Perimeter_st_perType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Perimeter_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " cm\n";
+                PM_cout << "Perimeter_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " cm\n";
             }
 		}
 	}
@@ -1267,7 +1161,7 @@ void PhloemFlux::setRmax_st(std::vector<std::vector<double>> values, bool verbos
 			Rmax_st_f = std::bind(&PhloemFlux::Rmax_st_const, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Rmax_st is constant " << values[0][0] << " cm day-1 \n";
+                PM_cout << "Rmax_st is constant " << values[0][0] << " cm day-1 \n";
             }
 		} 
 	} else {
@@ -1275,13 +1169,13 @@ void PhloemFlux::setRmax_st(std::vector<std::vector<double>> values, bool verbos
 			Rmax_st_f = std::bind(&PhloemFlux::Rmax_st_perOrgType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Rmax_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " cm day-1 \n";
+                PM_cout << "Rmax_st is constant per organ type, organ type 2 (root) = " << values[0][0] << " cm day-1 \n";
             }
 		} else {
 			Rmax_st_f  = std::bind(&PhloemFlux::Rmax_st_perType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "Rmax_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " cm day-1 \n";
+                PM_cout << "Rmax_st is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " cm day-1 \n";
             }
 		}
 	}
@@ -1296,7 +1190,7 @@ void PhloemFlux::setRhoSucrose(std::vector<std::vector<double>> values, bool ver
 			rhoSucrose_f = std::bind(&PhloemFlux::rhoSucrose_const, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "rhoSucrose is constant " << values[0][0] << " mmol cm-3\n";
+                PM_cout << "rhoSucrose is constant " << values[0][0] << " mmol cm-3\n";
             }
 		} 
 	} else {
@@ -1304,12 +1198,12 @@ void PhloemFlux::setRhoSucrose(std::vector<std::vector<double>> values, bool ver
 			rhoSucrose_f = std::bind(&PhloemFlux::rhoSucrose_perOrgType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "rhoSucrose is constant per organ type, organ type 2 (root) = " << values[0][0] << " mmol cm-3\n";}
+                PM_cout << "rhoSucrose is constant per organ type, organ type 2 (root) = " << values[0][0] << " mmol cm-3\n";}
 		} else {
 			rhoSucrose_f  = std::bind(&PhloemFlux::rhoSucrose_perType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "rhoSucrose is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " mmol cm-3\n";}
+                PM_cout << "rhoSucrose is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << " mmol cm-3\n";}
 		}
 	}
 }	
@@ -1323,7 +1217,7 @@ void PhloemFlux::setKrm1(std::vector<std::vector<double>> values, bool verbose)
 			krm1_f = std::bind(&PhloemFlux::krm1_const, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "krm1 is constant " << values[0][0] << " -\n";
+                PM_cout << "krm1 is constant " << values[0][0] << " -\n";
             }
 		} 
 	} else {
@@ -1331,13 +1225,13 @@ void PhloemFlux::setKrm1(std::vector<std::vector<double>> values, bool verbose)
 			krm1_f = std::bind(&PhloemFlux::krm1_perOrgType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "krm1 is constant per organ type, organ type 2 (root) = " << values[0][0] << " -\n";
+                PM_cout << "krm1 is constant per organ type, organ type 2 (root) = " << values[0][0] << " -\n";
             }
 		} else {
 			krm1_f  = std::bind(&PhloemFlux::krm1_perType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "krm1 is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << "-\n";
+                PM_cout << "krm1 is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << "-\n";
             }
 		}
 	}
@@ -1351,18 +1245,18 @@ void PhloemFlux::setKrm2(std::vector<std::vector<double>> values, bool verbose)
 			krm2_f = std::bind(&PhloemFlux::krm2_const, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "krm2 is constant " << values[0][0] << " -\n";
+                PM_cout << "krm2 is constant " << values[0][0] << " -\n";
             }
 		} 
 	} else {
 		if (values[0].size()==1) {
 			krm2_f = std::bind(&PhloemFlux::krm2_perOrgType, this, std::placeholders::_1, std::placeholders::_2);
-			std::cout << "krm2 is constant per organ type, organ type 2 (root) = " << values[0][0] << " -\n";
+			PM_cout << "krm2 is constant per organ type, organ type 2 (root) = " << values[0][0] << " -\n";
 		} else {
 			krm2_f  = std::bind(&PhloemFlux::krm2_perType, this, std::placeholders::_1, std::placeholders::_2);
 			if (verbose)
             {
-                std::cout << "krm2 is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << "-\n";
+                PM_cout << "krm2 is constant per subtype of organ type, for root, subtype 1 = " << values[0].at(1) << "-\n";
             }
 		}
 	}
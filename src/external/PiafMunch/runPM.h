@@ -46,6 +46,7 @@
 
 #include <stdio.h>
 #include "PM_arrays.h"
+#include "PiafMunchContext.h"
 
 #include <sundials/sundials_types.h>    /* defs. of realtype, sunindextype      */
 #include <sundials/sundials_math.h>
@@ -81,7 +82,6 @@
 //take those functions out
 extern int Jac_(realtype t, N_Vector y, N_Vector fy, SUNMatrix J, void *user_data, N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
 void TimeSegmentConfig() ; // User-editable (implemented in 'PiafMunch2.cpp')
-void OutputSettings() ;
 void BreakpointSharpParameterChanges(int s, double t) ; // User-editable (implemented in 'PiafMunch2.cpp') ; s = # of integration segment (first = 1) ; t = time
 void aux(double t, double * y) ;	
 
@@ -93,12 +93,15 @@ void aux(double t, double * y) ;
  * Units are [hPa] and [day]
  * CplantBox object making link with PiafMunh
  * Wraps a Photosynthesis class
+ *
+ * Each PhloemFlux owns its PiafMunch solver state (see PiafMunchContext), only the CVODE memory, the sparse matrix scratch,
+ * and the log stream PM_cout are thread_local, i.e. PhloemFlux objects can run startPM concurrently, each in its own thread
  */
-class PhloemFlux: public CPlantBox::Photosynthesis, public std::enable_shared_from_this<PhloemFlux>
+class PhloemFlux: public CPlantBox::Photosynthesis, public PiafMunchContext, public std::enable_shared_from_this<PhloemFlux>
 {
 	public:
 	PhloemFlux(std::shared_ptr<CPlantBox::MappedPlant> plant_, double psiXylInit = -500., double ciInit = 350e-6): 
-		CPlantBox::Photosynthesis(plant_, psiXylInit, ciInit){};
+		CPlantBox::Photosynthesis(plant_, psiXylInit, ciInit), PiafMunchContext() {};
     std::weak_ptr<PhloemFlux> Phloem() { return shared_from_this(); }; // up-cast for Python binding
 	virtual ~PhloemFlux() { }
 	int startPM(double StartTime ,double EndTime, int OutputStep,double TairK, bool verbose = true , 
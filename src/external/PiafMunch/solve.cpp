@@ -28,61 +28,12 @@
 #include "PM_arrays.h"
 #include "runPM.h"
 
-/**********************************************  Network Architecture: *********************************************/
+const double _0089_099803 = 0.089/0.99803 ; // intermediaire de celcul de la molalite
 
-//extern Fortran_vector Q_FuFl_seg;
-//extern Fortran_vector Q_FuFl_node;
-Fortran_vector Q_ST_seg_init;
-
-extern Fortran_vector  Q_Exud_seg, Q_Gr_seg, Q_Rm_seg, Q_Fl_seg;
-extern Fortran_vector C_ST_seg, Q_ST_seg, Q_ST_seg_new, Q_ST_newFuFl, grad_Q_ST_seg;
-extern Fortran_vector vol_ST_seg, Length;
-vector<int> Deg ;
-int Nt, Nc ; // Nt = Total number of nodes, Nc = total number of connections in network.
-int N1R ; // Number of  'root tip's, i.e. nodes of conn.order 1 that have imposed soil water potential as a limit condition.
-extern int N1L ; // Organ type # 1L : 'leaf end' ; has imposed transpiration stream as a limit condition
-extern Index_vector i_[] ; // i_[o = 0..8][k = 1..No] = id# of kth node in (1-based list)  list of all nodes of conn.ord. co(o). For o=0: No=N1L ; o=1: No=N1R ; o=2..8: No=N[o] :
-extern Index_vector &RootEnds, &LeafEnds ; // (= i_[1] and i_[0], resp.) : label which nodes are network ends = nodes of co=1 , which are either 'leaf' or 'root' ends :
-vector<int> jf_RootEnds ; // indices to label end nodes = those of conn.order 1
-extern vector<int> I_Upflow, I_Downflow ; // I_Upflow(resp.I_Downflow)[jf=1..Nc] = id# du noeud amont (resp. aval) : jf = JF(i,i2) > 0 si I_Upflow[(abs(jf)]==i, i.e. si I_Downflow[(abs(jf)]==i2
-SpUnit_matrix Delta2 ; // describe hydraulic architecture (topology)
-SpUnit_matrix Delta2abs ; // describe hydraulic architecture (topology)
-Sparse_matrix Deltaabs ; // describe hydraulic architecture (topology)
-Sparse_matrix Delta2W;
-Sparse_matrix X ;	// intermediaires de calcul ;
-int** ipiv_ptr ; void**TM_ptr ; // id. -- initialise dans inialize_hydric()
-#ifdef Full_Matrix // solve full linear system for all hydraulic variables, chained as YY below :
-Fortran_vector YY, SM ; // resp., inconnue et second membre de l'eq. matricielle
-#else // reduce linear system to only one unknown hydraulic variable (P_ST) => significant speed up and reduce required memory -- needs pre-solving recalculation if local model is changed
-SpUnit_matrix Delta ; // =  - Transpose(Delta2) : describe hydraulic architecture (topology)
-Sparse_matrix M1, Delta_rxyl, Delta_rphl ;	// intermediaires de calcul ;
-Fortran_vector Km, rG, O ; //  intermediaires de calcul (Km : rien a voir avec Michaelis !)
-Fortran_vector inv_Km, rs_rG, inv_rPhlM, inv_rG ; //  intermediaires de calcul, derives ou inverses des precedents
-# endif
-double C, _0089_099803 = 0.089/0.99803 ; // intermediaire de celcul de la molalite
-extern int jf, i ; int is ; // is = # of current integration time segment (first = 1)
-
-/******************************************  Environmental Variables: *********************************************/
-extern double T ; // (K) absolute temperature : set in GUI, but may be updated anytime in function 'parameter_and_boundary_conditions()' at the end of file 'PiafMunch2.cpp'.
-// The following 2 environment data are set by the user in function  'parameter_and_boundary_conditions()'  at the end of file 'PiafMunch2.cpp' :
-extern Fortran_vector Transpirat		; // Leaf transpiration rate (used in water-fluxes calc.)				(mmol / h)
-extern Fortran_vector PsiSoil			; // Soil water potential at root end (used in water-fluxes calc.)		(MPa)
 
 /******************************************  Constants and Parameters: *********************************************/
 #define R 83.14//0.0083143	// constante des gaz parfaits -											(MPa ml K-1 mmol-1)
-double TdC, dEauPure,  siPhi, newPhi ; // pour visc. calc. par  www.seas.upenn.edu et/ou NonLinPsi
-bool Adv_BioPhysics ; // true if  non-zero sugar specific volume, osmotic pot.=non-linear function of molality (Thompson and Holbrook), and viscosity changes with C_TC (Thompson and Holbrook ; Seas, Flanagan)  ; set in IntroDialogBox
 
-// Hydro Resistance Parameters (set in GUI) :
-Fortran_vector r_Xyl			; //(MPa h / ml) : xylem water resistance
-Fortran_vector r_ST			; // (MPa h / ml) : axial phloem water resistance
-Fortran_vector r_ST_ref 	; // r_ST_ ref. values for C_TC =  0.5 mmol / ml sap solution
-Fortran_vector r_abs			; // soil - root  water resistances (may be changed by user)			(MPa h / ml)
-Fortran_vector r_Trsv			; // Transverse xylem to phloem apoplasm water resistance										(MPa h / ml)
-Fortran_vector r_PhlMb		; // Transmembrane Phloem (ST,CC) Apoplasm to Symplasm water resistance		(MPa h / ml)
-Fortran_vector r_ParMb		; // Transmembrane Parenchyma Apoplasm to Symplasm water resistance		(MPa h / ml)
-Fortran_vector r_Apo			;//  Lateral parenchyma to phloem Apoplastic (MPa h / ml)
-Fortran_vector r_Sympl			; // Lateral parenchyma to phloem ST Symplasmic water resistance (MPa h / ml)
 
 // constants to express hydro resistance changes :
 #define NONE 0
@@ -95,64 +46,14 @@ Fortran_vector r_Sympl			; // Lateral parenchyma to phloem ST Symplasmic water r
 #define PARMB 64
 #define RABS 128
 
-int resistance_changed = NONE ; // = NONE a priori
-void UpdateResistances(double t) ; // in  initialize.cpp
 void Smooth_Parameter_and_BoundaryConditions_Changes(int s, double t) ; // User-editable (implemented in 'PiafMunch2.cpp') ; s = # of integration segment
 //void C_fluxes(double t, int Nt) ; // in  PiafMunch2.cpp
 void vector_init(double t, double *y, double *y_dot);
 
-// ******************  mere C-fluxes related variables or parameters ********** :
-extern double *Q_ST, *Q_Mesophyll, *Q_RespMaint, *Q_Exudation, *Q_Growthtot, *Q_S_ST, *Q_Mucil ;		  // components of vector y as used in diff. system f()...
-extern double *Q_ST_dot, *Q_Mesophyll_dot, *Q_Rm_dot, *Q_Exud_dot, *Q_Gtot_dot, *Q_S_ST_dot, *Q_Mucil_dot ; //... and its derivatives.  ;
-extern double *vol_Sympl ;
-extern Fortran_vector JS_ST, C_amont, JS_Sympl, JS_Apo, RespMaint ;
-extern Fortran_vector vol_ST, vol_PhlApo, vol_ParApo ;
-extern Fortran_vector r_abs, PsiSoil, Transpirat, Input, Q_RespMaintSyn ;
-extern Fortran_vector P_ST_dot, P_Sympl_dot ; /******* variation rate of any variable X is noted: X_dot = dX/dt *******/
-//Index_vector i_amont					; // i_amont[i] =Id# of  *true*  upflow node
-Fortran_vector i_amont					;
-extern Fortran_vector C_SymplUpflow, C_ApoUpflow ; // to derive JS_Sympl, and maybe JS_Apo, from resp. water fluxes JW_xxx
-
-// ******************  auxiliary sugar- or anatomy- related, non-hydraulic variables or parameters that may be involved in water-system equations ********** :
-extern Fortran_vector C_ST, C_PhlApo		; // Concentration of sugar in phloem  sieve tubes  and  apoplasm, resp.							(mmol / ml)   (ml of solution)
-extern Fortran_vector  JS_PhlMb, JS_ParMb ; //  (if Adv_BioPhysics)  to compute NZS and NZSP (see next line)
-// NZS : optional non-zero volume sugar flow (not a distinct variable)   (ml / h) : NZS = JS_PhlMb * PartMolalVol (=0.2155 in Thompson and Holbrook -- 0.214 might be more accurate)
-extern Fortran_vector C_Sympl, C_ParApo		; // Concentration of sugar in lateral tissue symplasm  and  apoplasm, resp.								(mmol / ml)   (ml of solution)
-extern Fortran_vector Delta_JS_ST ; // sera la composante purement phloemienne de Q_TC_dot[ ]							(mmol / h)
-
-// tracer-specific add-ins :
-extern double *Q_RespMaintmax, *TracerQ_Mesophyll, *TracerQ_RespMaint, *Q_S_Mesophyll, *Q_Growthtotmax ;		  // components of vector y as used in diff. system f()...
-extern double *Q_Rmmax_dot, *TracerQ_Mesophyll_dot, *TracerQ_Rm_dot, *Q_S_Mesophyll_dot, *Q_Gtotmax_dot ; //... and its derivatives.  ;
-extern Fortran_vector TracerJS_ST, TracerC_Sympl, TracerC_ST, TracerJS_Sympl, TracerJS_Apo, TracerJS_ParMb, TracerJS_PhlMb, TracerC_PhlApo, TracerC_ParApo ;
-extern Fortran_vector TracerQ_RespMaintSyn, TracerInput, TracerRespMaint, TracerC_SymplUpflow, TracerC_ApoUpflow ;
-extern Fortran_vector TracerRatioSympl, TracerRatioQ_RespMaint ;
-extern Fortran_vector Delta_TracerJS_ST ; // sera la composante purement phloemienne de Q_TC_dot[ ]							(mmol / h)
-
-/*************************** VARIABLES INVOLVED IN HYDRIC SYSTEM (Water fluxes): ******************************* */
-extern double* vol_Sympl_dot ; // Rate of symplasmic vol. change (eq. 8)
-Fortran_vector P_Xyl		    	; // Xylem Pressure (= water potential since there is no solute in this version)					(MPa)
-Fortran_vector Psi_Xyl		    	; // Xylem Pressure (= water potential since there is no solute in this version)					(MPa)
-Fortran_vector Psi_ST	 		; // Phloem sieve-tube (+CC) water potential												(MPa)
-Fortran_vector Psi_PhlApo		; // Phloem Apoplam water potential												(MPa)
-Fortran_vector Psi_ParApo		; // Lateral parenchyma apoplasmic water potential												(MPa)
-Fortran_vector P_PhlApo		; // Phloem Apoplam pressure												(MPa)
-Fortran_vector P_ParApo		; // Lateral parenchyma apoplasmic pressure												(MPa)
-Fortran_vector Psi_Sympl		; // Lateral parenchyma symplasmic water potential												(MPa)
-Fortran_vector P_ST			; // Phloem sieve-tube (+CC) turgor pressure 								(MPa)
-Fortran_vector P_Sympl		; // Lateral parenchyma symplasmic turgor pressure 								(MPa)
-Fortran_vector Absorb			; // Root end water absorbtion flux										(ml / h)
-Fortran_vector JW_Xyl			; // Axial xylem water flux
-Fortran_vector JW_ST			; // Axial phloem sieve-tube liquid flux
-Fortran_vector JW_Trsv			; // Transverse xylem to phloem apoplasm water flux									(ml / h)
-Fortran_vector JW_PhlMb		; // Transmembrane Phloem (ST,CC) Apoplasm to Symplasm water flux
-Fortran_vector JW_ParMb		; // Transmembrane Parenchyma Apoplasm to Symplasm water flux
-Fortran_vector JW_Apo			; // Lateral parenchyma to phloem Apoplastic water flux									(ml / h)
-Fortran_vector JW_Sympl		; // Lateral parenchyma to phloem ST Symplasmic liquid flux									(ml / h)
 
 /********************* WATER SYSTEM EQUATIONS  ***************************/
 
 
-double  PartMolalVol =0;
 //comes from Genotelle, J. Expression de la viscosite des solutions sucrees. Ind. Aliment. Agric. 1978, 95, 747-755
 //prooved to hold by https://doi.org/10.1021/ie000266e
 //taken here as presented in "Sucrose Properties and Applications" for pure sucrose solution
@@ -160,8 +61,7 @@ double  PartMolalVol =0;
 //Mathlouthi, M.; Reiser, P., 1995
 //eq. 6.29
 void PhloemFlux::update_viscosity() { // called if (Adv_BioPhysics)
-	static double T_old(-9999.);//V_ref(-9999.) ; // memory of previous T (do not compute dEauPure, siPhi, etc. if T unchanged), and V_ref
-	double d, siEnne,  mu ; 
+	double C, d, siEnne,  mu ; 
 	if (T_old != TairK_phloem) {
 		TdC = TairK_phloem - 273.15;
 		//in g/L or mg/cm3
@@ -191,7 +91,7 @@ double R_ = 83.14;//cm^3 hPa K-1 mmol-1
 void PhloemFlux::f(double t, double *y, double *y_dot) { // the function to be processed by the solver
 	
 	double RT = R_*TairK_phloem ; // int k ; T may be changed anytime, in function 'parameter_and_boundary_conditions(t)  in PiafMunch2.cpp
-	static Fortran_vector dummy(Nt);
+	Fortran_vector& dummy = dummy_f ; if (dummy.size() != Nt) dummy = Fortran_vector(Nt) ;
 	Q_ST = y ;							// note: zero_indices  Q_ST[0],..., Q_RespMaint[0]... are ignored
 	Q_Mesophyll = Q_ST + Nt ; 
 	Q_RespMaint = Q_Mesophyll + Nt ; 
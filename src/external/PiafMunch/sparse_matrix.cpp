@@ -48,24 +48,24 @@ void Sparse_XXX_set_ij_uncount(int * ij_) ;
 int SpUnit_matmult_set_nnz_(int * ij1, int * ij2, const int &m, const int &n, const int &p, const int & nnz1, const int & nnz2, int* v) ;
 void SpUnit_matmult_fill_ij_(int* ij, int*ij1, int* ij2, const int &m, const int &n, const int &p, const int &nnz, const int& nnz1, const int& nnz2, int* v);
 
-double r ;
+thread_local double r ;
 
-int Sparse_add_set_ij_count = 0 ;
-int ** Sparse_add_set_ij_ = NULL ;
-int Sparse_add_set_ij_max = 100 ;
+thread_local int Sparse_add_set_ij_count = 0 ;
+thread_local int ** Sparse_add_set_ij_ = NULL ;
+thread_local int Sparse_add_set_ij_max = 100 ;
 
-int Sparse_elemult_set_ij_count = 0 ;
-int ** Sparse_elemult_set_ij_ = NULL ;
-int Sparse_elemult_set_ij_max = 100 ;
+thread_local int Sparse_elemult_set_ij_count = 0 ;
+thread_local int ** Sparse_elemult_set_ij_ = NULL ;
+thread_local int Sparse_elemult_set_ij_max = 100 ;
 
-int Sparse_matmult_set_ij_count = 0 ;
-int ** Sparse_matmult_set_ij_ = NULL ;
-int Sparse_matmult_set_ij_max = 100 ;
+thread_local int Sparse_matmult_set_ij_count = 0 ;
+thread_local int ** Sparse_matmult_set_ij_ = NULL ;
+thread_local int Sparse_matmult_set_ij_max = 100 ;
 
-int Sparse_addsubdiag_set_ij_count = 0 ;
-int ** Sparse_addsubdiag_set_ij_ = NULL ;
-int * Sparse_addsubdiag_i_set_ij_ = NULL ;
-int Sparse_addsubdiag_set_ij_max = 100;
+thread_local int Sparse_addsubdiag_set_ij_count = 0 ;
+thread_local int ** Sparse_addsubdiag_set_ij_ = NULL ;
+thread_local int * Sparse_addsubdiag_i_set_ij_ = NULL ;
+thread_local int Sparse_addsubdiag_set_ij_max = 100;
 
 
 Sparse_matrix::Sparse_matrix(): m_(0), n_(0), ntnz_(0), npnz_(0), ij_(NULL), v_(NULL) { // constructeur par defaut, ne cree pas les arrays ij_ et v_
@@ -3486,3 +3486,11 @@ void Sparse_matrix::check_addsubdiag_set_ij_(const int & i1, const int & i2) {
 			{ _LogMessage("ATTENTION : Sparse_addsubdiag_set_ij_count > 100 !!!") ; assert(false) ; }
 	}
 }
+
+void Sparse_registers_clear() { // a appeler en fin de calcul : les matrices enregistrees peuvent etre detruites dans un autre thread
+	delete[ ] Sparse_add_set_ij_ ; Sparse_add_set_ij_ = NULL ; Sparse_add_set_ij_count = 0 ;
+	delete[ ] Sparse_elemult_set_ij_ ; Sparse_elemult_set_ij_ = NULL ; Sparse_elemult_set_ij_count = 0 ;
+	delete[ ] Sparse_matmult_set_ij_ ; Sparse_matmult_set_ij_ = NULL ; Sparse_matmult_set_ij_count = 0 ;
+	delete[ ] Sparse_addsubdiag_set_ij_ ; Sparse_addsubdiag_set_ij_ = NULL ;
+	delete[ ] Sparse_addsubdiag_i_set_ij_ ; Sparse_addsubdiag_i_set_ij_ = NULL ; Sparse_addsubdiag_set_ij_count = 0 ;
+}
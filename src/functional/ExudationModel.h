@@ -5,6 +5,7 @@
 #include "soil.h"
 #include "sdf_rs.h"
 #include "RootSystem.h"
+#include "parallel.h"
 
 #include <functional>
 
@@ -38,6 +39,34 @@ public:
     double thresh13 = 1.e-15; // threshold for Eqn 13
     bool calc13 = true; // turns Eqn 13 on and off
     double observationRadius = 5; //  limits computational domain around roots [cm]
+    int threads = 0; // number of threads used by calculate (0 or 1 = serial)
+
+    /**
+     * Per root data, passed to the integrands of Eqn 11 and 13.
+     * Is collected before the grid points are distributed over the threads, which then only read it.
+     */
+    struct RootData {
+        std::shared_ptr<Root> r = nullptr; // current root
+        double age = 0;
+        int n = 0; // number of integration points
+        Vector3d tip = Vector3d(); // for mps_straight
+        Vector3d v = Vector3d(); // for mps_straight
+        double st = 0; // stop time (eqn 13)
+        std::vector<Vector3d> nodes; // for mps and mls
+        std::vector<double> nodeCTs; // for mps and mls
+        const GrowthFunction* gf = nullptr; // for mls
+        double gr = 0; // initial growth rate, for mls
+        double gk = 0; // maximal root length, for mls
+    };
+
+    /**
+     * Everything the integrands need, the integrands have no other state
+     */
+    struct IntegrandData {
+        const ExudationModel* model;
+        const RootData* root;
+        Vector3d x; // integration point
+    };
 
     /**
      * Constructors
@@ -76,6 +105,10 @@ public:
 
     /**
      * For each root for each grid point
+     *
+     * The grid points are distributed over ExudationModel::threads threads. Each grid point is owned by a single thread,
+     * and the roots are added in the same order, i.e. the result does not depend on the number of threads.
+     *
      * @param tend      final simulation time
      * @param i0        optionally, initial root index (default = 0)
      * @param iend      optionally, final root index (default = roots.size())
@@ -95,69 +128,73 @@ public:
 
             //
             // per root (passed to integrands)
-            r_ = roots[ri]; // eq 11
-            age_ = std::min(r_->getNodeCT(r_->getNumberOfNodes()-1),tend) - r_->getNodeCT(0);
+            RootData rd;
+            rd.r = roots[ri]; // eq 11
+            rd.age = std::min(rd.r->getNodeCT(rd.r->getNumberOfNodes()-1),tend) - rd.r->getNodeCT(0);
 
-            if (age_>0) {
+            if (rd.age>0) {
 
                 // per root (passed to integrands)
-                n_ = int(n0*r_->getLength()); // number of integration points eq 11
-                v_ = v[ri]; // for mps_straight, eq 11
-                tip_ = tip[ri]; // for mps_straight, eq 11
-                st_ = stopTime[ri]; // eq 13
-                st_ *= calc13;
-
-                std::cout << "Root #" << ri << "/" << roots.size() << ", age "<< age_ << ", stopped "<< st_ <<
-                    ", res "<< n_ << " \n"; // for debugging
+                rd.n = int(n0*rd.r->getLength()); // number of integration points eq 11
+                rd.v = v[ri]; // for mps_straight, eq 11
+                rd.tip = tip[ri]; // for mps_straight, eq 11
+                rd.st = stopTime[ri]; // eq 13
+                rd.st *= calc13;
+                rd.nodes = rd.r->getNodes(); // mps and mls
+                rd.nodeCTs = nodeCTs(rd.r);
+                rd.gf = rd.r->getRootRandomParameter()->f_gf.get(); // mls, see Root::calcLength and Root::calcAge
+                rd.gr = rd.r->param()->r;
+                rd.gk = rd.r->param()->getK();
+
+                std::cout << "Root #" << ri << "/" << roots.size() << ", age "<< rd.age << ", stopped "<< rd.st <<
+                    ", res "<< rd.n << " \n"; // for debugging
 
                 // EQN 11
-                for (size_t i = 0; i<grid.nx; i++) {
-                    for(size_t j = 0; j<grid.ny; j++) {
-                        for (size_t k = 0; k<grid.nz; k++) {
-
-                            x_ = grid.getGridPoint(i,j,k); // integration point
+                parallelFor(grid.nx*grid.ny, [&](size_t ij) {
+                    size_t i = ij / grid.ny;
+                    size_t j = ij % grid.ny;
+                    IntegrandData data = { this, &rd, Vector3d() };
+                    for (size_t k = 0; k<grid.nz; k++) {
 
-                            if ((!limitDomain) || (-sdfs[ri].getDist(x_)<observationRadius)) {
+                        data.x = grid.getGridPoint(i,j,k); // integration point
+                        size_t lind = i*(grid.ny*grid.nz)+j*grid.nz+k;
 
-                                size_t lind = i*(grid.ny*grid.nz)+j*grid.nz+k;
+                        if ((!limitDomain) || (-sdfs[ri].getDist(data.x)<observationRadius)) {
 
-                                // different flavors of Eqn (11)
-                                double c = eqn11(0, age_, 0, l);
-                                grid.data[lind] += c;
-                                g_[lind] = c;
-
-                            } else {
-                                size_t lind = i*(grid.ny*grid.nz)+j*grid.nz+k;
-                                g_[lind] = 0.;
-                            }
+                            // different flavors of Eqn (11)
+                            double c = eqn11(data, 0, rd.age, 0, l);
+                            grid.data[lind] += c;
+                            g_[lind] = c;
 
+                        } else {
+                            g_[lind] = 0.;
                         }
+
                     }
-                }
+                });
 
                 // EQN 13
-                if ((st_>0) && (st_<tend)) { // has stopped growing
+                if ((rd.st>0) && (rd.st<tend)) { // has stopped growing
                     std::cout << "13!";
-                    for (size_t i = 0; i<grid.nx; i++) {
-                        std::cout << "*";
-                        for(size_t j = 0; j<grid.ny; j++) {
-                            for (size_t k = 0; k<grid.nz; k++) {
-
-                                size_t lind = i*(grid.ny*grid.nz)+j*grid.nz+k;
-                                if (g_[lind] > thresh13) {
+                    parallelFor(grid.nx*grid.ny, [&](size_t ij) {
+                        size_t i = ij / grid.ny;
+                        size_t j = ij % grid.ny;
+                        for (size_t k = 0; k<grid.nz; k++) {
 
-                                    x_ = grid.getGridPoint(i,j,k);
-                                    if ((!limitDomain) || (-sdfs[ri].getDist(x_)<observationRadius)) {
+                            size_t lind = i*(grid.ny*grid.nz)+j*grid.nz+k;
+                            if (g_[lind] > thresh13) {
 
-                                        // Eqn (13)
-                                        grid.data[lind] += integrate13(tend);
+                                Vector3d x = grid.getGridPoint(i,j,k);
+                                if ((!limitDomain) || (-sdfs[ri].getDist(x)<observationRadius)) {
 
-                                    }
+                                    // Eqn (13)
+                                    grid.data[lind] += integrate13(x, rd.st, tend);
 
                                 }
+
                             }
                         }
-                    }
+                    });
                     std::cout << "13\n";
                 }
 
@@ -169,16 +206,16 @@ public:
         return grid.data;
     }
 
-    double eqn11(double x0, double xend, double y0, double yend) {
+    double eqn11(IntegrandData& data, double x0, double xend, double y0, double yend) const {
         switch (type) {
         case mps_straight: {
-            return gauss_legendre(n_, integrandMPS_straight, this, x0, xend);
+            return gauss_legendre(data.root->n, integrandMPS_straight, &data, x0, xend);
         }
         case mps: {
-            return gauss_legendre(n_, integrandMPS, this, x0, xend);
+            return gauss_legendre(data.root->n, integrandMPS, &data, x0, xend);
         }
         case mls: {
-            return gauss_legendre_2D_cube(n_, integrandMLS, this, x0, xend, y0, yend);
+            return gauss_legendre_2D_cube(data.root->n, integrandMLS, &data, x0, xend, y0, yend);
         }
         }
         std::cout << "Unknown integration type \n";
@@ -186,14 +223,14 @@ public:
     }
 
     // simplistic integration in 3d
-    double integrate13(double t) {
+    double integrate13(const Vector3d& x, double st, double t) const {
         double c = 0;
         for (size_t i = 0; i<grid.nx; i++) {
             for(size_t j = 0; j<grid.ny; j++) {
                 for (size_t k = 0; k<grid.nz; k++) {
                     Vector3d y = grid.getGridPoint(i,j,k);
                     size_t lind = i*(grid.ny*grid.nz)+j*grid.nz+k;
-                    c += integrand13(y,lind, t)*dx3;
+                    c += integrand13(x, y, lind, st, t)*dx3;
                 }
             }
         }
@@ -201,31 +238,53 @@ public:
     }
 
     // integrand Eqn 13
-    double integrand13(Vector3d& y, size_t lind, double t) {
-        double dt = t-st_;
+    double integrand13(const Vector3d& x, const Vector3d& y, size_t lind, double st, double t) const {
+        double dt = t-st;
         double c = to32(R)*g_[lind] / to32(4*Dl*M_PI*dt);
-        Vector3d z = x_.minus(y);
+        Vector3d z = x.minus(y);
         return c*exp(-R/(4*Dl*dt) * z.times(z) - k*dt/R);
     }
 
+    /**
+     * Calls f(i) for i = 0..n-1, distributed in chunks over ExudationModel::threads threads (@see CPlantBox::parallelFor)
+     */
+    template<class F>
+    void parallelFor(size_t n, F&& f) const {
+        CPlantBox::parallelFor(n, threads, f, 16);
+    }
+
     // Returns the linearly interpolated position along the root r at age a
     static Vector3d pointAtAge(std::shared_ptr<Root> r, double a) {
+        return pointAtAge(r->getNodes(), nodeCTs(r), a);
+    }
+
+    // Returns the node creation times of the root r
+    static std::vector<double> nodeCTs(std::shared_ptr<Root> r) {
+        std::vector<double> cts(r->getNumberOfNodes());
+        for (size_t i = 0; i<cts.size(); i++) {
+            cts[i] = r->getNodeCT(i);
+        }
+        return cts;
+    }
+
+    // Returns the linearly interpolated position along a root, given by its nodes and node creation times, at age a
+    static Vector3d pointAtAge(const std::vector<Vector3d>& nodes, const std::vector<double>& nodeCTs, double a) {
         a = std::max(0.,a);
-        double et = r->getNodeCT(0)+a; // age -> emergence time
+        double et = nodeCTs.at(0)+a; // age -> emergence time
         size_t i=0;
-        while (i<r->getNumberOfNodes()) {
-            if (r->getNodeCT(i)>et) { // first index bigger than emergence time, interpolate i-1, i
+        while (i<nodes.size()) {
+            if (nodeCTs[i]>et) { // first index bigger than emergence time, interpolate i-1, i
                 break;
             }
             i++;
         }
-        if (i == r->getNumberOfNodes()) { // this happens if a root has stopped growing
+        if (i == nodes.size()) { // this happens if a root has stopped growing
             std::cout << "pointAtAge(): warning age is older than the root \n";
-            return r->getNode(i-1);
+            return nodes[i-1];
         }
-        Vector3d n1 = r->getNode(i-1);
-        Vector3d n2 = r->getNode(i);
-        double t = (et - r->getNodeCT(i - 1)) / (r->getNodeCT(i) - r->getNodeCT(i - 1)); // t in (0,1]
+        Vector3d n1 = nodes[i-1];
+        Vector3d n2 = nodes[i];
+        double t = (et - nodeCTs[i - 1]) / (nodeCTs[i] - nodeCTs[i - 1]); // t in (0,1]
         return (n1.times(1. - t)).plus(n2.times(t));
     }
 
@@ -235,42 +294,46 @@ public:
 
     // point source, root is represented by a single straight line (substituted)
     static double integrandMPS_straight(double t, void* param) {
-        ExudationModel* p = (ExudationModel*) param;
+        const IntegrandData* data = (const IntegrandData*) param;
+        const ExudationModel* p = data->model;
         double c = -p->R / ( 4*p->Dl*t );
         double d = 8*(p->theta)*ExudationModel::to32(M_PI*p->Dl*t);
 
-        Vector3d xtip = p->tip_.plus(p->v_.times(t)); // for t=0 at tip, at t=age at base, as above
-        Vector3d z = p->x_.minus(xtip);
+        Vector3d xtip = data->root->tip.plus(data->root->v.times(t)); // for t=0 at tip, at t=age at base, as above
+        Vector3d z = data->x.minus(xtip);
 
         return ((p->Q)*sqrt(p->R))/d *exp(c*z.times(z) - p->k/p->R * t); // Eqn (11)
     }
 
     // moving line source, root is represented by a straight segments
     static double integrandMLS(double t, double l, void* param) {
-        ExudationModel* p = (ExudationModel*) param;
+        const IntegrandData* data = (const IntegrandData*) param;
+        const ExudationModel* p = data->model;
         double c = -(p->R) / ( 4*(p->Dl)*t );
         double d = 8*(p->theta)*ExudationModel::to32(M_PI*p->Dl*t);
 
 
-        double tl = p->r_->calcLength( p->age_-t ); // tip
+        const RootData* rd = data->root;
+        double tl = rd->gf->getLength(rd->age-t, rd->gr, rd->gk, rd->r); // tip, as Root::calcLength
         if (tl<l) { // if root smaller l
             return 0.;
         }
-        double agel = p->r_->calcAge(tl-l);
-        Vector3d tipLS = p->ExudationModel::pointAtAge(p->r_, agel);
-        Vector3d z = p->x_.minus(tipLS);
+        double agel = rd->gf->getAge(tl-l, rd->gr, rd->gk, rd->r); // as Root::calcAge
+        Vector3d tipLS = ExudationModel::pointAtAge(rd->nodes, rd->nodeCTs, agel);
+        Vector3d z = data->x.minus(tipLS);
 
         return ((p->Q)*sqrt(p->R))/d *exp(c*z.times(z) - p->k/p->R * t); // Eqn (11)
     }
 
     // moving point source, root is represented by a straight segments
     static double integrandMPS(double t, void* param) {
-        ExudationModel* p = (ExudationModel*) param;
+        const IntegrandData* data = (const IntegrandData*) param;
+        const ExudationModel* p = data->model;
         double c = -p->R / ( 4*p->Dl*t );
         double d = 8*(p->theta)*ExudationModel::to32(M_PI*p->Dl*t);
 
-        Vector3d xtip = ExudationModel::pointAtAge(p->r_, p->age_-t);
-        Vector3d z = p->x_.minus(xtip);
+        Vector3d xtip = ExudationModel::pointAtAge(data->root->nodes, data->root->nodeCTs, data->root->age-t);
+        Vector3d z = data->x.minus(xtip);
 
         return ((p->Q)*sqrt(p->R))/d *exp(c*z.times(z) - p->k/p->R * t); // Eqn (11)
     }
@@ -284,15 +347,7 @@ public:
     std::vector<SDF_RootSystem> sdfs; // direction from tip towards root base
     bool limitDomain = (observationRadius>0);
 
-    // Set before integrating
-    Vector3d x_ = Vector3d(); // integration point
-    int n_ = 0;
-    std::shared_ptr<Root> r_ = nullptr; // current root
-    double age_ = 0;
-    Vector3d tip_ = Vector3d();
-    Vector3d v_ = Vector3d();
-    double st_ = 0; // stop time (eqn 13)
-    std::vector<double> g_;  // eqn 13
+    std::vector<double> g_;  // eqn 13, contribution of the current root
 
 };
 
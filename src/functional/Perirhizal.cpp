@@ -16,8 +16,7 @@ std::vector<double> Perirhizal::segOuterRadii(int type, const std::vector<double
     auto width = ms->maxBound.minus(ms->minBound);
     std::vector<double> outer_radii = std::vector<double>(ms->segments.size());
     std::fill(outer_radii.begin(), outer_radii.end(), 0.);
-    for(auto iter = ms->cell2seg.begin(); iter != ms->cell2seg.end(); ++iter) {
-        int cellId =  iter->first;
+    for (int cellId : ms->cell2seg.cells()) {
         if (vols.size()==0) {
             cellVolume = width.x*width.y*width.z/ms->resolution.x/ms->resolution.y/ms->resolution.z;
         } else {
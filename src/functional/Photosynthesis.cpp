@@ -4,8 +4,6 @@
 //#include <armadillo>
 //#include <algorithm>
 #include <set>
-#include <Eigen/Dense>
-#include <Eigen/Sparse>
 #include <iostream>
 #include <fstream>
 
@@ -159,7 +157,9 @@ void Photosynthesis::solve_photosynthesis(double ea_, double es_, double sim_tim
 
 
 /**
- * Solves the linear system filled by @see XylemFlux::linearSystem
+ * Solves the flux equations for the xylem water potential psiXyl, directly on the tree (@see XylemFlux::solve).
+ * The topology is only analysed again if the segments changed (@see XylemFlux::getTreeSolver),
+ * i.e. the iterations of Photosynthesis::solve_photosynthesis only repeat the O(N) elimination.
  *
  * @param simTime[day]  	current simulation time, needed for age dependent conductivities,
  *                  		to calculate the age from the creation times (age = sim_time - segment creation time).
@@ -170,71 +170,9 @@ void Photosynthesis::solve_photosynthesis(double ea_, double es_, double sim_tim
  */
 void Photosynthesis::linearSystemSolve(double simTime_, const std::vector<double>& sxx_, bool cells_, const std::vector<double> soil_k_)
 {
-	
-	int Ns = rs->segments.size(); // number of segments
-    int N = rs->nodes.size(); // number of nodes
-	tripletList.clear();
-	tripletList.reserve(Ns*4);
-	b = Eigen::VectorXd(N);
-	//get "tripletList" and "b"
-	linearSystem(simTime_, sxx_, cells_, soil_k_); //see XylemFlux::linearSystem
-	Eigen::SparseMatrix<double> mat(N,N);
-	mat.reserve(Eigen::VectorXi::Constant(N,2));
-	mat.setFromTriplets(tripletList.begin(), tripletList.end());
-	mat.makeCompressed();
-	Eigen::SparseLU<Eigen::SparseMatrix<double>> lu;
-	lu.compute(mat);
-
-	if(lu.info() != Eigen::Success){
-		std::cout << "XylemFlux::linearSystem  matrix Compute with Eigen failed: " << lu.info() << std::endl;
-		throw std::runtime_error("XylemFlux::linearSystem  matrix Compute with Eigen failed" );
-	}
-
-	Eigen::VectorXd v2;
-	try{
-		v2= lu.solve(b);
-	}catch(...){
-		 throw std::runtime_error("XylemFlux::linearSystem error when solving wat. pot. xylem with Eigen ");
-	}
-	std::vector<double> v3(&v2[0], v2.data()+v2.cols()*v2.rows());
-	psiXyl = v3;
-}
-
-/**
- * fill the matrices to be solved. overloads @see XylemFlux::fillVectors
- * @param k				index for the row- and column-index vectors
- * @param i, j			indexes of the non-zero elements of the sparse matrix
- * @param psi_s 		outer water potential [cm]
- * @param bi			value of variable b at row i [cm3/d]
- * @param cii			value of variable c at row i col i [cm2/d]
- * @param cij			value of variable c at row i col j [cm2/d]
- * @return k			next index for the row- and column-index vectors
- */
-size_t Photosynthesis::fillVectors(size_t k, int i, int j, double bi, double cii, double cij, double psi_s) 
-{
-	typedef Eigen::Triplet<double> Tri;
-	aB[i] += ( bi + cii * psi_s +cij * psi_s) ;
-
-	b(i) = aB[i];
-	tripletList.push_back(Tri(i,i,cii));
-	k += 1;
-	tripletList.push_back(Tri(i,j,cij));
-	k += 1;
-
-	int ii = i;
-	i = j;  j = ii; // edge ji
-	aB[i] += ( -bi + cii * psi_s +cij * psi_s) ; // (-bi) Eqn (14) with changed sign
-
-	b(i) = aB[i];
-	tripletList.push_back(Tri(i,i,cii));
-	k += 1;
-
-	tripletList.push_back(Tri(i,j,cij));
-	k += 1;
-	return k;
+	psiXyl = solve(simTime_, sxx_, cells_, std::vector<int>(), std::vector<double>(), false, soil_k_); // no boundary conditions, transpiration enters by getPsiOut
 }
 
-
 /**
  *  give outer water potential [cm] overloads by @see Xylem::getPsiOut
  * @param cells 		sx per cell (true), or segments (false)
@@ -8,9 +8,6 @@
 #include <iostream>
 #include <fstream>
 
-#include <Eigen/Dense>
-#include <Eigen/Sparse>
-
 namespace CPlantBox {
 
 /**
@@ -67,7 +64,6 @@ public:
 	}
 	
 	double getPsiOut(bool cells, int si, const std::vector<double>& sx_, bool verbose = false) const override;
-	size_t fillVectors(size_t k, int i, int j, double bi, double cii, double cij, double psi_s) override ; ///< fill the vectors aI, aJ, aV, aB
 	double kr_f(int si, double age, int type, int orgtype);
 		
 		
@@ -219,11 +215,6 @@ public:
 	std::vector<std::shared_ptr<Organ>> orgsVec;
 	std::vector<int> seg_leaves_idx;
     bool stop = false;
-protected:
-	//for Photosynthesis::linearSystemSolve
-	std::vector<Eigen::Triplet<double>> tripletList;
-	Eigen::VectorXd b;
-	
 
 };
 
@@ -38,49 +38,114 @@ void PlantHydraulicModel::linearSystemMeunier(double simTime, const std::vector<
         int i = rs->segments[si].x;
         int j = rs->segments[si].y;
 
-        double psi_s = getPsiOut(cells, si, sx);
-        double age = simTime - rs->nodeCTs[j];
-        int organType = rs->organTypes[si];
-        int subType = rs->subTypes[si];
-        double kx = 0.;
-        double  kr = 0.;
+        double bi, cii, cij, psi_s;
+        segmentCoefficients(si, simTime, sx, cells, bi, cii, cij, psi_s);
 
-        try {
-            kx = params->kx_f(si, age, subType, organType);
-            kr = params->kr_f(si, age, subType, organType);
-        } catch(...) {
-            std::cout << "\n XylemFlux::linearSystem: conductivities failed" << std::flush;
-            std::cout  << "\n organ type "<<organType<< " subtype " << subType <<std::flush;
-        }
+		k = fillVectors(k, i, j, bi, cii, cij, psi_s);
+    }
+}
 
-        auto n1 = rs->nodes[i];
-        auto n2 = rs->nodes[j];
-        auto v = n2.minus(n1);
-        double l = v.length();
-        if (l<1.e-5) {
-            // std::cout << "XylemFlux::linearSystem: warning segment length smaller 1.e-5 \n";
-            l = 1.e-5; // valid quick fix? (also in segFluxes)
-        }
-		double perimeter = rs->getPerimeter(si, l);//perimeter of exchange surface
-        double vz = v.z / l; // normed direction
-
-        double cii, cij, bi;
-
-        if (perimeter * kr>1.e-16) {
-            double tau = std::sqrt(perimeter * kr / kx); // Eqn (6)
-            double delta = std::exp(-tau * l) - std::exp(tau * l); // Eqn (12)
-            double idelta = 1. / delta;
-            cii = -kx * idelta * tau * (std::exp(-tau * l) + std::exp(tau * l)); // Eqn (23)
-            cij = 2 * kx * idelta * tau;  // Eqn 24
-            bi = kx * vz; //  # Eqn 25
-        } else { // solution for a=0, or kr = 0
-            cii = kx/l;
-            cij = -kx/l;
-            bi = kx * vz;
-            psi_s = 0;//
-        }
+/**
+ * Solves the linear system of the hybrid solver directly on the tree, see @see TreeSolver,
+ * without assembling the sparse matrix (aI, aJ, aV, and aB are not changed)
+ *
+ * @param simTime[day]  	current simulation time, needed for age dependent conductivities,
+ *                  		to calculate the age from the creation times (age = sim_time - segment creation time).
+ * @param sx [cm]			soil matric potential in the cells or around the segments, given per cell or per segment
+ * @param cells 			sx per cell (true), or segments (false)
+ * @param bcNodes           node indices of the boundary conditions (e.g. the root collar)
+ * @param bcValues          boundary values per node, [cm] in case of Dirichlet, [cm3 day-1] in case of Neumann
+ * @param dirichlet         Dirichlet (true), or Neumann (false) boundary conditions
+ *
+ * @return [cm] xylem pressure head per node
+ */
+std::vector<double> PlantHydraulicModel::solve(double simTime, const std::vector<double>& sx, bool cells,
+    const std::vector<int>& bcNodes, const std::vector<double>& bcValues, bool dirichlet)
+{
+    int Ns = rs->segments.size(); // number of segments
+    int N = rs->nodes.size(); // number of nodes
+    std::vector<double> d(N, 0.), c(Ns), b(N, 0.);
+    for (int si = 0; si<Ns; si++) {
+        int i = rs->segments[si].x;
+        int j = rs->segments[si].y;
+        double bi, cii, cij, psi_s;
+        segmentCoefficients(si, simTime, sx, cells, bi, cii, cij, psi_s);
+        d[i] += cii;
+        d[j] += cii;
+        c[si] = cij;
+        b[i] += bi + cii * psi_s + cij * psi_s;
+        b[j] += -bi + cii * psi_s + cij * psi_s; // (-bi) Eqn (14) with changed sign
+    }
+    return getTreeSolver().solve(d, c, b, bcNodes, bcValues, dirichlet);
+}
 
-		k = fillVectors(k, i, j, bi, cii, cij, psi_s);
+/**
+ * The tree solver is created for the current segments, and reused as long as the topology does not change
+ * (e.g. between the iterations of a coupled model, or between time steps without growth)
+ */
+const TreeSolver& PlantHydraulicModel::getTreeSolver()
+{
+    int N = rs->nodes.size();
+    if ((!treeSolver) || (!treeSolver->matches(rs->segments, N))) {
+        treeSolver = std::make_shared<TreeSolver>(rs->segments, N);
+    }
+    return *treeSolver;
+}
+
+/**
+ * Coefficients of the hybrid solver for a single segment, see Meunier et al. (2017)
+ *
+ * @param si                segment index
+ * @param simTime[day]  	current simulation time, needed for age dependent conductivities
+ * @param sx [cm]			soil matric potential in the cells or around the segments, given per cell or per segment
+ * @param cells 			sx per cell (true), or segments (false)
+ * @param bi, cii, cij      [out] coefficients of the segment, Eqns (23)-(25)
+ * @param psi_s             [out] outer water potential [cm]
+ */
+void PlantHydraulicModel::segmentCoefficients(int si, double simTime, const std::vector<double>& sx, bool cells,
+    double& bi, double& cii, double& cij, double& psi_s) const
+{
+    int i = rs->segments[si].x;
+    int j = rs->segments[si].y;
+
+    psi_s = getPsiOut(cells, si, sx);
+    double age = simTime - rs->nodeCTs[j];
+    int organType = rs->organTypes[si];
+    int subType = rs->subTypes[si];
+    double kx = 0.;
+    double  kr = 0.;
+
+    try {
+        kx = params->kx_f(si, age, subType, organType);
+        kr = params->kr_f(si, age, subType, organType);
+    } catch(...) {
+        std::cout << "\n XylemFlux::linearSystem: conductivities failed" << std::flush;
+        std::cout  << "\n organ type "<<organType<< " subtype " << subType <<std::flush;
+    }
+
+    auto n1 = rs->nodes[i];
+    auto n2 = rs->nodes[j];
+    auto v = n2.minus(n1);
+    double l = v.length();
+    if (l<1.e-5) {
+        // std::cout << "XylemFlux::linearSystem: warning segment length smaller 1.e-5 \n";
+        l = 1.e-5; // valid quick fix? (also in segFluxes)
+    }
+	double perimeter = rs->getPerimeter(si, l);//perimeter of exchange surface
+    double vz = v.z / l; // normed direction
+
+    if (perimeter * kr>1.e-16) {
+        double tau = std::sqrt(perimeter * kr / kx); // Eqn (6)
+        double delta = std::exp(-tau * l) - std::exp(tau * l); // Eqn (12)
+        double idelta = 1. / delta;
+        cii = -kx * idelta * tau * (std::exp(-tau * l) + std::exp(tau * l)); // Eqn (23)
+        cij = 2 * kx * idelta * tau;  // Eqn 24
+        bi = kx * vz; //  # Eqn 25
+    } else { // solution for a=0, or kr = 0
+        cii = kx/l;
+        cij = -kx/l;
+        bi = kx * vz;
+        psi_s = 0;//
     }
 }
 
@@ -170,7 +235,7 @@ std::map<int,double> PlantHydraulicModel::sumSegFluxes(const std::vector<double>
     for (int si = 0; si<rs->segments.size(); si++) {
         int j = rs->segments[si].y;
         int segIdx = j-1;
-        if (rs->seg2cell.count(segIdx)>0) {
+        if (segIdx<rs->seg2cell.size()) {
             int cellIdx = rs->seg2cell[segIdx];
             if (cellIdx>=0) {
                 if (fluxes.count(cellIdx)==0) {
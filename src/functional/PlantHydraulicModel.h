@@ -4,6 +4,7 @@
 
 #include "MappedOrganism.h"
 #include "PlantHydraulicParameters.h"
+#include "TreeSolver.h"
 
 namespace CPlantBox {
 
@@ -23,6 +24,8 @@ public:
     virtual ~PlantHydraulicModel() { }
 
     void linearSystemMeunier(double simTime, const std::vector<double> sx, bool cells = true); ///< builds linear system (simTime is needed for age dependent conductivities)
+    std::vector<double> solve(double simTime, const std::vector<double>& sx, bool cells, const std::vector<int>& bcNodes,
+        const std::vector<double>& bcValues, bool dirichlet = false); ///< solves the linear system on the tree in O(N), without assembling a matrix
 
     std::vector<double> getRadialFluxes(double simTime, const std::vector<double> rx, const std::vector<double> sx, bool approx = false, bool cells = false) const; // for each segment in [cm3/day]
     std::map<int,double> sumSegFluxes(const std::vector<double> segFluxes); ///< sums segment fluxes over soil cells,  soilFluxes = sumSegFluxes(segFluxes), [cm3/day]
@@ -37,8 +40,13 @@ public:
 
 protected:
 
+    void segmentCoefficients(int si, double simTime, const std::vector<double>& sx, bool cells,
+        double& bi, double& cii, double& cij, double& psi_s) const; ///< coefficients of the hybrid solver for segment si
     virtual size_t fillVectors(size_t k, int i, int j, double bi, double cii, double cij, double psi_s) ; ///< fills row k of Meunier matrix
 	virtual double getPsiOut(bool cells, int si, const std::vector<double>& sx_) const; ///< get the outer water potential [cm]
+    const TreeSolver& getTreeSolver(); ///< topology of the current segments, analysed again only if it changed
+
+    std::shared_ptr<TreeSolver> treeSolver; // @see PlantHydraulicModel::getTreeSolver
 
 };
 
@@ -158,14 +158,12 @@ class PlantHydraulicModel(PlantHydraulicModelCPP):
         return np.maximum(0., np.pi * (np.cos(2 * np.pi * (t - 0.5)) + np.cos(2 * np.pi * ((t + dt) - 0.5))) / 2)
 
     def get_nodes(self):
-        """ converts the list of Vector3d to a 2D numpy array (from MappedOrganism) """
-        nodes = self.rs.nodes
-        return np.array(list(map(lambda x: np.array(x), nodes)))
+        """ nodes as 2D numpy array (from MappedOrganism) """
+        return np.array(self.rs.nodesArray)  # a copy, the view is only valid until the next simulate call
 
     def get_segments(self):
-        """ converts the list of Vector2i to a 2D numpy array """
-        segments = self.rs.segments
-        return np.array(list(map(lambda x: np.array(x), segments)), dtype = np.int64)
+        """ segments as 2D numpy array """
+        return np.asarray(self.rs.segmentsArray, dtype = np.int64)
 
     def get_organ_types(self):
         """ segment organ types as numpy array """
@@ -306,7 +304,7 @@ class PlantHydraulicModel(PlantHydraulicModelCPP):
         print("ages from {:g} to {:g}".format(np.min(ages), np.max(ages)))
         # 4 check for unmapped indices
         map = self.rs.seg2cell
-        for seg_id, cell_id in map.items():
+        for seg_id, cell_id in enumerate(map):
             if cell_id < 0:
                 print("Warning: segment ", seg_id, "is not mapped, this will cause problems with coupling!", nodes[segments[seg_id][0]], nodes[segments[seg_id][1]])
         print()
@@ -341,13 +339,9 @@ class HydraulicModel_Meunier(PlantHydraulicModel):
             n = len(self.dirichlet_ind)
             collar_pot = [collar_pot] * n
 
-        self.linearSystemMeunier(sim_time, sxx, cells)
-        self.Q = sparse.coo_matrix((np.array(self.aV), (np.array(self.aI), np.array(self.aJ))))
-        self.Q = sparse.csc_matrix(self.Q)
-        self.Q, self.b = self.bc_dirichlet(self.Q, self.aB, self.dirichlet_ind, collar_pot)
-        x = LA.spsolve(self.Q, self.b, use_umfpack = True)
+        x = self.solve_cpp(sim_time, sxx, cells, self.dirichlet_ind, collar_pot, True)  # C++ tree solver (see PlantHydraulicModel::solve)
 
-        return x
+        return np.array(x)
 
     def solve_neumann(self, sim_time:float, trans:list, sxx, cells:bool):
         """ solves the flux equations, with a neumann boundary condtion, see solve()
@@ -364,13 +358,9 @@ class HydraulicModel_Meunier(PlantHydraulicModel):
             n = len(self.neumann_ind)
             trans = [trans / n] * n
 
-        self.linearSystemMeunier(sim_time, sxx, cells)  # C++ (see XylemFlux.cpp)
-        self.Q = sparse.coo_matrix((np.array(self.aV), (np.array(self.aI), np.array(self.aJ))))
-        self.Q = sparse.csc_matrix(self.Q)
-        self.Q, self.b = self.bc_neumann(self.Q, self.aB, self.neumann_ind, trans)  # cm3 day-1
-        x = LA.spsolve(self.Q, self.b, use_umfpack = True)  # direct
+        x = self.solve_cpp(sim_time, sxx, cells, self.neumann_ind, trans, False)  # C++ tree solver (see PlantHydraulicModel::solve)
 
-        return x
+        return np.array(x)
 
     def solve(self, sim_time:float, trans:list, sxx, cells:bool):
         """ Solves the hydraulic model using Neumann boundary conditions and switching to Dirichlet in case wilting point is reached
@@ -384,15 +374,12 @@ class HydraulicModel_Meunier(PlantHydraulicModel):
         """
         eps = 1
 
-        x = self.solve_neumann(sim_time, trans, sxx, cells, soil_k)  # try neumann, if below wilting point, switch to Dirichlet
+        x = self.solve_neumann(sim_time, trans, sxx, cells)  # try neumann, if below wilting point, switch to Dirichlet
         self.last = "neumann"
 
-        if x[0] <= wilting_point:
+        if x[0] <= self.wilting_point:
 
-            Q = sparse.coo_matrix((np.array(self.aV), (np.array(self.aI), np.array(self.aJ))))
-            Q = sparse.csc_matrix(Q)
-            Q, b = self.bc_dirichlet(Q, self.aB, [0], [float(wilting_point)])
-            x = LA.spsolve(Q, b, use_umfpack = True)
+            x = np.array(self.solve_cpp(sim_time, sxx, cells, [0], [float(self.wilting_point)], True))
             self.last = "dirichlet"
 
         return x
@@ -0,0 +1,190 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#ifndef TREE_SOLVER_H_
+#define TREE_SOLVER_H_
+
+#include "mymath.h"
+
+#include <vector>
+#include <stdexcept>
+#include <string>
+
+namespace CPlantBox {
+
+/**
+ * Direct solver for symmetric linear systems, whose graph is a tree (or a forest),
+ * i.e. the systems of the hybrid solver (Meunier et al. 2017) on a plant.
+ *
+ * Gaussian elimination from the tips to the collar, followed by a back substitution from the collar to the tips,
+ * needs O(N) operations, and no matrix is built (used by @see XylemFlux::solve, and @see PlantHydraulicModel::solve)
+ *
+ * The constructor analyses the topology (parent per node, and elimination order) once,
+ * TreeSolver::solve only performs the numerical elimination, and can be called for changing values,
+ * as long as TreeSolver::matches the segments.
+ */
+class TreeSolver
+{
+public:
+
+    /**
+     * Analyses the topology
+     *
+     * @param segments      connectivity of the nodes, where x is the parent node, and y the child node
+     * @param N             number of nodes
+     */
+    TreeSolver(const std::vector<Vector2i>& segments, int N) :parentSeg(N, -1), parentNode(N, -1)
+    {
+        int Ns = segments.size(); // number of segments
+        std::vector<int> offset(N + 1, 0); // children per node (CSR)
+        for (int si = 0; si<Ns; si++) {
+            parentSeg.at(segments[si].y) = si;
+            parentNode.at(segments[si].y) = segments[si].x;
+            offset.at(segments[si].x + 1)++;
+        }
+        for (int n = 0; n<N; n++) {
+            offset[n + 1] += offset[n];
+        }
+        std::vector<int> children(Ns);
+        std::vector<int> pos(offset.begin(), offset.end() - 1);
+        for (int si = 0; si<Ns; si++) {
+            children[pos[segments[si].x]++] = segments[si].y;
+        }
+
+        // breadth first order starting at the root nodes, i.e. parents before children
+        order.reserve(N);
+        for (int n = 0; n<N; n++) {
+            if (parentSeg[n]<0) {
+                order.push_back(n);
+            }
+        }
+        numberOfRoots = order.size();
+        for (size_t k = 0; k<order.size(); k++) {
+            int n = order[k];
+            for (int l = offset[n]; l<offset[n + 1]; l++) {
+                order.push_back(children[l]);
+            }
+        }
+        if (order.size()!=N) {
+            throw std::runtime_error("TreeSolver::TreeSolver: segments do not describe a tree, number of nodes "+std::to_string(N)+
+                ", number of reached nodes "+std::to_string(order.size()));
+        }
+    }
+
+    /**
+     * Checks if the analysed topology is still valid for the segments, in O(N)
+     *
+     * @param segments      connectivity of the nodes, where x is the parent node, and y the child node
+     * @param N             number of nodes
+     */
+    bool matches(const std::vector<Vector2i>& segments, int N) const
+    {
+        if ((N!=(int)parentSeg.size()) || (segments.size()+numberOfRoots!=(size_t)N)) {
+            return false;
+        }
+        for (size_t si = 0; si<segments.size(); si++) {
+            const auto& s = segments[si];
+            if ((s.y<0) || (s.y>=N) || (parentSeg[s.y]!=(int)si) || (parentNode[s.y]!=s.x)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Solves the system Qx=b, where Q has the diagonal entries d (per node) and the off diagonal entries c (per segment)
+     *
+     * @param d             diagonal entries per node
+     * @param c             off diagonal entries per segment, Q(x,y) = Q(y,x) = c
+     * @param b             right hand side per node
+     * @param bcNodes       node indices of the boundary conditions
+     * @param bcValues      values per boundary node, [cm] in case of Dirichlet, [cm3 day-1] in case of Neumann
+     * @param dirichlet     Dirichlet (true), or Neumann (false) boundary conditions
+     *
+     * @return solution x per node
+     */
+    std::vector<double> solve(std::vector<double> d, const std::vector<double>& c, std::vector<double> b,
+        const std::vector<int>& bcNodes, const std::vector<double>& bcValues, bool dirichlet) const
+    {
+        int N = parentSeg.size();
+        if ((d.size()!=N) || (b.size()!=N)) {
+            throw std::invalid_argument("TreeSolver::solve: number of diagonal entries or right hand side values does not match the number of nodes");
+        }
+        if (bcNodes.size()!=bcValues.size()) {
+            throw std::invalid_argument("TreeSolver::solve: number of boundary nodes and boundary values must be equal");
+        }
+
+        // boundary conditions
+        std::vector<bool> fixed(N, false);
+        std::vector<double> x(N, 0.);
+        for (size_t k = 0; k<bcNodes.size(); k++) {
+            int n = bcNodes[k];
+            if (dirichlet) {
+                fixed.at(n) = true;
+                x[n] = bcValues[k];
+            } else {
+                b.at(n) += bcValues[k];
+            }
+        }
+
+        // elimination, from the tips to the roots
+        for (int k = N - 1; k>=0; k--) {
+            int n = order[k];
+            int si = parentSeg[n];
+            if (si<0) {
+                continue;
+            }
+            int p = parentNode[n];
+            if (fixed[p]) { // row p is replaced by the Dirichlet condition
+                continue;
+            }
+            if (fixed[n]) {
+                b[p] -= c[si] * x[n];
+            } else {
+                if (d[n]==0.) {
+                    throw std::runtime_error("TreeSolver::solve: zero pivot at node "+std::to_string(n));
+                }
+                double f = c[si] / d[n];
+                d[p] -= f * c[si];
+                b[p] -= f * b[n];
+            }
+        }
+
+        // back substitution, from the roots to the tips
+        for (int k = 0; k<N; k++) {
+            int n = order[k];
+            if (fixed[n]) {
+                continue;
+            }
+            if (d[n]==0.) {
+                throw std::runtime_error("TreeSolver::solve: zero pivot at node "+std::to_string(n));
+            }
+            int si = parentSeg[n];
+            if (si<0) {
+                x[n] = b[n] / d[n];
+            } else {
+                x[n] = (b[n] - c[si] * x[parentNode[n]]) / d[n];
+            }
+        }
+        return x;
+    }
+
+    /**
+     * Analyses the topology and solves the system in one call, @see TreeSolver::solve
+     */
+    static std::vector<double> solve(const std::vector<Vector2i>& segments, std::vector<double> d, const std::vector<double>& c,
+        std::vector<double> b, const std::vector<int>& bcNodes, const std::vector<double>& bcValues, bool dirichlet)
+    {
+        return TreeSolver(segments, d.size()).solve(d, c, b, bcNodes, bcValues, dirichlet);
+    }
+
+protected:
+
+    std::vector<int> parentSeg; // parent segment per node (-1 for roots)
+    std::vector<int> parentNode; // parent node per node (-1 for roots)
+    std::vector<int> order; // parents before children
+    size_t numberOfRoots = 0; // nodes without parent
+
+};
+
+} // namespace
+
+#endif
@@ -42,55 +42,123 @@ void XylemFlux::linearSystem(double simTime, const std::vector<double>& sx, bool
         int i = rs->segments[si].x;
         int j = rs->segments[si].y;
 
-        double psi_s = getPsiOut(cells, si, sx, verbose);
-        double age = simTime - rs->nodeCTs[j];
-        int organType = rs->organTypes[si];
-        int subType = rs->subTypes[si];
-        double kx = 0.;
-        double  kr = 0.;
+        double bi, cii, cij, psi_s;
+        segmentCoefficients(si, simTime, sx, cells, soil_k, verbose, bi, cii, cij, psi_s);
 
-        try {
-            kx = kx_f(si, age, subType, organType);
-            kr = kr_f_wrapped(si, age, subType, organType, cells);
-        } catch(...) {
-            std::cout << "\n XylemFlux::linearSystem: conductivities failed" << std::flush;
-            std::cout  << "\n organ type "<<organType<< " subtype " << subType <<std::flush;
-        }
-        if (soil_k.size()>0) {
-            kr = std::min(kr, soil_k[si]);
-        }
+		k = fillVectors(k, i, j, bi, cii, cij, psi_s);
+    }
+}
 
-        auto n1 = rs->nodes[i];
-        auto n2 = rs->nodes[j];
-        auto v = n2.minus(n1);
-        double l = v.length();
-        if (l<1.e-5) {
-            // std::cout << "XylemFlux::linearSystem: warning segment length smaller 1.e-5 \n";
-            l = 1.e-5; // valid quick fix? (also in segFluxes)
-        }
-		double perimeter = rs->getPerimeter(si, l);//perimeter of exchange surface
-        double vz = v.z / l; // normed direction
-
-        double cii, cij, bi;
-
-        if (perimeter * kr>1.e-16) {
-            double tau = std::sqrt(perimeter * kr / kx); // Eqn (6)
-            double delta = std::exp(-tau * l) - std::exp(tau * l); // Eqn (12)
-            double idelta = 1. / delta;
-            cii = -kx * idelta * tau * (std::exp(-tau * l) + std::exp(tau * l)); // Eqn (23)
-            cij = 2 * kx * idelta * tau;  // Eqn 24
-            bi = kx * vz; //  # Eqn 25
-        } else { // solution for a=0, or kr = 0
-            cii = kx/l;
-            cij = -kx/l;
-            bi = kx * vz;
-            psi_s = 0;
-        }
 
-		k = fillVectors(k, i, j, bi, cii, cij, psi_s);
+/**
+ * Solves the linear system of the hybrid solver directly on the tree, see @see TreeSolver,
+ * without assembling the sparse matrix (aI, aJ, aV, and aB are not changed)
+ *
+ * @param simTime[day]  	current simulation time, needed for age dependent conductivities,
+ *                  		to calculate the age from the creation times (age = sim_time - segment creation time).
+ * @param sx [cm]			soil matric potential in the cells or around the segments, given per cell or per segment
+ * @param cells 			sx per cell (true), or segments (false)
+ * @param bcNodes           node indices of the boundary conditions (e.g. the root collar)
+ * @param bcValues          boundary values per node, [cm] in case of Dirichlet, [cm3 day-1] in case of Neumann
+ * @param dirichlet         Dirichlet (true), or Neumann (false) boundary conditions
+ * @param soil_k [day-1]    optionally, soil conductivities can be prescribed per segment,
+ *                          conductivity at the root surface will be limited by the value, i.e. kr = min(kr_root, k_soil)
+ *
+ * @return [cm] xylem pressure head per node
+ */
+std::vector<double> XylemFlux::solve(double simTime, const std::vector<double>& sx, bool cells,
+    const std::vector<int>& bcNodes, const std::vector<double>& bcValues, bool dirichlet, const std::vector<double> soil_k, bool verbose)
+{
+    int Ns = rs->segments.size(); // number of segments
+    int N = rs->nodes.size(); // number of nodes
+    std::vector<double> d(N, 0.), c(Ns), b(N, 0.);
+    for (int si = 0; si<Ns; si++) {
+        int i = rs->segments[si].x;
+        int j = rs->segments[si].y;
+        double bi, cii, cij, psi_s;
+        segmentCoefficients(si, simTime, sx, cells, soil_k, verbose, bi, cii, cij, psi_s);
+        d[i] += cii;
+        d[j] += cii;
+        c[si] = cij;
+        b[i] += bi + cii * psi_s + cij * psi_s;
+        b[j] += -bi + cii * psi_s + cij * psi_s; // (-bi) Eqn (14) with changed sign
+    }
+    return getTreeSolver().solve(d, c, b, bcNodes, bcValues, dirichlet);
+}
+
+/**
+ * The tree solver is created for the current segments, and reused as long as the topology does not change
+ * (e.g. between the iterations of a coupled model, or between time steps without growth)
+ */
+const TreeSolver& XylemFlux::getTreeSolver()
+{
+    int N = rs->nodes.size();
+    if ((!treeSolver) || (!treeSolver->matches(rs->segments, N))) {
+        treeSolver = std::make_shared<TreeSolver>(rs->segments, N);
     }
+    return *treeSolver;
 }
 
+/**
+ * Coefficients of the hybrid solver for a single segment, see Meunier et al. (2017)
+ *
+ * @param si                segment index
+ * @param simTime[day]  	current simulation time, needed for age dependent conductivities
+ * @param sx [cm]			soil matric potential in the cells or around the segments, given per cell or per segment
+ * @param cells 			sx per cell (true), or segments (false)
+ * @param soil_k [day-1]    optionally, soil conductivities can be prescribed per segment
+ * @param bi, cii, cij      [out] coefficients of the segment, Eqns (23)-(25)
+ * @param psi_s             [out] outer water potential [cm]
+ */
+void XylemFlux::segmentCoefficients(int si, double simTime, const std::vector<double>& sx, bool cells, const std::vector<double>& soil_k,
+    bool verbose, double& bi, double& cii, double& cij, double& psi_s) const
+{
+    int i = rs->segments[si].x;
+    int j = rs->segments[si].y;
+
+    psi_s = getPsiOut(cells, si, sx, verbose);
+    double age = simTime - rs->nodeCTs[j];
+    int organType = rs->organTypes[si];
+    int subType = rs->subTypes[si];
+    double kx = 0.;
+    double  kr = 0.;
+
+    try {
+        kx = kx_f(si, age, subType, organType);
+        kr = kr_f_wrapped(si, age, subType, organType, cells);
+    } catch(...) {
+        std::cout << "\n XylemFlux::linearSystem: conductivities failed" << std::flush;
+        std::cout  << "\n organ type "<<organType<< " subtype " << subType <<std::flush;
+    }
+    if (soil_k.size()>0) {
+        kr = std::min(kr, soil_k[si]);
+    }
+
+    auto n1 = rs->nodes[i];
+    auto n2 = rs->nodes[j];
+    auto v = n2.minus(n1);
+    double l = v.length();
+    if (l<1.e-5) {
+        // std::cout << "XylemFlux::linearSystem: warning segment length smaller 1.e-5 \n";
+        l = 1.e-5; // valid quick fix? (also in segFluxes)
+    }
+	double perimeter = rs->getPerimeter(si, l);//perimeter of exchange surface
+    double vz = v.z / l; // normed direction
+
+    if (perimeter * kr>1.e-16) {
+        double tau = std::sqrt(perimeter * kr / kx); // Eqn (6)
+        double delta = std::exp(-tau * l) - std::exp(tau * l); // Eqn (12)
+        double idelta = 1. / delta;
+        cii = -kx * idelta * tau * (std::exp(-tau * l) + std::exp(tau * l)); // Eqn (23)
+        cij = 2 * kx * idelta * tau;  // Eqn 24
+        bi = kx * vz; //  # Eqn 25
+    } else { // solution for a=0, or kr = 0
+        cii = kx/l;
+        cij = -kx/l;
+        bi = kx * vz;
+        psi_s = 0;
+    }
+}
 
 /**
  * Fluxes from root segments into soil cells
@@ -200,7 +268,7 @@ std::map<int,double> XylemFlux::sumSegFluxes(const std::vector<double>& segFluxe
         int j = rs->segments[si].y;
         int segIdx = j-1;
 
-        if (rs->seg2cell.count(segIdx)>0)
+        if (segIdx<rs->seg2cell.size())
 		{
 			int cellIdx = rs->seg2cell[segIdx];
 			if (cellIdx>=0)
@@ -241,10 +309,9 @@ std::vector<double> XylemFlux::splitSoilFluxes(const std::vector<double>& soilFl
     auto lengths =  this->rs->segLength();
     std::vector<double> fluxes = std::vector<double>(rs->segments.size());
     std::fill(fluxes.begin(), fluxes.end(), 0.);
-    auto map = rs->cell2seg;
+    const auto& map = rs->cell2seg;
 	double fluxesTotTot =0;
-    for(auto iter = map.begin(); iter != map.end(); ++iter) {
-        int cellId =  iter->first;
+    for (int cellId : map.cells()) {
         auto segs = map.at(cellId);
 		if (cellId>=0) {
 			double v = 0.;  // calculate sum over cell
@@ -287,7 +354,7 @@ std::vector<double> XylemFlux::splitSoilFluxes(const std::vector<double>& soilFl
 
 
 /**
- * fill the matrices to be solved. Overloaded by @see Photosynthesis::fillVectors
+ * fill the matrices to be solved
  * @param k				index for the row- and column-index vectors
  * @param i, j			indexes of the non-zero elements of the sparse matrix
  * @param psi_s 		outer water potential [cm]
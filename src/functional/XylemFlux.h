@@ -3,6 +3,7 @@
 #define XYLEM_FLUX_H_
 
 #include "MappedOrganism.h"
+#include "TreeSolver.h"
 
 namespace CPlantBox {
 
@@ -24,6 +25,9 @@ public:
 
     void linearSystem(double simTime, const std::vector<double>& sx, bool cells = true,
         const std::vector<double> soil_k = std::vector<double>(), bool verbose = false); ///< builds linear system (simTime is needed for age dependent conductivities)
+    std::vector<double> solve(double simTime, const std::vector<double>& sx, bool cells, const std::vector<int>& bcNodes,
+        const std::vector<double>& bcValues, bool dirichlet = false, const std::vector<double> soil_k = std::vector<double>(),
+        bool verbose = false); ///< solves the linear system on the tree in O(N), without assembling a matrix
 
     std::map<int,double> soilFluxes(double simTime, const std::vector<double>& rx, const std::vector<double>& sx,
     		bool approx = false, const std::vector<double> soil_k = std::vector<double>()); // [cm3/day]
@@ -74,6 +78,12 @@ public:
 
 protected:
 
+    void segmentCoefficients(int si, double simTime, const std::vector<double>& sx, bool cells, const std::vector<double>& soil_k,
+        bool verbose, double& bi, double& cii, double& cij, double& psi_s) const; ///< coefficients of the hybrid solver for segment si
+    const TreeSolver& getTreeSolver(); ///< topology of the current segments, analysed again only if it changed
+
+    std::shared_ptr<TreeSolver> treeSolver; // @see XylemFlux::getTreeSolver
+
 	//type correspond to subtype or to the leaf segment number
     double kr_const(int si,double age, int type, int organType) //k constant
 	{
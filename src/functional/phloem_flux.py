@@ -23,12 +23,12 @@ class PhloemFluxPython(PhloemFlux):
         return np.log(RH) * self.rho_h2o * self.R_ph * (TairC + 237.3)/self.Mh2o * (1/0.9806806)  ; #in cm
      
     def get_nodes(self):
-        """ converts the list of Vector3d to a 2D numpy array """
-        return np.array(list(map(lambda x: np.array(x), self.rs.nodes)))
+        """ nodes as 2D numpy array (copy) """
+        return np.array(self.rs.nodesArray)  # a copy, the view is only valid until the next simulate call
 
     def get_segments(self):
-        """ converts the list of Vector2i to a 2D numpy array """
-        return np.array(list(map(lambda x: np.array(x), self.rs.segments)), dtype = np.int64)
+        """ segments as 2D numpy array """
+        return np.asarray(self.rs.segmentsArray, dtype = np.int64)
 
     def get_ages(self, final_age = 0.):
         """ converts the list of nodeCT to a numpy array of segment ages
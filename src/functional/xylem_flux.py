@@ -154,17 +154,8 @@ class XylemFluxPython(XylemFlux):
             n = len(self.neumann_ind)
             value = [value / n] * n
 
-        if len(soil_k) > 0:
-            self.linearSystem(sim_time, sxx, cells, soil_k)  # C++ (see XylemFlux.cpp)
-        else:
-            self.linearSystem(sim_time, sxx, cells)  # C++ (see XylemFlux.cpp)
-
-        self.Q = sparse.coo_matrix((np.array(self.aV), (np.array(self.aI), np.array(self.aJ))))
-        self.Q = sparse.csc_matrix(self.Q)
-        self.Q, self.b = self.bc_neumann(self.Q, self.aB, self.neumann_ind, value)  # cm3 day-1
-
-        x = LA.spsolve(self.Q, self.b, use_umfpack = True)  # direct
-        return x
+        x = self.solve_cpp(sim_time, sxx, cells, self.neumann_ind, value, False, soil_k)  # C++ tree solver (see XylemFlux::solve)
+        return np.array(x)
 
     def solve_dirichlet(self, sim_time:float, value:list, sxc:float, sxx, cells:bool, soil_k = []):
         """ solves the flux equations, with a dirichlet boundary condtion, see solve()
@@ -181,17 +172,8 @@ class XylemFluxPython(XylemFlux):
             n = len(self.dirichlet_ind)
             value = [value] * n
 
-        if len(soil_k) > 0:
-            self.linearSystem(sim_time, sxx, cells, soil_k)  # C++ (see XylemFlux.cpp)
-        else:
-            self.linearSystem(sim_time, sxx, cells)
-
-        self.Q = sparse.coo_matrix((np.array(self.aV), (np.array(self.aI), np.array(self.aJ))))
-        self.Q = sparse.csc_matrix(self.Q)
-        self.Q, self.b = self.bc_dirichlet(self.Q, self.aB, self.dirichlet_ind, value)
-
-        x = LA.spsolve(self.Q, self.b, use_umfpack = True)
-        return x
+        x = self.solve_cpp(sim_time, sxx, cells, self.dirichlet_ind, value, True, soil_k)  # C++ tree solver (see XylemFlux::solve)
+        return np.array(x)
 
     def solve(self, sim_time:float, trans:list, sx:float, sxx, cells:bool, wilting_point:float, soil_k = []):
         """ solves the flux equations using Neumann and switching to dirichlet in case wilting point is reached in root collar 
@@ -215,10 +197,7 @@ class XylemFluxPython(XylemFlux):
 
             if x[0] <= wilting_point:
 
-                Q = sparse.coo_matrix((np.array(self.aV), (np.array(self.aI), np.array(self.aJ))))
-                Q = sparse.csc_matrix(Q)
-                Q, b = self.bc_dirichlet(Q, self.aB, [0], [float(wilting_point)])
-                x = LA.spsolve(Q, b, use_umfpack = True)
+                x = np.array(self.solve_cpp(sim_time, sxx, cells, [0], [float(wilting_point)], True, soil_k))
                 self.last = "dirichlet"
 
         else:
@@ -322,12 +301,12 @@ class XylemFluxPython(XylemFlux):
         return np.array(self.segFluxes(sim_time, rx, sxx, False, cells, k_soil))  # approx = False
 
     def get_nodes(self):
-        """ converts the list of Vector3d to a 2D numpy array """
-        return np.array(list(map(lambda x: np.array(x), self.rs.nodes)))
+        """ nodes as 2D numpy array (copy) """
+        return np.array(self.rs.nodesArray)  # a copy, the view is only valid until the next simulate call
 
     def get_segments(self):
-        """ converts the list of Vector2i to a 2D numpy array """
-        return np.array(list(map(lambda x: np.array(x), self.rs.segments)), dtype = np.int64)
+        """ segments as 2D numpy array """
+        return np.asarray(self.rs.segmentsArray, dtype = np.int64)
 
     def get_subtypes(self):
         """ segment sub types as numpy array """
@@ -615,7 +594,7 @@ class XylemFluxPython(XylemFlux):
         print("ages from {:g} to {:g}".format(np.min(ages), np.max(ages)))
         # 4 check for unmapped indices
         map = self.rs.seg2cell
-        for seg_id, cell_id in map.items():
+        for seg_id, cell_id in enumerate(map):
             if cell_id < 0:
                 print("Warning: segment ", seg_id, "is not mapped, this will cause problems with coupling!", nodes[segments[seg_id][0]], nodes[segments[seg_id][1]])
         print()
@@ -0,0 +1,127 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#include "Ensemble.h"
+
+#include "organparameter.h"
+#include "SegmentAnalyser.h"
+#include "parallel.h"
+
+#include <stdexcept>
+
+namespace CPlantBox {
+
+/**
+ * @param prototype     an organism with all organ random parameters set (e.g. by Organism::readParameters),
+ *                      the members are deep copies of it. The prototype itself is never simulated.
+ */
+Ensemble::Ensemble(std::shared_ptr<Organism> prototype) :prototype(prototype)
+{
+    if (!prototype) {
+        throw std::invalid_argument("Ensemble::Ensemble: prototype must not be null");
+    }
+}
+
+/**
+ * Adds a member to the ensemble
+ *
+ * @param seed      seed of the random generators of the member (@see Organism::setSeed)
+ * @return          index of the member
+ */
+int Ensemble::addMember(unsigned int seed)
+{
+    seeds.push_back(seed);
+    overrides.push_back(std::vector<Override>());
+    return seeds.size()-1;
+}
+
+/**
+ * Overrides a parameter of the prototype for a single member (@see OrganRandomParameter::setParameter)
+ *
+ * @param member        index of the member
+ * @param organType     organ type of the random parameter
+ * @param subType       sub type of the random parameter
+ * @param name          parameter name
+ * @param value         new value
+ */
+void Ensemble::setParameter(int member, int organType, int subType, std::string name, double value)
+{
+    if ((member<0) || (member>=(int)seeds.size())) {
+        throw std::invalid_argument("Ensemble::setParameter: unknown member "+std::to_string(member));
+    }
+    prototype->getOrganRandomParameter(organType, subType); // throws if the sub type does not exist
+    overrides[member].push_back({ organType, subType, name, value });
+}
+
+/**
+ * Creates all members, initializes and simulates them, and computes the results.
+ *
+ * The members are copied from the prototype on the calling thread.
+ * Initialization, simulation, and the reductions run on Ensemble::threads threads (serial if 0 or 1),
+ * one member at a time per thread. The results do not depend on the number of threads.
+ *
+ * @param simtime       simulation time [day]
+ */
+void Ensemble::run(double simtime)
+{
+    size_t n = seeds.size();
+    size_t ns = summedNames.size();
+    size_t nd = distributionName.empty() ? 0 : distributionLayers;
+
+    members.resize(n);
+    for (size_t i = 0; i<n; i++) { // deep copies, and parameter overrides
+        auto o = prototype->copy();
+        o->setSeed(seeds[i]);
+        for (const auto& p : overrides[i]) {
+            o->getOrganRandomParameter(p.organType, p.subType)->setParameter(p.name, p.value);
+        }
+        members[i] = o;
+    }
+
+    summed.assign(n*ns, 0.);
+    numberOfNodes.assign(n, 0);
+    numberOfOrgans.assign(n, 0);
+    distribution.assign(n*nd, 0.);
+
+    auto simulateMember = [&](size_t i) {
+        auto o = members[i];
+        o->initialize(false);
+        o->simulate(simtime, false);
+        for (size_t j = 0; j<ns; j++) {
+            summed[i*ns+j] = o->getSummed(summedNames[j], summedOrganType);
+        }
+        numberOfNodes[i] = o->getNumberOfNodes();
+        numberOfOrgans[i] = o->getNumberOfOrgans();
+        if (nd>0) {
+            auto d = SegmentAnalyser(*o).distribution(distributionName, distributionTop, distributionBot, distributionLayers, distributionExact);
+            std::copy(d.begin(), d.end(), distribution.begin()+i*nd);
+        }
+        if (!keepMembers) {
+            members[i] = nullptr;
+        }
+    };
+
+    try {
+        parallelFor(n, threads, simulateMember);
+    } catch (...) {
+        if (!keepMembers) {
+            members.clear();
+        }
+        throw;
+    }
+    if (!keepMembers) {
+        members.clear();
+    }
+}
+
+/**
+ * @param i     index of the member
+ * @return      the simulated member, only available if Ensemble::keepMembers was set before Ensemble::run
+ */
+std::shared_ptr<Organism> Ensemble::getMember(int i) const
+{
+    if ((i<0) || (i>=(int)members.size())) {
+        throw std::invalid_argument("Ensemble::getMember: member "+std::to_string(i)+" is not available (keepMembers must be set before run)");
+    }
+    return members[i];
+}
+
+} // namespace
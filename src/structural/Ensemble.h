@@ -0,0 +1,70 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#ifndef ENSEMBLE_H_
+#define ENSEMBLE_H_
+
+#include "Organism.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+
+namespace CPlantBox {
+
+/**
+ * Simulates an ensemble of organisms (e.g. for parameter sweeps, or plants in a field) on several threads.
+ *
+ * All members are deep copies of a prototype (@see Organism::copy), i.e. the parameter files are read only once.
+ * Each member has its own seed, and optionally parameter values that differ from the prototype.
+ * Per member, Ensemble::run computes reduced results, that are stored in dense (row major) arrays,
+ * the members themselves are only kept, if Ensemble::keepMembers is true.
+ */
+class Ensemble
+{
+public:
+
+    Ensemble(std::shared_ptr<Organism> prototype); ///< prototype with all organ random parameters, not initialized
+
+    int addMember(unsigned int seed); ///< adds a member, returns its index
+    void setParameter(int member, int organType, int subType, std::string name, double value); ///< overrides a prototype parameter for a member
+    int getNumberOfMembers() const { return seeds.size(); } ///< number of members
+
+    void run(double simtime); ///< initializes and simulates all members for simtime days, and computes the results
+
+    std::shared_ptr<Organism> getMember(int i) const; ///< the simulated member (if Ensemble::keepMembers)
+
+    /* options */
+    int threads = 0; ///< number of threads (0 or 1 = serial), e.g. std::thread::hardware_concurrency()
+    bool keepMembers = false; ///< keep the simulated members after Ensemble::run
+    std::vector<std::string> summedNames = { "length" }; ///< parameter names for Ensemble::summed, @see Organism::getSummed
+    int summedOrganType = -1; ///< organ type for Ensemble::summed, -1 denotes all organ types
+    std::string distributionName = ""; ///< parameter name of the vertical distribution, @see SegmentAnalyser::distribution (empty for none)
+    double distributionTop = 0.; ///< top of the vertical distribution [cm]
+    double distributionBot = -100.; ///< bottom of the vertical distribution [cm]
+    int distributionLayers = 100; ///< number of layers of the vertical distribution
+    bool distributionExact = false; ///< cut segments at the layer boundaries
+
+    /* results of Ensemble::run */
+    std::vector<double> summed; ///< members x summedNames.size()
+    std::vector<int> numberOfNodes; ///< per member
+    std::vector<int> numberOfOrgans; ///< per member
+    std::vector<double> distribution; ///< members x distributionLayers
+
+protected:
+
+    struct Override {
+        int organType;
+        int subType;
+        std::string name;
+        double value;
+    };
+
+    std::shared_ptr<Organism> prototype;
+    std::vector<unsigned int> seeds; // per member
+    std::vector<std::vector<Override>> overrides; // per member
+    std::vector<std::shared_ptr<Organism>> members;
+
+};
+
+} // namespace
+
+#endif
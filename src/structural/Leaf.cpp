@@ -45,20 +45,21 @@ Leaf::Leaf(std::shared_ptr<Organism> plant, int type, double delay,  std::shared
 {
 	assert(parent!=nullptr && "Leaf::Leaf parent must be set");
 	addleafphytomerID(param()->subType);
-	ageDependentTropism = getLeafRandomParameter()->f_tf->ageSwitch > 0;
+	phytomerId = getleafphytomerID(param()->subType);
+	ageDependentTropism = lrp()->f_tf->ageSwitch > 0;
 	// Calculate the rotation of the leaves. The code begins here needs to be rewritten, because another following project will work on the leaves. The code here is just temporally used to get some nice visualizations. When someone rewrites the code, please take "gimbal lock" into consideration.
 	//Rewritten Begin:
-	beta = getleafphytomerID(param()->subType)*M_PI*getLeafRandomParameter()->rotBeta
-			+ M_PI*plant->rand()*getLeafRandomParameter()->betaDev ;  //+ ; //2 * M_PI*plant->rand(); // initial rotation
-	beta = beta + getLeafRandomParameter()->initBeta*M_PI;
-	if (getLeafRandomParameter()->initBeta >0 && getLeafRandomParameter()->subType==2 && getLeafRandomParameter()->lnf==5 && getleafphytomerID(2)%4==2) {
-		beta = beta + getLeafRandomParameter()->initBeta*M_PI;
-	} else if (getLeafRandomParameter()->initBeta >0 && getLeafRandomParameter()->subType==2 && getLeafRandomParameter()->lnf==5 && getleafphytomerID(2)%4==3) {
-		beta = beta + getLeafRandomParameter()->initBeta*M_PI + M_PI;
+	beta = getleafphytomerID(param()->subType)*M_PI*lrp()->rotBeta
+			+ M_PI*plant->rand()*lrp()->betaDev ;  //+ ; //2 * M_PI*plant->rand(); // initial rotation
+	beta = beta + lrp()->initBeta*M_PI;
+	if (lrp()->initBeta >0 && lrp()->subType==2 && lrp()->lnf==5 && getleafphytomerID(2)%4==2) {
+		beta = beta + lrp()->initBeta*M_PI;
+	} else if (lrp()->initBeta >0 && lrp()->subType==2 && lrp()->lnf==5 && getleafphytomerID(2)%4==3) {
+		beta = beta + lrp()->initBeta*M_PI + M_PI;
 	}
 	double theta = param()->theta;
 	if (parent->organType()!=Organism::ot_seed) { // scale if not a base leaf
-		double scale = getLeafRandomParameter()->f_sa->getValue(parent->getNode(pni), parent);
+		double scale = lrp()->f_sa->getValue(parent->getNode(pni), parent);
 		theta *= scale;
 	}
 	//used when computing actual heading, @see LEaf::getIHeading
@@ -72,7 +73,7 @@ Leaf::Leaf(std::shared_ptr<Organism> plant, int type, double delay,  std::shared
 			//time when stem reached end of basal zone (==CT of parent node of first lateral) + delay
 			// @see stem::leafGrow
 			if (parent->getNumberOfChildren() == 0){creationTime = parent->getNodeCT(pni)+delay;
-			}else{creationTime = parent->getChild(0)->getParameter("creationTime") + delay;}
+			}else{creationTime = parent->getChild(0)->getParameter(pk_creationTime) + delay;}
 		}else{
 			creationTime = parent->getNodeCT(pni)+delay;
 		}
@@ -84,15 +85,18 @@ Leaf::Leaf(std::shared_ptr<Organism> plant, int type, double delay,  std::shared
  * All laterals are deep copied, plant and parent pointers are updated.
  *
  * @param plant     the plant the copied organ will be part of
+ * @param share     share the organ specific parameters (see Organism::fork)
  */
-std::shared_ptr<Organ> Leaf::copy(std::shared_ptr<Organism> p)
+std::shared_ptr<Organ> Leaf::copy(std::shared_ptr<Organism> p, bool share)
 {
 	auto l = std::make_shared<Leaf>(*this); // shallow copy
 	l->parent = std::weak_ptr<Organ>();
 	l->plant = p;
-	l->param_ = std::make_shared<LeafSpecificParameter>(*param()); // copy parameters
+	if (!share) { // a fork shares the parameters (they are constant)
+		l->param_ = std::make_shared<LeafSpecificParameter>(*param()); // copy parameters
+	}
 	for (size_t i=0; i< children.size(); i++) {
-		l->children[i] = children[i]->copy(p); // copy laterals
+		l->children[i] = children[i]->copy(p, share); // copy laterals
 		l->children[i]->setParent(l);
 	}
 	return l;
@@ -123,7 +127,7 @@ void Leaf::simulate(double dt, bool verbose)
 		// probabilistic branching model (todo test)
 		if ((age>0) && (age-dt<=0)) { // the leaf emerges in this time step
 			//currently, does not use absolute coordinates for these function.
-			double P = getLeafRandomParameter()->f_sbp->getValue(nodes.back(),shared_from_this());
+			double P = lrp()->f_sbp->getValue(nodes.back(),shared_from_this());
 			if (P<1.) { // P==1 means the lateral emerges with probability 1 (default case)
 				double p = 1.-std::pow((1.-P), dt); //probability of emergence in this time step
 				if (plant.lock()->rand()>p) { // not rand()<p
@@ -140,6 +144,7 @@ void Leaf::simulate(double dt, bool verbose)
 			}
 
 			if (active) {
+				setChanged(); // a growing leaf changes its shape (see MappedPlant::simulate)
 
 				// length increment
 				double age_ = calcAge(length); // leaf age as if grown unimpeded (lower than real age)
@@ -218,20 +223,22 @@ void Leaf::simulate(double dt, bool verbose)
 /**
  *
  */
-double Leaf::getParameter(std::string name) const {
-	if (name=="shapeType") { return getLeafRandomParameter()->shapeType; } // definition type of the leaf shape
-	if (name=="Width_petiole") { return param()->Width_petiole; } // [cm]
-	if (name=="Width_blade") { return param()->Width_blade; } // [cm]
-	if (name=="lb") { return param()->lb; } // basal zone [cm]
-	if (name=="la") { return param()->la; } // apical zone [cm]
+double Leaf::getParameter(int key) const
+{
+	switch (key) {
+	case pk_shapeType: return lrp()->shapeType; // definition type of the leaf shape
+	case pk_Width_petiole: return param()->Width_petiole; // [cm]
+	case pk_Width_blade: return param()->Width_blade; // [cm]
+	case pk_lb: return param()->lb; // basal zone [cm]
+	case pk_la: return param()->la; // apical zone [cm]
 	//if (name=="nob") { return param()->nob; } // number of branches
-	if (name=="r"){ return param()->r; }  // initial growth rate [cm day-1]
-	if (name=="radius") { return param()->a; } // leaf radius or thickness [cm]
-	if (name=="a") { return param()->a; } // leaf radius or thickness [cm]
-	if (name=="theta") { return param()->theta; } // angle between leaf and parent root [rad]
-	if (name=="rlt") { return param()->rlt; } // leaf life time [day]
-	if (name=="k") { return param()->getK(); }; // maximal leaf length [cm]
-	if (name=="lnMean") { // mean lateral distance [cm]
+	case pk_r: return param()->r;  // initial growth rate [cm day-1]
+	case pk_radius: return param()->a; // leaf radius or thickness [cm]
+	case pk_a: return param()->a; // leaf radius or thickness [cm]
+	case pk_theta: return param()->theta; // angle between leaf and parent root [rad]
+	case pk_rlt: return param()->rlt; // leaf life time [day]
+	case pk_k: return param()->getK(); // maximal leaf length [cm]
+	case pk_lnMean: { // mean lateral distance [cm]
         auto& v =param()->ln;
 		if(v.size()>0){
 			return std::accumulate(v.begin(), v.end(), 0.0) / v.size();
@@ -239,22 +246,23 @@ double Leaf::getParameter(std::string name) const {
 			return 0;
 		}
 	}
-	if (name=="lnDev") { // standard deviation of lateral distance [cm]
+	case pk_lnDev: { // standard deviation of lateral distance [cm]
 		auto& v =param()->ln;
 		double mean = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
 		double sq_sum = std::inner_product(v.begin(), v.end(), v.begin(), 0.0);
 		return std::sqrt(sq_sum / v.size() - mean * mean);
 	}
-	if (name=="volume_th") { return orgVolume(-1, false); } // // theoretical leaf volume [cm^3]
-	if (name=="surface_th") { return leafArea(false); } // // theoretical leaf surface [cm^2]
-	if (name=="volume_realized") { return orgVolume(-1, true); } // // realized leaf volume [cm^3]
-	if (name=="surface_realized") { return leafArea(true); } // // realized leaf surface [cm^2]
-	if (name=="volume") { return orgVolume(-1, true); } // // realized leaf volume [cm^3]
-	if (name=="surface") { return leafArea(true); } // // realized leaf surface [cm^2]
-	if (name=="type") { return this->param_->subType; }  // delete to avoid confusion?
-	if (name=="subType") { return this->param_->subType; }  // organ sub-type [-]
-	if (name=="parentNI") { return parentNI; } // local parent node index where the lateral emerges
-	return Organ::getParameter(name);
+	case pk_volume_th: return orgVolume(-1, false); // // theoretical leaf volume [cm^3]
+	case pk_surface_th: return leafArea(false); // // theoretical leaf surface [cm^2]
+	case pk_volume_realized: return orgVolume(-1, true); // // realized leaf volume [cm^3]
+	case pk_surface_realized: return leafArea(true); // // realized leaf surface [cm^2]
+	case pk_volume: return orgVolume(-1, true); // // realized leaf volume [cm^3]
+	case pk_surface: return leafArea(true); // // realized leaf surface [cm^2]
+	case pk_type: return this->param_->subType;  // delete to avoid confusion?
+	case pk_subType: return this->param_->subType;  // organ sub-type [-]
+	case pk_parentNI: return parentNI; // local parent node index where the lateral emerges
+	default: return Organ::getParameter(key);
+	}
 }
 
 
@@ -274,12 +282,12 @@ double Leaf::leafArea(bool realized, bool withPetiole) const
 	if (param()->laterals) {
 		return 0.;
 	} else {
-		int shapeType = getLeafRandomParameter()->shapeType;
+		int shapeType = lrp()->shapeType;
 		switch(shapeType)
 		{
 			case LeafRandomParameter::shape_cuboid:{
-				double Width_blade = getParameter("Width_blade") ;
-				double Width_petiole = getParameter("Width_petiole") ;
+				double Width_blade = getParameter(pk_Width_blade) ;
+				double Width_petiole = getParameter(pk_Width_petiole) ;
 				if (length_ <= param()->lb) {
 					surfacePetiole =  Width_petiole * length_ ;
 				} else {
@@ -343,9 +351,9 @@ double Leaf::leafAreaAtSeg(int localSegId, bool realized, bool withPetiole)
 	if (param()->laterals) {
 		return 0.;
 	} else {
-		int shapeType = getLeafRandomParameter()->shapeType;
-		auto n1 = nodes.at(localSegId);
-		auto n2 = nodes.at(localSegId + 1);
+		int shapeType = lrp()->shapeType;
+		auto n1 = getNode(localSegId);
+		auto n2 = getNode(localSegId + 1);
 		auto v = n2.minus(n1);
 		double length_ = v.length();
 		double lengthAt_x = getLength(localSegId);
@@ -355,14 +363,14 @@ double Leaf::leafAreaAtSeg(int localSegId, bool realized, bool withPetiole)
 		switch(shapeType)
 		{
 			case LeafRandomParameter::shape_cuboid:{
-				double Width_blade = getParameter("Width_blade") ;
+				double Width_blade = getParameter(pk_Width_blade) ;
 
 				double surfaceBlade =  Width_blade * lengthInBlade ;
 				surface_ =  surfaceBlade ;
 				double surfacePetiole = 0;
 				if(withPetiole)
 				{
-					double Width_petiole = getParameter("Width_petiole") ;
+					double Width_petiole = getParameter(pk_Width_petiole) ;
 					surfacePetiole =   Width_petiole * lengthInPetiole ;
 					surface_ +=  surfacePetiole;
 				}
@@ -408,8 +416,8 @@ double Leaf::leafLengthAtSeg(int localSegId, bool withPetiole)
 	}
 	double length_out = 0.;
 	if (!(param()->laterals)) {
-		auto n1 = nodes.at(localSegId);
-		auto n2 = nodes.at(localSegId + 1);
+		auto n1 = getNode(localSegId);
+		auto n2 = getNode(localSegId + 1);
 		auto v = n2.minus(n1);
 		double length_ = v.length();
 		double lengthAt_x = getLength(localSegId);
@@ -444,27 +452,27 @@ double Leaf::leafVolAtSeg(int localSegId,bool realized, bool withPetiole)
 	if (param()->laterals) {
 		return 0.;
 	} else {
-		int shapeType = getLeafRandomParameter()->shapeType;
-		auto n1 = nodes.at(localSegId);
-		auto n2 = nodes.at(localSegId + 1);
+		int shapeType = lrp()->shapeType;
+		auto n1 = getNode(localSegId);
+		auto n2 = getNode(localSegId + 1);
 		auto v = n2.minus(n1);
 		double length_ = v.length();
 		double lengthAt_x = getLength(localSegId);
 		double lengthInPetiole = std::min(length_,std::max(param()->lb - lengthAt_x,0.));//petiole or sheath
 		double lengthInBlade = std::max(length_ - lengthInPetiole, 0.);
-		double a = getParameter("a") ;//radius or thickness
+		double a = getParameter(pk_a) ;//radius or thickness
 		assert(((lengthInBlade+lengthInPetiole)==length_)&&"leafVolAtSeg: lengthInBlade+lengthInPetiole !=lengthSegment");
 		switch(shapeType)
 		{
 			case LeafRandomParameter::shape_cuboid:{
-				double Width_blade = getParameter("Width_blade") ;
+				double Width_blade = getParameter(pk_Width_blade) ;
 
 				double volBlade =  Width_blade * lengthInBlade *a;
 				vol_ =  volBlade ;
 				double volPetiole = 0;
 				if(withPetiole)
 				{
-					double Width_petiole = getParameter("Width_petiole") ;
+					double Width_petiole = getParameter(pk_Width_petiole) ;
 					volPetiole =   Width_petiole * lengthInPetiole *a;
 					vol_ +=  volPetiole;
 				}
@@ -514,13 +522,13 @@ double Leaf::orgVolume(double length_, bool realized) const
 	}
 	double vol_;
 	const LeafSpecificParameter& p = *param();
-	int shapeType = getLeafRandomParameter()->shapeType;
+	int shapeType = lrp()->shapeType;
 	if(length_ == -1){length_ = getLength(realized);}//theoretical
 	switch(shapeType)
 	{
 		case LeafRandomParameter::shape_cuboid:{
-			double Width_blade = getParameter("Width_blade") ;
-			double Width_petiole = getParameter("Width_petiole") ;
+			double Width_blade = getParameter(pk_Width_blade) ;
+			double Width_petiole = getParameter(pk_Width_petiole) ;
 			if ((p.laterals)||(length_ <= p.lb)) {
 				vol_ =  Width_petiole * length_ * p.a;
 			} else {
@@ -558,12 +566,12 @@ double Leaf::orgVolume2Length(double volume_)
 	}
 	const LeafSpecificParameter& p = *param();
 	double length_;
-	int shapeType = getLeafRandomParameter()->shapeType;
+	int shapeType = lrp()->shapeType;
 	switch(shapeType)
 		{
 			case LeafRandomParameter::shape_cuboid:{
-				double Width_blade = getParameter("Width_blade") ;
-				double Width_petiole = getParameter("Width_petiole") ;
+				double Width_blade = getParameter(pk_Width_blade) ;
+				double Width_petiole = getParameter(pk_Width_petiole) ;
 				double volPetiole = Width_petiole * p.lb * p.a;//assume p.a is thickness
 				if(volume_ <= volPetiole){
 					length_ = volume_/( Width_petiole * p.a);//assume p.a is thickness
@@ -605,7 +613,7 @@ bool Leaf::nodeLeafVis(double l)
  * Parameterization x value, at position l along the leaf axis
  */
 std::vector<double> Leaf::getLeafVisX_(double l) {
-	auto& lg = getLeafRandomParameter()->leafGeometry;
+	auto& lg = lrp()->leafGeometry;
 	int n = lg.size();
 	int ind = int( ((l - param()->lb) /leafLength())*(n-1) + 0.5); // index within precomputed normalized geometry
 	auto x_ = lg.at(ind); // could be more than one point for non-convex geometries
@@ -628,7 +636,7 @@ std::vector<Vector3d> Leaf::getLeafVis(int i)
 {
 	double l = getLength(i);
 	if (nodeLeafVis(l)) {
-		auto& lg = getLeafRandomParameter()->leafGeometry;
+		auto& lg = lrp()->leafGeometry;
 		int n = lg.size();
 		if (n>0) {
 			std::vector<Vector3d> coords;
@@ -665,7 +673,7 @@ std::vector<Vector3d> Leaf::getLeafVis(int i)
 double Leaf::calcLength(double age)
 {
 	assert(age>=0  && "Leaf::calcLength() negative root age");
-	return getLeafRandomParameter()->f_gf->getLength(age,getLeafRandomParameter()->r,param()->getK(),shared_from_this());
+	return lrp()->f_gf->getLength(age,lrp()->r,param()->getK(),shared_from_this());
 }
 
 /**
@@ -676,7 +684,7 @@ double Leaf::calcLength(double age)
 double Leaf::calcAge(double length) const
 {
 	assert(length>=0 && "Leaf::calcAge() negative root length");
-	return getLeafRandomParameter()->f_gf->getAge(length,getLeafRandomParameter()->r,param()->getK(),shared_from_this());
+	return lrp()->f_gf->getAge(length,lrp()->r,param()->getK(),shared_from_this());
 }
 
 /**
@@ -684,7 +692,7 @@ double Leaf::calcAge(double length) const
  */
 void Leaf::minusPhytomerId(int subtype)
 {
-	getPlant()->leafphytomerID[subtype]--;
+	leafphytomerIDs()[subtype]--;
 }
 
 /**
@@ -692,7 +700,7 @@ void Leaf::minusPhytomerId(int subtype)
  */
 int Leaf::getleafphytomerID(int subtype)
 {
-	return getPlant()->leafphytomerID[subtype];
+	return leafphytomerIDs()[subtype];
 }
 
 /**
@@ -700,7 +708,48 @@ int Leaf::getleafphytomerID(int subtype)
  */
 void Leaf::addleafphytomerID(int subtype)
 {
-	getPlant()->leafphytomerID.at(subtype)++;
+	leafphytomerIDs().at(subtype)++;
+}
+
+/**
+ * The phytomer counters per sub type, of the plant (@see Plant::leafphytomerID), or of the growth task (@see GrowthTask)
+ */
+std::vector<int>& Leaf::leafphytomerIDs()
+{
+	auto t = Organism::growthTask;
+	return t ? t->leafphytomerID : getPlant()->leafphytomerID;
+}
+
+/**
+ * The part of the rotation beta (see Leaf::Leaf) that depends on the phytomer id @param id
+ */
+double Leaf::phytomerBeta(int id) const
+{
+	double b = id*M_PI*lrp()->rotBeta;
+	if (lrp()->initBeta >0 && lrp()->subType==2 && lrp()->lnf==5 && id%4==2) {
+		b += lrp()->initBeta*M_PI;
+	} else if (lrp()->initBeta >0 && lrp()->subType==2 && lrp()->lnf==5 && id%4==3) {
+		b += lrp()->initBeta*M_PI + M_PI;
+	}
+	return b;
+}
+
+/**
+ * Within a growth task the phytomer id is counted from zero, afterwards @param leafShift (per sub type) is added
+ * to make it plant-wide. The leaf is rotated around its parent by the resulting change of beta.
+ * Only leaves created in the time step (i.e. with an organ id larger than @param organBase) are shifted
+ * (@see Organism::simulateOrgans).
+ */
+void Leaf::shiftPhytomerIds(int organBase, const std::vector<int>& leafShift, const std::vector<int>& stemShift)
+{
+	int shift = leafShift.at(param()->subType);
+	if ((id>organBase) && (shift!=0)) {
+		double db = phytomerBeta(phytomerId+shift)-phytomerBeta(phytomerId);
+		phytomerId += shift;
+		beta += db;
+		partialIHeading = Matrix3d::rotX(db).times(partialIHeading); // rotAB(theta, beta+db)
+	}
+	Organ::shiftPhytomerIds(organBase, leafShift, stemShift);
 }
 
 /**
@@ -739,7 +788,7 @@ std::string Leaf::toString() const
 Vector3d Leaf::heading(int n ) const
 {
 
-	bool pseudostem = getLeafRandomParameter()->isPseudostem; //do the sheath make a pseudostem?
+	bool pseudostem = lrp()->isPseudostem; //do the sheath make a pseudostem?
 	bool isBlade = (getLength(n) - param()->lb > -1e-10); //current node in blade
 	bool previousIsBlade = (getLength(n - 1) - param()->lb > -1e-10); //previous node in blade
 	bool firstBladeNode = (isBlade && (!previousIsBlade));//is the first node of the blade zone?
@@ -785,11 +834,12 @@ Vector3d Leaf::getIncrement(const Vector3d& p, double sdx, int n)
 
     Vector3d h = heading(n);
     Matrix3d ons = Matrix3d::ons(h);
-	bool isPseudoStem = getParameter("isPseudostem");
-	bool isSheath = ( getLength(n) - getParameter("lb") < -1e-10);
-	if(isPseudoStem && isSheath){getLeafRandomParameter()->f_tf->setSigma(0.);}
-    Vector2d ab = getLeafRandomParameter()->f_tf->getHeading(p, ons, dx(), shared_from_this(), n+1);
-	if(isPseudoStem && isSheath){getLeafRandomParameter()->f_tf->setSigma(getLeafRandomParameter()->tropismS);}
+	bool isPseudoStem = lrp()->isPseudostem; // per node, do not look up the parameter by name
+	bool isSheath = ( getLength(n) - getParameter(pk_lb) < -1e-10);
+	Vector2d ab(0., 0.); // the sheath of a pseudostem grows straight (like a tropism with sigma = 0)
+	if(!(isPseudoStem && isSheath)){ // the tropism is shared by the leaves of this type, do not change its sigma
+		ab = lrp()->f_tf->getHeading(p, ons, dx(), shared_from_this(), n+1);
+	}
 	//for leaves: necessary?
 	//Vector2d ab = getLeafRandomParameter()->f_tf->getHeading(p, ons, dx(),shared_from_this());
     Vector3d sv = ons.times(Vector3d::rotAB(ab.x,ab.y));
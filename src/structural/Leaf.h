@@ -28,7 +28,7 @@ public:
 	Leaf(std::shared_ptr<Organism> plant, int type, double delay, std::shared_ptr<Organ> parent, int pni); ///< used within simulation
 	virtual ~Leaf() { };
 
-	std::shared_ptr<Organ> copy(std::shared_ptr<Organism> plant) override;   ///< deep copies the root tree
+	std::shared_ptr<Organ> copy(std::shared_ptr<Organism> plant, bool share = false) override;   ///< deep copies the root tree
 
 	int organType() const override { return Organism::ot_leaf; } ///< returns the organs type
 
@@ -36,7 +36,8 @@ public:
 
     Vector3d getNode(int i) const override { return nodes.at(i); } ///< i-th node of the organ
 
-	double getParameter(std::string name) const override; ///< returns an organ parameter of Plant::ScalarType
+	using Organ::getParameter;
+	double getParameter(int key) const override; ///< returns an organ parameter, by its key (@see Organ::parameterKey)
 
 	/* leaf vizualisation */
     double leafLength( bool realized = false) const { return std::max(getLength(realized)-param()->lb, 0.); /* represents the leaf base*/ }; ///< leaf surface length [cm]
@@ -64,15 +65,20 @@ public:
 	double orgVolume(double length_ = -1.,  bool realized = false) const override;
 	double orgVolume2Length(double volume_) override;	
 	bool nodeLeafVis(double l); ///<  leaf base (false), branched leaf (false), or leaf surface area (true)
+	void shiftPhytomerIds(int organBase, const std::vector<int>& leafShift, const std::vector<int>& stemShift) override; ///< shifts the phytomer id, and rotates the leaf accordingly
 
 protected:
 
+	LeafRandomParameter* lrp() const { return static_cast<LeafRandomParameter*>(orp()); } ///< cached leaf type parameter, see Organ::orp
 	Vector3d getIncrement(const Vector3d& p, double sdx, int n = -1) override; ///< called by createSegments, to determine growth direction
     Vector3d heading(int n)  const override; ///< current (absolute) heading of the organs at node n
     int getleafphytomerID(int subtype);
     void minusPhytomerId(int subtype);
     void addleafphytomerID(int subtype);
+    std::vector<int>& leafphytomerIDs(); ///< phytomer counters of the plant, or of the growth task
+    double phytomerBeta(int id) const; ///< part of the rotation beta that depends on the phytomer id
 	double beta;
+	int phytomerId = 0; ///< phytomer id within the sub type (@see Leaf::phytomerBeta)
 
   
   
@@ -9,6 +9,84 @@
 
 namespace CPlantBox {
 
+/**
+ * Rebuilds the mapper by a counting sort of the segment indices by their cells, O(segments + cells)
+ *
+ * @param seg2cell      soil cell index per segment index (MappedSegments::notMapped entries are skipped)
+ */
+void Cell2SegMapper::build(const std::vector<int>& seg2cell)
+{
+	int maxCell = -1;
+	for (int c : seg2cell) {
+		maxCell = std::max(maxCell, c);
+	}
+	offsets.assign(maxCell+3, 0); // cells -1 ... maxCell
+	for (int c : seg2cell) {
+		if (c>=-1) {
+			offsets[c+2]++;
+		}
+	}
+	for (size_t i=1; i<offsets.size(); i++) {
+		offsets[i] += offsets[i-1];
+	}
+	segments.resize(offsets.back());
+	std::vector<int> next(offsets.begin(), offsets.end()-1);
+	for (size_t si=0; si<seg2cell.size(); si++) {
+		int c = seg2cell[si];
+		if (c>=-1) {
+			segments[next[c+1]++] = si;
+		}
+	}
+}
+
+/**
+ * @return 1 if the cell @param cellIdx contains segments, else 0
+ */
+size_t Cell2SegMapper::count(int cellIdx) const
+{
+	if ((cellIdx<-1) || (cellIdx+2>=int(offsets.size()))) {
+		return 0;
+	}
+	return (offsets[cellIdx+2]>offsets[cellIdx+1]) ? 1 : 0;
+}
+
+/**
+ * @return the segment indices within the cell @param cellIdx
+ */
+Cell2SegMapper::Segments Cell2SegMapper::at(int cellIdx) const
+{
+	if (count(cellIdx)==0) {
+		throw std::out_of_range("Cell2SegMapper::at: cell "+std::to_string(cellIdx)+" contains no segments");
+	}
+	return Segments{ segments.data()+offsets[cellIdx+1], segments.data()+offsets[cellIdx+2] };
+}
+
+/**
+ * @return the indices of all cells containing segments (including -1, if there are segments outside of the soil)
+ */
+std::vector<int> Cell2SegMapper::cells() const
+{
+	std::vector<int> c;
+	for (int i=0; i+1<int(offsets.size()); i++) {
+		if (offsets[i+1]>offsets[i]) {
+			c.push_back(i-1);
+		}
+	}
+	return c;
+}
+
+/**
+ * @return the number of cells containing segments
+ */
+size_t Cell2SegMapper::size() const
+{
+	size_t n = 0;
+	for (size_t i=0; i+1<offsets.size(); i++) {
+		n += (offsets[i+1]>offsets[i]) ? 1 : 0;
+	}
+	return n;
+}
+
 /**
  * A static plant, as needed for flux computations, represented as
  *
@@ -99,6 +177,7 @@ void MappedSegments::setSubTypes(int t) {
  */
 void MappedSegments::setSoilGrid(const std::function<int(double,double,double)>& s, Vector3d min, Vector3d max, Vector3d res, bool cut) {
 	soil_index = s;
+	soil_indices = nullptr; // setRectangularGrid maps the segments with soilIndices, which prefers soil_indices
 	this->setRectangularGrid(min,max,res, cut);
 	this->setSoilGrid(s);
 }
@@ -110,6 +189,24 @@ void MappedSegments::setSoilGrid(const std::function<int(double,double,double)>&
  */
 void MappedSegments::setSoilGrid(const std::function<int(double,double,double)>& s) {
 	soil_index = s;
+	soil_indices = nullptr;
+	seg2cell.clear(); // re-map all segments
+	cell2seg.clear();
+	mapSegments(segments);
+}
+
+/**
+ * Sets a batched soil cell index call back function, resets and updates the mappers.
+ * The points of all segments that are mapped in one step are passed in a single call,
+ * which avoids a call per segment, e.g. if the soil model is written in Python.
+ *
+ * soil_index is set to a call back picking a single point with @param s.
+ *
+ * @param s 		the callback function takes spatial coordinates [cm] and returns the indices of the cells [1]
+ */
+void MappedSegments::setSoilIndices(const std::function<std::vector<int>(const std::vector<Vector3d>&)>& s) {
+	soil_indices = s;
+	soil_index = [this](double x, double y, double z) { return soil_indices({ Vector3d(x,y,z) }).at(0); };
 	seg2cell.clear(); // re-map all segments
 	cell2seg.clear();
 	mapSegments(segments);
@@ -151,17 +248,29 @@ void MappedSegments::setRectangularGrid(Vector3d min, Vector3d max, Vector3d res
  * @param segs      the (new) segments that need to be mapped
  */
 void MappedSegments::mapSegments(const std::vector<Vector2i>& segs) {
+	mapSeg2cell(segs);
+	if (!segs.empty()) {
+		cell2seg.build(seg2cell);
+	}
+}
+
+/**
+ * Updates seg2cell for the segments @param segs, cell2seg is not updated (@see Cell2SegMapper::build).
+ * Used to change the mappers in several steps, followed by a single rebuild of cell2seg.
+ */
+void MappedSegments::mapSeg2cell(const std::vector<Vector2i>& segs) {
+	std::vector<Vector3d> mids;
+	mids.reserve(segs.size());
 	for (auto& ns : segs) {
-	    //std::cout<< "mapSegments():"<< ns.x <<", " << ns.y << "\n" << std::flush;
-		Vector3d mid = (nodes[ns.x].plus(nodes[ns.y])).times(0.5);
-		int cellIdx = soil_index(mid.x,mid.y,mid.z);
-		int segIdx = ns.y-1; // this is unique in a tree like structured
-		seg2cell[segIdx] = cellIdx;
-		if (cell2seg.count(cellIdx)>0) {
-			cell2seg[cellIdx].push_back(segIdx);
-		} else {
-			cell2seg[cellIdx] = std::vector<int>({segIdx});
+		mids.push_back((nodes[ns.x].plus(nodes[ns.y])).times(0.5));
+	}
+	auto cells = soilIndices(mids); // all segments at once
+	for (size_t i=0; i<segs.size(); i++) {
+		int segIdx = segs[i].y-1; // this is unique in a tree like structured
+		if (segIdx>=int(seg2cell.size())) {
+			seg2cell.resize(segIdx+1, notMapped);
 		}
+		seg2cell[segIdx] = cells[i];
 	}
 }
 
@@ -173,15 +282,32 @@ void MappedSegments::cutSegments() {
 	assert(segments.size()==subTypes.size() && "MappedSegments::addSegments: number of segments and subTypes disagree!");
 	assert(segments.size()==organTypes.size() && "MappedSegments::addSegments: number of segments and organTypes disagree!");
 	int n = segments.size(); // segs.size() will change within the loop (recursive implementation)
+	std::vector<Vector3d> points; // mid, and end points of all segments
+	points.reserve(3*n);
+	for (int i=0; i<n; i++ ) {
+		Vector3d n1 = nodes[segments[i].x];
+		Vector3d n2 = nodes[segments[i].y];
+		points.push_back((n1.plus(n2)).times(0.5));
+		points.push_back(n1);
+		points.push_back(n2);
+	}
+	auto cells = soilIndices(points);
 	for (int i=0; i<n; i++ ) {
-		addSegment(segments[i], radii[i], subTypes[i], organTypes[i], i);
+		int im = cells[3*i]; // cell indices
+		if ((im!=cells[3*i+1]) || (im!=cells[3*i+2])) { // otherwise, don't cut
+			addSegment(segments[i], radii[i], subTypes[i], organTypes[i], i);
+		}
 	}
 }
 
 /**
  * Adds and cuts a single segment at index @param ii. If the segment is cut, appends the remaining segments.
- * Used by cutSegments
- * This approach may run into problems if a segment is located exactly along a face.
+ * Used by cutSegments, for the segments with mid and end points in different cells
+ *
+ * The segment is cut at all faces of the rectangular grid it crosses, which are computed analytically in a single pass.
+ * The grid is continued beyond the domain [minBound, maxBound], i.e. segments outside of the domain are cut as well
+ * (e.g. for a periodic soil_index), and each of the resulting segments lies within a single cell.
+ * Cuts that would create segments shorter than eps are omitted.
  *
  * @param ns 		the segment to add and cut
  * @param r 		segment radius [cm]
@@ -192,72 +318,40 @@ void MappedSegments::cutSegments() {
 void MappedSegments::addSegment(Vector2i ns, double r,  int st, int ot, int ii) {
 	Vector3d n1 = nodes[ns.x];
 	Vector3d n2 = nodes[ns.y];
-	Vector3d mid = (n1.plus(n2)).times(0.5);
-	int im = soil_index(mid.x,mid.y,mid.z); // cell indices
-	int in1 = soil_index(n1.x,n1.y,n1.z);
-	int in2 = soil_index(n2.x,n2.y,n2.z);
-	if ((im!=in1) || (im!=in2)) { // cut
-		// build SDF
-		auto width = maxBound.minus(minBound); // construct sdf
-		Vector3d dx(width.x/resolution.x, width.y/resolution.y, width.z/resolution.z);
-		auto mid0 = mid.minus(minBound);
-		int x = std::floor(mid0.x/dx.x);
-		int y = std::floor(mid0.y/dx.y);
-		int z = std::floor(mid0.z/dx.z);
-		SDF_Cuboid sdf; // create a signed distance function for cutting
-		Vector3d minB(x*dx.x, y*dx.y, z*dx.z);
-		minB = minB.plus(minBound);
-		Vector3d maxB((x+1)*dx.x, (y+1)*dx.y, (z+1)*dx.z);
-		maxB = maxB.plus(minBound);
-		sdf.min = minB;
-		sdf.max = maxB;
-		// std::cout << minB.toString() << ", " << maxB.toString() << ", width " << width.toString() << ", " << sdf.min.toString() << ", " << sdf.max.toString() << "\n";
-
-		im = sdf.getDist(mid)>0; // redo indices, since accuracy of pickking may differ
-		in1 = sdf.getDist(n1)>0;
-		in2 = sdf.getDist(n2)>0;
-		if ((im!=in1) || (im!=in2)) {
-			Vector3d cPoint;
-			if (im==in1) { // is one node at mid (sort accordingly)
-				// std::cout << "n1 " << sdf.getDist(n1) << " mid " << sdf.getDist(mid) << " n2 " << sdf.getDist(n2) << ",indices "<< in1 << ", " << im << ", " << in2 << "\n";
-				if (sdf.getDist(n2)<0) {
-					cPoint = SegmentAnalyser::cut(n2, mid, std::make_shared<SDF_Cuboid>(sdf), eps);
-				} else {
-					cPoint = SegmentAnalyser::cut(mid, n2, std::make_shared<SDF_Cuboid>(sdf), eps);
-				}
-				nodeCTs.push_back(nodeCTs[ns.y]); // todo: we might linearly interpolate
-			} else if (im==in2) {
-				// std::cout << "n2 " << sdf.getDist(n2) << " mid " << sdf.getDist(mid) << " n1 " << sdf.getDist(n1) << ", " << in2 << ", " << im << ", " << in1 << "\n";
-				if (sdf.getDist(n1)<0) {
-					cPoint = SegmentAnalyser::cut(n1, mid, std::make_shared<SDF_Cuboid>(sdf), eps);
-				} else {
-					cPoint = SegmentAnalyser::cut(mid, n1, std::make_shared<SDF_Cuboid>(sdf), eps);
-				}
-				nodeCTs.push_back(nodeCTs[ns.x]); // todo: we might linearly interpolate
-			} else { // otherwise split in mid, use cutSegments on those
-				cPoint = mid;
-				nodeCTs.push_back(0.5*(nodeCTs[ns.x]+nodeCTs[ns.y]));
-			}
-			// std::cout << "[" << n1.toString() << n2.toString() << "] -> [" << nodes[ns.x].toString() << ", " << nodes.back().toString() << "], ["<< nodes.back().toString() << ", " << n2.toString() << "], " << "\n";
-			nodes.push_back(cPoint);
-			Vector2i s1(ns.x, nodes.size()-1);
-			Vector2i s2(nodes.size()-1, ns.y);
-			if ((length(s1)<eps) ||  (length(s2)<eps)) { // if the cut segments are too small, just give up
-				add(ns, r, st, ot, ii);
-				nodes.pop_back(); // remove cPoint
-				nodeCTs.pop_back();
-			} else {
-				addSegment(s1, r, st , ot, ii); // first segment replaces at index ii
-				addSegment(s2, r, st , ot, -1); // append second segment
+	const double p0[3] = { n1.x, n1.y, n1.z };
+	const double d[3] = { n2.x-n1.x, n2.y-n1.y, n2.z-n1.z };
+	const double lo[3] = { minBound.x, minBound.y, minBound.z };
+	const double h[3] = { (maxBound.x-minBound.x)/resolution.x, (maxBound.y-minBound.y)/resolution.y, (maxBound.z-minBound.z)/resolution.z };
+	std::vector<double> t; // segment parameters of the faces within the segment, with unbounded face indices
+	for (int k=0; k<3; k++) {
+		if (d[k]!=0.) {
+			double s0 = (p0[k]-lo[k])/h[k];
+			double s1 = (p0[k]+d[k]-lo[k])/h[k];
+			int jmin = int(std::floor(std::min(s0, s1)))+1;
+			int jmax = int(std::ceil(std::max(s0, s1)))-1;
+			for (int j=jmin; j<=jmax; j++) {
+				t.push_back((lo[k]+j*h[k]-p0[k])/d[k]);
 			}
-		} else { // im==in1==in2, dont't cut
-			// std::cout << "ok " << ii <<": (" << ns.x <<", " << ns.y << ") [" << n1.toString() <<", "<< n2.toString() <<"\n";
-			add(ns, r, st, ot, ii);
 		}
-	} else { // im==in1==in2, dont't cut
-		// std::cout << "ok " << ii <<": (" << ns.x <<", " << ns.y << ") [" << n1.toString() <<", "<< n2.toString() <<"\n";
-		add(ns, r, st, ot, ii);
 	}
+	std::sort(t.begin(), t.end());
+	std::vector<double> cuts; // segment parameters of the cutting points
+	double l = n2.minus(n1).length();
+	double last = 0.;
+	for (size_t i=0; i<t.size(); i++) {
+		if (((t[i]-last)*l>=eps) && ((1.-t[i])*l>=eps)) { // if the cut segments are too small, skip the cut
+			cuts.push_back(t[i]);
+			last = t[i];
+		}
+	}
+	int x = ns.x;
+	for (size_t i=0; i<cuts.size(); i++) {
+		nodes.push_back(n1.plus(n2.minus(n1).times(cuts[i])));
+		nodeCTs.push_back(nodeCTs[ns.x]+cuts[i]*(nodeCTs[ns.y]-nodeCTs[ns.x])); // linearly interpolated
+		add(Vector2i(x, nodes.size()-1), r, st, ot, (i==0) ? ii : -1); // first segment replaces at index ii
+		x = nodes.size()-1;
+	}
+	add(Vector2i(x, ns.y), r, st, ot, cuts.empty() ? ii : -1); // append the last segment
 }
 
 /**
@@ -291,32 +385,16 @@ double MappedSegments::length(const Vector2i& s) const {
 }
 
 /**
- * Removes segments @param segs from the mappers
+ * Removes segments @param segs from seg2cell, cell2seg is not updated (@see Cell2SegMapper::build)
  */
 void MappedSegments::unmapSegments(const std::vector<Vector2i>& segs) {
 	for (auto& ns : segs) {
-		int cellIdx = -1;
 		int segIdx = ns.y-1;
-		if (seg2cell.count(segIdx)>0) { // remove from seg2cell
-			cellIdx = seg2cell[segIdx];
-			auto it = seg2cell.find(segIdx);
-			seg2cell.erase(it);
+		if ((segIdx>=0) && (segIdx<int(seg2cell.size())) && (seg2cell[segIdx]!=notMapped)) { // remove from seg2cell
+			seg2cell[segIdx] = notMapped;
 		} else {
 			throw std::invalid_argument("MappedSegments::removeSegments: warning segment index "+ std::to_string(segIdx)+ " was not found in the seg2cell mapper");
 		}
-		if (cell2seg.count(cellIdx)>0) {
-			auto& csegs= cell2seg[cellIdx];
-			int c = 0;
-			for (int i=0; i<csegs.size(); i++) {
-				if (csegs[i] == segIdx) {
-					csegs.erase(csegs.begin() + c, csegs.begin() + c + 1);
-					break; // inner for
-				}
-				c++;
-			}
-		} else {
-			throw std::invalid_argument("MappedSegments::removeSegments: warning cell index "+ std::to_string(cellIdx)+ " was not found in the cell2seg mapper");
-		}
 	}
 }
 
@@ -325,7 +403,7 @@ void MappedSegments::unmapSegments(const std::vector<Vector2i>& segs) {
 /**
  * Maps a point into a cell and return the cells linear index (for a equidistant rectangular domain)
  */
-int MappedSegments::soil_index_(double x, double y, double z) {
+int MappedSegments::soil_index_(double x, double y, double z) const {
 	Vector3d p(x,y,z);
 	std::array<double,3>  r = { resolution.x, resolution.y, resolution.z};
 	auto w = maxBound.minus(minBound);
@@ -339,6 +417,51 @@ int MappedSegments::soil_index_(double x, double y, double z) {
 	return std::floor(i[2]) * r[0] * r[1] + std::floor(i[1]) * r[0] + std::floor(i[0]); // a linear index not periodic
 }
 
+/**
+ * Maps multiple points into cells, and returns the cells linear indices (-1 for points out of the domain)
+ *
+ * Uses the batched call back soil_indices if set, otherwise soil_index per point. For the default rectangular grid
+ * (@see MappedSegments::setRectangularGrid) the indices are computed directly, without a call per point.
+ *
+ * @param points 	spatial coordinates [cm]
+ * @return 			the cell index of each point [1]
+ */
+std::vector<int> MappedSegments::soilIndices(const std::vector<Vector3d>& points) const {
+	if (points.empty()) {
+		return std::vector<int>();
+	}
+	if (soil_indices) {
+		auto cells = soil_indices(points);
+		if (cells.size()!=points.size()) {
+			throw std::invalid_argument("MappedSegments::soilIndices: call back returned "+std::to_string(cells.size())+
+				" cell indices for "+std::to_string(points.size())+" points");
+		}
+		return cells;
+	}
+	std::vector<int> cells(points.size());
+	auto rect = soil_index.target<RectangularGridIndex>();
+	if (rect!=nullptr) { // same as soil_index_
+		const MappedSegments* g = rect->ms;
+		std::array<double,3>  r = { g->resolution.x, g->resolution.y, g->resolution.z};
+		auto w = g->maxBound.minus(g->minBound);
+		for (size_t j=0; j<points.size(); j++) {
+			auto p0 = points[j].minus(g->minBound);
+			std::array<double,3> i = { p0.x/w.x*r[0], p0.y/w.y*r[1], p0.z/w.z*r[2] };
+			if ((i[0] < 0) || (i[0] >= r[0]) || (i[1] < 0) || (i[1] >= r[1]) || (i[2] < 0) || (i[2] >= r[2])) {
+				cells[j] = -1; // point is out of domain
+			} else {
+				cells[j] = std::floor(i[2]) * r[0] * r[1] + std::floor(i[1]) * r[0] + std::floor(i[0]); // a linear index not periodic
+			}
+		}
+	} else {
+		for (size_t j=0; j<points.size(); j++) {
+			const auto& p = points[j];
+			cells[j] = soil_index(p.x,p.y,p.z);
+		}
+	}
+	return cells;
+}
+
 /**
  * Sorts the segments, so that the segment index == second node index -1 (unique mapping in a tree)
  */
@@ -378,8 +501,7 @@ std::vector<double> MappedSegments::segOuterRadii(int type, const std::vector<do
 	auto width = maxBound.minus(minBound);
 	std::vector<double> outer_radii = std::vector<double>(segments.size());
 	std::fill(outer_radii.begin(), outer_radii.end(), 0.);
-	for(auto iter = cell2seg.begin(); iter != cell2seg.end(); ++iter) {
-		int cellId =  iter->first;
+	for (int cellId : cell2seg.cells()) {
 		if (vols.size()==0) {
 			cellVolume = width.x*width.y*width.z/resolution.x/resolution.y/resolution.z;
 		} else {
@@ -439,7 +561,7 @@ std::vector<double> MappedSegments::getHs(const std::vector<double>& sx) {
     double psi_air = -954378;
     std::vector<double> hs = std::vector<double>(this->segments.size());
     for (int si = 0; si<this->segments.size(); si++) {
-        int cellIndex = this->seg2cell[si];
+        int cellIndex = this->seg2cell.at(si);
         if (cellIndex>=0) {
             if(sx.size()>1) {
                 hs[si] = sx.at(cellIndex);
@@ -460,12 +582,11 @@ std::vector<int> MappedSegments::getSegmentMapper() const {
     std::vector<int> mapper = std::vector<int>(segments.size());
     for (int i=0; i<mapper.size(); i++) {
 
-        try {
-            mapper[i] = seg2cell.at(i);
-        } catch(...) {
+        if ((i>=seg2cell.size()) || (seg2cell[i]==notMapped)) {
             std::cout << "MappedSegments::getSegmentMapper(): Index "<< i << " not mapped\n" << std::flush;
-            throw;
+            throw std::out_of_range("MappedSegments::getSegmentMapper(): segment index "+std::to_string(i)+" not mapped");
         }
+        mapper[i] = seg2cell[i];
 
     }
     return mapper;
@@ -556,40 +677,29 @@ void MappedRootSystem::initialize_(int basaltype, int shootbornetype, bool verbo
  */
 void MappedRootSystem::simulate(double dt, bool verbose)
 {
-	if (soil_index==nullptr) {
+	if ((soil_index==nullptr) && (soil_indices==nullptr)) {
 		throw std::invalid_argument("MappedRootSystem::simulate():soil was not set, use MappedRootSystem::simulate::setSoilGrid" );
 	}
 
 	RootSystem::simulate(dt,verbose);
 
-	auto uni = this->getUpdatedNodeIndices(); // move nodes
-	auto unodes = this->getUpdatedNodes();
-    auto uncts = this->getUpdatedNodeCTs();
-	assert(uni.size()==unodes.size() && "updated node indices and number of nodes must be equal");
-	int c = 0;
-	for (int i : uni) {
-		nodes.at(i) = unodes[c];
-		nodeCTs.at(i) = uncts[c];
-		c++;
+	const auto& delta = this->getStepDelta(); // visits the organs that changed
+	const auto& uni = delta.movedNodeIds; // move nodes
+	assert(uni.size()==delta.movedNodes.size() && "updated node indices and number of nodes must be equal");
+	for (int c = 0; c<uni.size(); c++) {
+		nodes.at(uni[c]) = delta.movedNodes[c];
+		nodeCTs.at(uni[c]) = delta.movedNodeCTs[c];
 	}
 	if (verbose) {
 		std::cout << "nodes moved "<< uni.size() << "\n" << std::flush;
 	}
-	auto newnodes = this->getNewNodes(); // add nodes
-	nodes.reserve(nodes.size()+newnodes.size());
-	for (auto& nn : newnodes) {
-		nodes.push_back(nn);
-	}
-	auto newnode_cts = this->getNewNodeCTs(); // add node cts
-	nodeCTs.reserve(nodeCTs.size()+newnode_cts.size());
-	for (auto& nct : newnode_cts) {
-		nodeCTs.push_back(nct);
-	}
+	nodes.insert(nodes.end(), delta.newNodes.begin(), delta.newNodes.end()); // add nodes
+	nodeCTs.insert(nodeCTs.end(), delta.newNodeCTs.begin(), delta.newNodeCTs.end()); // add node cts
 	if (verbose) {
-		std::cout << "new nodes added " << newnodes.size() << "\n" << std::flush;
+		std::cout << "new nodes added " << delta.newNodes.size() << "\n" << std::flush;
 	}
 
-	auto newsegs = this->getNewSegments(); // add segments (TODO cutting)
+	const auto& newsegs = delta.newSegments; // add segments (TODO cutting)
 	segments.resize(segments.size()+newsegs.size());
 	for (auto& ns : newsegs) {
 		segments[ns.y-1] = ns;
@@ -597,25 +707,19 @@ void MappedRootSystem::simulate(double dt, bool verbose)
 	if (verbose) {
 		std::cout << "segments added "<< newsegs.size() << "\n" << std::flush;
 	}
-	auto newsegO = this->getNewSegmentOrigins(); // to add radius and type (TODO cutting)
+	const auto& newsegO = delta.newSegmentOrigins; // to add radius and type (TODO cutting)
 	radii.resize(radii.size()+newsegO.size());
 	subTypes.resize(subTypes.size()+newsegO.size());
 	organTypes.resize(organTypes.size()+newsegO.size());
 
-
-	c = 0;
 	if (verbose) {
 		std::cout << "number of segments " << radii.size() << ", including " << newsegO.size() << " new \n"<< std::flush;
 	}
-	for (auto& so : newsegO) {
+	for (int c = 0; c<newsegO.size(); c++) {
 		int segIdx = newsegs[c].y-1;
-		c++;
-//		radii[segIdx] = so->param()->a;
-//		subTypes[segIdx] = so->param()->subType;
-//		organTypes[segIdx] = so->organType();
-		radii.at(segIdx) = so->param()->a;
-		subTypes.at(segIdx) = so->param()->subType;
-		organTypes.at(segIdx) = so->organType();
+		radii.at(segIdx) = newsegO[c]->param()->a;
+		subTypes.at(segIdx) = newsegO[c]->param()->subType;
+		organTypes.at(segIdx) = delta.newSegmentOrganTypes[c];
 	}
 	// map new segments
 	this->mapSegments(newsegs);
@@ -696,144 +800,161 @@ void MappedPlant::mapSubTypes(){
 /**
  * Simulates the development of the organism in a time span of @param dt days.
  *
+ * Only the new segments are added, and the geometry (see MappedPlant::updateSegmentGeometry) is only
+ * recomputed for organs that changed in the last time step (new or moved nodes, or growing leaves).
+ *
  * @param dt        time step [day]
  * @param verbose   turns console output on or off
  */
 void MappedPlant::simulate(double dt, bool verbose)
 {
-	if (soil_index==nullptr) {
+	if ((soil_index==nullptr) && (soil_indices==nullptr)) {
 		throw std::invalid_argument("MappedPlant::simulate():soil was not set, use MappedPlant::simulate::setSoilGrid" );
 	}
 	Plant::simulate( dt,  verbose);
-	auto uni = this->getUpdatedNodeIndices(); // move nodes
-	auto unodes = this->getUpdatedNodes();
-	auto uncts = this->getUpdatedNodeCTs();
-	assert(uni.size()==unodes.size() && "updated node indices and number of nodes must be equal");
-	int c = 0;
-	for (int i : uni) {
-		nodes.at(i) = unodes[c];
-		nodeCTs.at(i) = uncts[c];
-		c++;
-	}
 
-	if (verbose) {
-		std::cout << "nodes moved "<< uni.size() << "\n" << std::flush;
-	}
-	auto newnodes = this->getNewNodes(); // add nodes
-	nodes.reserve(nodes.size()+newnodes.size());
-	for (auto& nn : newnodes) {
-		nodes.push_back(nn);
-	}
-	auto newnode_cts = this->getNewNodeCTs(); // add node cts
-	nodeCTs.reserve(nodeCTs.size()+newnode_cts.size());
-	for (auto& nct : newnode_cts) {
-		nodeCTs.push_back(nct);
+	const auto& delta = this->getStepDelta(); // visits the organs that changed
+	const auto& uni = delta.movedNodeIds; // move nodes
+	assert(uni.size()==delta.movedNodes.size() && "updated node indices and number of nodes must be equal");
+	for (int c = 0; c<uni.size(); c++) {
+		nodes.at(uni[c]) = delta.movedNodes[c];
+		nodeCTs.at(uni[c]) = delta.movedNodeCTs[c];
 	}
 	if (verbose) {
-		std::cout << "new nodes added " << newnodes.size() << "\n" << std::flush;
-	}
-	auto newsegs = this->getSegments(); // add segments (TODO cutting)
-	segments.resize(newsegs.size());
-	for (auto& ns : newsegs) {
-		segments[ns.y-1] = ns;
+		std::cout << "nodes moved "<< uni.size() << "\n" << std::flush;
 	}
+	nodes.insert(nodes.end(), delta.newNodes.begin(), delta.newNodes.end()); // add nodes
+	nodeCTs.insert(nodeCTs.end(), delta.newNodeCTs.begin(), delta.newNodeCTs.end()); // add node cts
 	if (verbose) {
-		std::cout << "segments added "<< newsegs.size() << "\n" << std::flush;
+		std::cout << "new nodes added " << delta.newNodes.size() << "\n" << std::flush;
 	}
-	auto newsegO = this->getSegmentOrigins(); // to add radius and type (TODO cutting)
-	radii.resize(newsegO.size());
-	subTypes.resize(newsegO.size());
-	organTypes.resize(newsegO.size());
-	segVol.resize(newsegO.size());
-	bladeLength.resize(newsegO.size());
-	leafBladeSurface.resize(newsegO.size());
 
-	c = 0;
+	// segments of the plant are indexed by their second node (segment index = node index - 1)
+	bool all = (segments.size()+delta.newSegments.size()+1 != nodes.size()); // e.g. segments created by initialize
+	std::vector<Vector2i> allsegs;
+	std::vector<std::shared_ptr<Organ>> allsegO;
+	std::vector<std::shared_ptr<Organ>> allOrgans;
+	if (all) {
+		allsegs = this->getSegments();
+		allsegO = this->getSegmentOrigins();
+		allOrgans = this->getOrgans();
+	}
+	const auto& newsegs = all ? allsegs : delta.newSegments; // add segments (TODO cutting)
+	const auto& newsegO = all ? allsegO : delta.newSegmentOrigins; // to add radius and type (TODO cutting)
+	size_t n = nodes.size()-1;
+	segments.resize(n);
+	radii.resize(n);
+	subTypes.resize(n);
+	organTypes.resize(n);
+	segVol.resize(n);
+	bladeLength.resize(n);
+	leafBladeSurface.resize(n);
 	if (verbose) {
 		std::cout << "Number of segments " << radii.size() << ", including " << newsegO.size() << " new \n"<< std::flush;
 	}
-	for (auto& so : newsegO) {
+	for (int c = 0; c<newsegO.size(); c++) {
 		int segIdx = newsegs[c].y-1;
+		segments.at(segIdx) = newsegs[c];
+		radii.at(segIdx) = newsegO[c]->param()->a;
+		organTypes.at(segIdx) = newsegO[c]->organType();
+		subTypes.at(segIdx) = st2newst[std::make_tuple(organTypes[segIdx],newsegO[c]->param()->subType)];//new st
+	}
 
-		radii.at(segIdx) = so->param()->a;
-		organTypes.at(segIdx) = so->organType();
-		subTypes.at(segIdx) = st2newst[std::make_tuple(organTypes[segIdx],so->param()->subType)];//new st
-
-		if(organTypes.at(segIdx) == Organism::ot_leaf) //leaves can be cylinder, cuboid or characterized by user-defined 2D shape
-		{
-			int index;
-			auto nodeIds = so->getNodeIds();
-			auto it = find(nodeIds.begin(), nodeIds.end(), newsegs[c].y);
-			if (it != nodeIds.end()){ index = it - nodeIds.begin() -1;
-			}else {
-				throw std::runtime_error("MappedPlant::simulate: global segment index not found in organ");
-			}
-			int localSegId = index;
-			bool realized = true; bool withPetiole = false;
-			segVol.at(segIdx) = -1;
-			bladeLength.at(segIdx) = std::static_pointer_cast<Leaf>(so)->leafLengthAtSeg(localSegId, withPetiole);
-			leafBladeSurface.at(segIdx) =  std::static_pointer_cast<Leaf>(so)->leafAreaAtSeg(localSegId,realized, withPetiole);
-			withPetiole = true;
-			segVol.at(segIdx) = std::static_pointer_cast<Leaf>(so)->leafVolAtSeg(localSegId, realized, withPetiole);//* thickness;
-			if(segVol.at(segIdx) < 0)
-			{
-				std::stringstream errMsg;
-				errMsg <<"MappedPlant::simulate: computation of leaf volume failed "<<segVol.at(segIdx)<<"\n";
-				throw std::runtime_error(errMsg.str().c_str());
-			}
-
-		}else{ //stems and roots are cylinder
-			auto s = segments.at(segIdx);
-			double length_seg = (nodes.at(s.x).minus(nodes.at(s.y))).length();
-			segVol.at(segIdx) = radii.at(segIdx) * radii.at(segIdx) * M_PI * length_seg;
-			bladeLength.at(segIdx) = 0;
-			leafBladeSurface.at(segIdx) = 0;
+	const auto& organs = all ? allOrgans : delta.organs; // only the organs that changed
+	for (const auto& o : organs) { // volumes, blade lengths, and blade surfaces
+		auto& s0 = segments.at(o->getNodeId(1)-1); // first segment, its first node changes with the origin (see Organ::moveOrigin)
+		bool originMoved = (s0.x!=o->getNodeId(0));
+		s0.x = o->getNodeId(0);
+		bool changed = all || originMoved || o->hasMoved() || (o->getOldNumberOfNodes()!=o->getNumberOfNodes()) ||
+			((o->organType()==Organism::ot_leaf) && o->isActive()); // a growing leaf changes its shape
+		if (changed) {
+			updateSegmentGeometry(o);
 		}
-		c++;
 	}
 
-	// map new segments
-	newsegs = this->getNewSegments();
-	this->mapSegments(newsegs);
+	// map new segments (cell2seg is rebuilt once, after the moved segments are mapped)
+	this->mapSeg2cell(delta.newSegments);
 
 	// update segments of moved nodes
 	std::vector<Vector2i> rSegs;
 	if(!constantLoc)//for 1d-3d coupling need to have segments remain in the same voxel
 	{//also, if soil_index is in parallel, this blocks the program as plant only grows on
 		// one thread
+		// 1. check if mid is still in same cell (otherwise, remove, and add again)
+		// 2. if cut is on, check if end point is in same cell than mid point (otherwise remove and add again)
+		std::vector<Vector3d> mids;
+		mids.reserve(uni.size());
 		for (int i : uni) {
-			int segIdx = i -1;
-			int cellIdx = seg2cell[segIdx];
-			auto s = segments[segIdx];
-			Vector3d mid = (nodes[s.x].plus(nodes[s.y])).times(0.5);
-			int newCellIdx = soil_index(mid.x,mid.y,mid.z);
-			// 1. check if mid is still in same cell (otherwise, remove, and add again)
-			// 2. if cut is on, check if end point is in same cell than mid point (otherwise remove and add again)
-			bool remove = false;
-			if (cellIdx==newCellIdx) {
+			auto s = segments[i-1];
+			mids.push_back((nodes[s.x].plus(nodes[s.y])).times(0.5));
+		}
+		auto newCells = soilIndices(mids); // all moved segments at once
+		std::vector<int> sameCell; // segment indices
+		std::vector<Vector3d> endPoints;
+		for (size_t c = 0; c<uni.size(); c++) {
+			int segIdx = uni[c]-1;
+			if (seg2cell[segIdx]==newCells[c]) {
 				if (cutAtGrid) {
-					auto endPoint = nodes[s.y];
-					newCellIdx = soil_index(endPoint.x,endPoint.y,endPoint.z);
-					remove = (newCellIdx!=cellIdx);
+					sameCell.push_back(segIdx);
+					endPoints.push_back(nodes[segments[segIdx].y]);
 				}
 			} else {
-				if(!constantLoc)
-				{
-					remove = true;
-				}
+				rSegs.push_back(segments[segIdx]);
 			}
-			if (remove) {
-				rSegs.push_back(s);
+		}
+		auto endCells = soilIndices(endPoints);
+		for (size_t c = 0; c<sameCell.size(); c++) {
+			if (endCells[c]!=seg2cell[sameCell[c]]) {
+				rSegs.push_back(segments[sameCell[c]]);
 			}
 		}
 	}
 	MappedSegments::unmapSegments(rSegs);
-	MappedSegments::mapSegments(rSegs);
+	MappedSegments::mapSeg2cell(rSegs);
+	cell2seg.build(seg2cell);
 	if(kr_length > 0.){calcExchangeZoneCoefs();}
 	getSegment2leafIds();
 
 }
 
+/**
+ * Computes segment volume, blade length, and blade surface of all segments of an organ
+ * (called by MappedPlant::simulate, for the organs that changed in the last time step)
+ *
+ * @param o 		the organ
+ */
+void MappedPlant::updateSegmentGeometry(const std::shared_ptr<Organ>& o)
+{
+	if(o->organType() == Organism::ot_leaf) //leaves can be cylinder, cuboid or characterized by user-defined 2D shape
+	{
+		auto leaf = std::static_pointer_cast<Leaf>(o);
+		for (int localSegId = 0; localSegId<o->getNumberOfSegments(); localSegId++) {
+			int segIdx = o->getNodeId(localSegId+1)-1;
+			bool realized = true; bool withPetiole = false;
+			segVol.at(segIdx) = -1;
+			bladeLength.at(segIdx) = leaf->leafLengthAtSeg(localSegId, withPetiole);
+			leafBladeSurface.at(segIdx) =  leaf->leafAreaAtSeg(localSegId,realized, withPetiole);
+			withPetiole = true;
+			segVol.at(segIdx) = leaf->leafVolAtSeg(localSegId, realized, withPetiole);//* thickness;
+			if(segVol.at(segIdx) < 0)
+			{
+				std::stringstream errMsg;
+				errMsg <<"MappedPlant::simulate: computation of leaf volume failed "<<segVol.at(segIdx)<<"\n";
+				throw std::runtime_error(errMsg.str().c_str());
+			}
+		}
+	}else{ //stems and roots are cylinder
+		for (int localSegId = 0; localSegId<o->getNumberOfSegments(); localSegId++) {
+			int segIdx = o->getNodeId(localSegId+1)-1;
+			auto s = segments.at(segIdx);
+			double length_seg = (nodes.at(s.x).minus(nodes.at(s.y))).length();
+			segVol.at(segIdx) = radii.at(segIdx) * radii.at(segIdx) * M_PI * length_seg;
+			bladeLength.at(segIdx) = 0;
+			leafBladeSurface.at(segIdx) = 0;
+		}
+	}
+}
+
 
 
 /**
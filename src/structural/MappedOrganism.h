@@ -8,9 +8,42 @@
 #include <functional>
 #include <vector>
 #include <tuple>
+#include <limits>
 
 namespace CPlantBox {
 
+/**
+ * Maps soil cells to the segments within, in compressed sparse row format.
+ *
+ * Built from the dense segment to cell mapper (see MappedSegments::seg2cell) by a counting sort,
+ * the segments of cell c are segments[offsets[c+1]], ..., segments[offsets[c+2]-1] in ascending order
+ * (cell -1 holds the segments outside of the soil domain).
+ */
+class Cell2SegMapper
+{
+public:
+
+    struct Segments { ///< segment indices of a cell (valid until the mapper is rebuilt)
+        const int* first;
+        const int* last;
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        size_t size() const { return last-first; }
+        operator std::vector<int>() const { return std::vector<int>(first, last); }
+    };
+
+    void build(const std::vector<int>& seg2cell); ///< rebuilds the mapper from the segment to cell mapper
+    void clear() { offsets.clear(); segments.clear(); }
+
+    size_t count(int cellIdx) const; ///< 1 if the cell contains segments, else 0 (like std::map::count)
+    Segments at(int cellIdx) const; ///< the segments within the cell, throws std::out_of_range if there are none
+    std::vector<int> cells() const; ///< indices of the cells containing segments, in ascending order
+    size_t size() const; ///< number of cells containing segments
+
+    std::vector<int> offsets; ///< offsets[c+1] is the position of the first segment of cell c within segments
+    std::vector<int> segments; ///< segment indices sorted by cell
+};
+
 /**
  * Represents a connected 1d rootsystem as segments, which are mapped to a 3d soil grid.
  *
@@ -38,8 +71,10 @@ public:
     void setSoilGrid(const std::function<int(double,double,double)>& s); ///< sets the soil, resets the mappers, and maps all segments
     void setSoilGrid(const std::function<int(double,double,double)>& s, Vector3d min, Vector3d max, Vector3d res, bool cut = true); ///< sets the soil, resets the mappers, cuts and maps all segments
     void setRectangularGrid(Vector3d min, Vector3d max, Vector3d res, bool cut = true, bool noChanges = false); ///< sets an underlying rectangular grid, and cuts all segments accordingly
+    void setSoilIndices(const std::function<std::vector<int>(const std::vector<Vector3d>&)>& s); ///< sets a batched soil cell index call back, resets the mappers, and maps all segments
 
     void mapSegments(const std::vector<Vector2i>& segs);
+    std::vector<int> soilIndices(const std::vector<Vector3d>& points) const; ///< soil cell indices of multiple points (using soil_indices, or soil_index)
     void cutSegments(); // cut and add segments
 
     void sort(); ///< sorts segments, each segment belongs to position s.y-1
@@ -52,11 +87,12 @@ public:
     std::vector<int> getSegmentMapper() const;  // seg2cell mapper as vector
     std::vector<double> getSegmentZ() const; // z-coordinate of segment mid
 
-    std::map<int, int> seg2cell; // root segment to soil cell mapper
-    std::map<int, std::vector<int>> cell2seg; // soil cell to root segment mapper
+    static constexpr int notMapped = std::numeric_limits<int>::min(); ///< seg2cell entry of segments that are not mapped
+    std::vector<int> seg2cell; // root segment to soil cell mapper (per segment index, -1 outside of the soil)
+    Cell2SegMapper cell2seg; // soil cell to root segment mapper
 
-    std::function<int(double,double,double)> soil_index =
-        std::bind(&MappedSegments::soil_index_, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3); ///< soil cell index call back function, (care need all MPI ranks in case of dumux)
+    std::function<int(double,double,double)> soil_index = RectangularGridIndex{ this }; ///< soil cell index call back function, (care need all MPI ranks in case of dumux)
+    std::function<std::vector<int>(const std::vector<Vector3d>&)> soil_indices = nullptr; ///< batched soil cell index call back function, maps all points at once (optional, replaces soil_index)
 
     std::vector<Vector3d> nodes; ///< nodes [cm]
     std::vector<double> nodeCTs; ///< creation times [days]
@@ -94,8 +130,13 @@ protected:
     void add(Vector2i ns, double radius,  int st, int ot, int i); // adds without cutting, at index i, or appends if i = -1
     double length(const Vector2i& s) const;
 
-    int soil_index_(double x, double y, double z); // default mapper to a equidistant rectangular grid
-    void unmapSegments(const std::vector<Vector2i>& segs); ///< remove segments from the mappers
+    int soil_index_(double x, double y, double z) const; // default mapper to a equidistant rectangular grid
+    struct RectangularGridIndex { // default soil_index, lets soilIndices recognise the rectangular grid
+        const MappedSegments* ms;
+        int operator()(double x, double y, double z) const { return ms->soil_index_(x, y, z); }
+    };
+    void mapSeg2cell(const std::vector<Vector2i>& segs); ///< maps segments in seg2cell only
+    void unmapSegments(const std::vector<Vector2i>& segs); ///< removes segments from seg2cell only
 
 };
 
@@ -151,8 +192,8 @@ public:
 
 	std::map<std::tuple<int, int>, int > st2newst; // replace subtypes with other int nummer, so that the N subtypes of one organ type go from 0 to N-1
 
-    virtual double rand() override {if(stochastic){return UD(gen);} else {return 0.5; } }  ///< uniformly distributed random number (0,1)
-	virtual double randn() override {if(stochastic){return std::min(std::max(ND(gen),-1.),1.);} else {return 0.5; } }  ///< normally distributed random number (0,1)
+    virtual double rand() override {if(stochastic){return growthTask ? growthTask->UD(growthTask->gen) : UD(gen);} else {return 0.5; } }  ///< uniformly distributed random number (0,1)
+	virtual double randn() override {if(stochastic){return std::min(std::max(growthTask ? growthTask->ND(growthTask->gen) : ND(gen),-1.),1.);} else {return 0.5; } }  ///< normally distributed random number (0,1)
 	bool stochastic = true;//< whether or not to implement stochasticity, usefull for test files @see test_relative_coordinates.py
 	//for photosynthesis and phloem module:
 	void calcExchangeZoneCoefs() override;
@@ -166,6 +207,7 @@ public:
  protected:
 	void initialize_(bool verbose = true, bool stochastic = true, bool LB = true);
 	void getSegment2leafIds(); ///< fill segment2Leaf vector
+	void updateSegmentGeometry(const std::shared_ptr<Organ>& o); ///< segment volumes, blade lengths, and blade surfaces of an organ
 };
 
 }
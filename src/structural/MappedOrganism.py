@@ -52,7 +52,7 @@ class MappedPlantPython():
 
         B = sparse.coo_matrix((np.ones((len(ii_),)), (np.array(ii_), np.array(jj_))), shape = (smi, ns))
 
-        cell_max = max(seg2cell.values()) + 1
+        cell_max = max(seg2cell) + 1
         matrix2soil = np.zeros((smi,), dtype = np.int64)
         for i in range(0, cell_max):
             if i in soil2matrix:
@@ -5,6 +5,9 @@
 #include "Plant.h"
 #include <algorithm>
 #include <iostream>
+#include <mutex>
+#include <unordered_map>
+#include <stdexcept>
 
 #include "organparameter.h"
 
@@ -50,24 +53,28 @@ Organ::Organ(std::shared_ptr<Organism> plant, std::shared_ptr<Organ> parent, int
 		 int pni)
 : parentNI(pni), plant(plant), parent(parent), id(plant->getOrganIndex()),
   param_(plant->getOrganRandomParameter(ot, st)->realize()), /* root parameters are diced in the getOrganRandomParameter class */
-  age(-delay)
+  orp_(plant->getOrganRandomParameter(ot, st).get()), age(-delay)
 { }
 
 /*
  * Deep copies this organ into the new plant @param plant.
  * All children are deep copied, plant and parent pointers are updated.
+ * The node data is shared with the copy until one of the organs changes it (copy on write, see CowVector).
  *
  * @param plant     the plant the copied organ will be part of
+ * @param share     share the organ specific parameters instead of copying them (see Organism::fork)
  * @return          the newly created copy (ownership is passed)
  */
-std::shared_ptr<Organ> Organ::copy(std::shared_ptr<Organism>  p)
+std::shared_ptr<Organ> Organ::copy(std::shared_ptr<Organism> p, bool share)
 {
 	auto o = std::make_shared<Organ>(*this); // shallow copy
 	o->parent = std::weak_ptr<Organ>();
 	o->plant = p;
-	o->param_ = std::make_shared<OrganSpecificParameter>(*param_); // copy parameters
+	if (!share) { // a fork shares the parameters (they are constant)
+		o->param_ = std::make_shared<OrganSpecificParameter>(*param_); // copy parameters
+	}
 	for (size_t i=0; i< children.size(); i++) {
-		o->children[i] = children[i]->copy(p); // copy lateral
+		o->children[i] = children[i]->copy(p, share); // copy lateral
 		o->children[i]->setParent(o);
 	}
 	return o;
@@ -78,17 +85,34 @@ std::shared_ptr<Organ> Organ::copy(std::shared_ptr<Organism>  p)
  */
 double Organ::getLength(int i) const
 {
-	double l = 0.; // length until node i
-	if(hasRelCoord()){//is currently using relative coordinates?
-		for (int j = 0; j<i; j++) {
-			l += nodes.at(j+1).length(); // relative length equals absolute length
-		}
-	}else{
-		for (int j = 0; j<i; j++) {
-			l += nodes.at(j+1).minus(nodes.at(j)).length(); // relative length equals absolute length
+	if (i<=0) {
+		return 0.;
+	}
+	return nodeLengths.at(i); // kept up to date by Organ::updateLengths
+}
+
+/**
+ * Updates the lengths along the organ (@see Organ::getLength(int)) from node index @param first on,
+ * must be called whenever nodes are added, moved, or converted (@see Organ::abs2rel, Organ::rel2abs)
+ *
+ * @param first     index of the first node that changed
+ */
+void Organ::updateLengths(size_t first)
+{
+	const auto& n = nodes.vector();
+	nodeLengths.resize(n.size());
+	if (n.empty()) {
+		return;
+	}
+	bool rel = hasRelCoord() && (!keptAbsolute); // is currently using relative coordinates?
+	nodeLengths[0] = 0.;
+	for (size_t j = std::max(first, size_t(1)); j<n.size(); j++) {
+		if (rel) {
+			nodeLengths[j] = nodeLengths[j-1] + n[j].length(); // relative length equals absolute length
+		} else {
+			nodeLengths[j] = nodeLengths[j-1] + n[j].minus(n[j-1]).length();
 		}
 	}
-	return l;
 }
 
 
@@ -127,6 +151,35 @@ std::shared_ptr<OrganRandomParameter> Organ::getOrganRandomParameter() const
 	return plant.lock()->getOrganRandomParameter(this->organType(), param_->subType);
 }
 
+/**
+ * @return The organ type parameter as raw pointer, without locking the plant and looking up the parameter map.
+ * The pointer is looked up when the organ is created, and again when the organism's organ type parameters are replaced
+ * or copied (see Organ::resolveOrganRandomParameter); changes of the parameter values themselves are seen directly.
+ * Organs created from data (without organism) look it up on each call.
+ */
+OrganRandomParameter* Organ::orp() const
+{
+	return orp_ ? orp_ : getOrganRandomParameter().get();
+}
+
+/**
+ * Looks up the organ type parameter of this organ and its children in their organism (see Organ::orp),
+ * called by the organism whenever its organ type parameters are replaced (@see Organism::resolveOrganRandomParameters)
+ */
+void Organ::resolveOrganRandomParameter()
+{
+	orp_ = nullptr;
+	auto p = plant.lock();
+	if (p) {
+		try {
+			orp_ = p->getOrganRandomParameter(this->organType(), param_->subType).get(); // the organism owns the parameter
+		} catch (const std::invalid_argument&) { } // not set (yet), Organ::orp will throw when it is used
+	}
+	for (auto& c : children) {
+		c->resolveOrganRandomParameter();
+	}
+}
+
 /**
  * Simulates the development of the organ in a time span of @param dt days.
  *
@@ -142,9 +195,7 @@ void Organ::simulate(double dt, bool verbose)
 	// if the organ is alive, manage children
 	if (alive) {
 		age += dt;
-		for (auto& c : children)  {
-			c->simulate(dt, verbose);
-		}
+		plant.lock()->simulateOrgans(children, dt, verbose); // e.g. the base organs of the seed
 	}
 }
 
@@ -183,6 +234,26 @@ void Organ::addNode(Vector3d n, int id, double t, size_t index, bool shift)
 	nodes.push_back(n); // node
 	nodeIds.push_back(id); //unique id
 	nodeCTs.push_back(t); // exact creation time
+	updateLengths(nodes.size()-1);
+	setChanged();
+}
+
+/**
+ * Registers the organ as changed in the current time step (once per time step), Organism::getStepDelta only visits
+ * the registered organs. Called whenever nodes are added or moved, or the origin moves.
+ *
+ * Nodes added by the constructor are not registered, the first node of an organ is the node of its parent.
+ */
+void Organ::setChanged()
+{
+	auto p = plant.lock();
+	if (changedStep!=p->getStep()) {
+		auto o = weak_from_this().lock(); // empty within the constructor
+		if (o) {
+			changedStep = p->getStep();
+			p->addChangedOrgan(o);
+		}
+	}
 }
 
 /**
@@ -194,7 +265,45 @@ void Organ::moveOrigin(int idx)
 {
 	this->parentNI = idx;
 	nodeIds.at(0) = getParent()->getNodeId(idx);
+	setChanged();
+}
 
+/**
+ * Adds @param organShift to the organ ids larger than @param organBase, and @param nodeShift to the node ids
+ * larger than @param nodeBase, of this organ and its children (@see Organism::simulateOrgans)
+ */
+void Organ::shiftIds(int organBase, int organShift, int nodeBase, int nodeShift)
+{
+	if (id>organBase) {
+		id += organShift;
+	}
+	const auto& ids = nodeIds.vector(); // read only, to keep data shared with forks (see CowVector)
+	for (size_t i = 0; i<ids.size(); i++) {
+		if (ids[i]>nodeBase) {
+			auto& mids = nodeIds.mutableVector(); // detaches once
+			for (size_t j = i; j<mids.size(); j++) {
+				if (mids[j]>nodeBase) {
+					mids[j] += nodeShift;
+				}
+			}
+			break;
+		}
+	}
+	for (auto& c : children) {
+		c->shiftIds(organBase, organShift, nodeBase, nodeShift);
+	}
+}
+
+/**
+ * Adds @param leafShift (or @param stemShift) per sub type to the phytomer ids of the leaves (or stems) with an
+ * organ id larger than @param organBase, of this organ and its children (@see Organism::simulateOrgans).
+ * Overwritten by Leaf and Stem, the other organs only pass it on.
+ */
+void Organ::shiftPhytomerIds(int organBase, const std::vector<int>& leafShift, const std::vector<int>& stemShift)
+{
+	for (auto& c : children) {
+		c->shiftPhytomerIds(organBase, leafShift, stemShift);
+	}
 }
 
 /**
@@ -238,7 +347,7 @@ std::vector<Vector2i> Organ::getSegments() const
  */
 double Organ::dx() const
 {
-	return getOrganRandomParameter()->dx;
+	return orp()->dx;
 }
 
 /**
@@ -247,7 +356,7 @@ double Organ::dx() const
  */
 double Organ::dxMin() const
 {
-	return getOrganRandomParameter()->dxMin;
+	return orp()->dxMin;
 }
 
 /**
@@ -277,7 +386,7 @@ std::vector<std::shared_ptr<Organ>> Organ::getOrgans(int ot, bool all)
 void Organ::getOrgans(int ot, std::vector<std::shared_ptr<Organ>>& v, bool all)
 {
 	//deprecated: do not need bulb anymore, stems of subtype 2 are normal stems
-	//bool notBulb = !((this->organType() == Organism::ot_stem)&&(this->getParameter("subType") == 2));//do not count leaf bulb
+	//bool notBulb = !((this->organType() == Organism::ot_stem)&&(this->getParameter(pk_subType) == 2));//do not count leaf bulb
 	//might have age <0 and node.size()> 1 when adding organ manuelly @see test_organ.py
 	bool forCarbon_limitedGrowth = (all && (this->getAge()>0));//when ask for "all" organs which have age > 0 even if nodes.size() == 1
 	bool notSeed = ( this->organType() != Organism::ot_seed);
@@ -308,9 +417,68 @@ int Organ::getNumberOfLaterals() const {
 	return nol;
 }
 
+const std::vector<std::string> Organ::parameterKeyNames = { "subType", "type", "a", "radius", "diameter", "iHeadingX", "iHeadingY",
+    "iHeadingZ", "parentNI", "parent-node", "organType", "numberOfChildren", "id", "alive", "active", "age", "length",
+    "lengthTh", "numberOfNodes", "numberOfSegments", "hasMoved", "oldNumberOfNodes", "numberOfLaterals", "creationTime",
+    "order", "one", "lb", "la", "r", "theta", "rlt", "nob", "k", "lmax", "lnMean", "lnDev", "rootLength", "volume", "surface",
+    "delayNGStart", "delayNGEnd", "shapeType", "Width_petiole", "Width_blade", "volume_th", "surface_th", "volume_realized",
+    "surface_realized" };
+
+namespace {
+std::mutex parameterKeysMutex; // guards the keys of further parameter names
+std::vector<std::string> furtherParameterNames; // names of the keys >= Organ::pk_numberOfKeys
+std::unordered_map<std::string, int> furtherParameterKeys;
+}
+
 /**
- * Returns a single scalar parameter called @param name of the organ.
- * This method is for post processing, since it is flexible but slow.
+ * Returns the integer key of the parameter called @param name, e.g. to call Organ::getParameter(int) for many organs.
+ * Names that are not a parameter key (@see Organ::ParameterKeys) are registered, and passed to the organ random parameter
+ * by Organ::getParameter(int).
+ */
+int Organ::parameterKey(const std::string& name)
+{
+    static const std::unordered_map<std::string, int> keys = []() {
+        std::unordered_map<std::string, int> m;
+        for (int i = 0; i<pk_numberOfKeys; i++) {
+            m[parameterKeyNames.at(i)] = i;
+        }
+        return m;
+    }();
+    auto it = keys.find(name);
+    if (it!=keys.end()) {
+        return it->second;
+    }
+    std::lock_guard<std::mutex> lock(parameterKeysMutex);
+    auto fit = furtherParameterKeys.find(name);
+    if (fit!=furtherParameterKeys.end()) {
+        return fit->second;
+    }
+    int key = pk_numberOfKeys + furtherParameterNames.size();
+    furtherParameterNames.push_back(name);
+    furtherParameterKeys[name] = key;
+    return key;
+}
+
+/**
+ * @return the parameter name of the key @param key (@see Organ::parameterKey)
+ */
+std::string Organ::parameterName(int key)
+{
+    if ((key>=0) && (key<pk_numberOfKeys)) {
+        return parameterKeyNames[key];
+    }
+    std::lock_guard<std::mutex> lock(parameterKeysMutex);
+    try {
+        return furtherParameterNames.at(key-pk_numberOfKeys);
+    } catch (const std::out_of_range& e) {
+        throw std::invalid_argument("Organ::parameterName: unknown parameter key "+ std::to_string(key));
+    }
+}
+
+/**
+ * Returns a single scalar parameter of the organ, given by its key @param key (@see Organ::parameterKey).
+ * Organ::getParameter(std::string name) resolves the name first, resolve the key once to query many organs
+ * (@see Organism::getParameters).
  * Overwrite to add more parameters for specific organs.
  *
  * For OrganRandomParameters add '_mean', or '_dev',
@@ -318,52 +486,53 @@ int Organ::getNumberOfLaterals() const {
  *
  * @return The parameter value, if unknown NaN
  */
-double Organ::getParameter(std::string name) const {
+double Organ::getParameter(int key) const {
+	switch (key) {
 	// specific parameters
-	if (name=="subType") { return this->param_->subType; }
-    if (name=="a") { return param_->a; } // root radius [cm]
-	if (name=="radius") { return this->param_->a; } // root radius [cm]
-	if (name=="diameter") { return 2.*this->param_->a; } // root diameter [cm]
+	case pk_subType: return this->param_->subType;
+	case pk_a: return param_->a; // root radius [cm]
+	case pk_radius: return this->param_->a; // root radius [cm]
+	case pk_diameter: return 2.*this->param_->a; // root diameter [cm]
 	// organ member variables
-    if (name=="iHeadingX") { return getiHeading0().x; } // root initial heading x - coordinate [cm]
-    if (name=="iHeadingY") { return getiHeading0().y; } // root initial heading y - coordinate [cm]
-    if (name=="iHeadingZ") { return getiHeading0().z; } // root initial heading z - coordinate [cm]
-    if (name=="parentNI") { return parentNI; } // local parent node index where the lateral emerges
-    if (name=="parent-node") { // local parent node index for RSML (higher order roots are missing the first node)
-        if (this->parent.expired()) {
-            return -1;
-        }
-        if (this->parent.lock()->organType()==Organism::ot_seed) { // if it is base root
-    		return -1;
-    	}
-        auto p = this->parent.lock();
-        if (p->parent.expired()) { // if parent is base root
-            return parentNI;
-        }
-        if (p->parent.lock()->organType()==Organism::ot_seed){ // if parent is base root
-            return parentNI;
-        } else {
-            return std::max(parentNI-1,0); // higher order roots are missing the first node
-            // TODO for 0 this can be negative... (belongs to other branch in rsml)
-        }
-    }
-    // organ member functions
-	if (name=="organType") { return this->organType(); }
-    if (name=="numberOfChildren") { return children.size(); }
-	if (name=="id") { return getId(); }
-	if (name=="alive") { return isAlive(); }
-	if (name=="active") { return isActive(); }
-	if (name=="age") { return getAge(); }
-    if (name=="length") { return getLength(true); } //realized organ length, dependent on dxMin and dx
-	if (name=="lengthTh") { return getLength(false); } //theoratical organ length, dependent on dxMin and dx
-    if (name=="numberOfNodes") { return getNumberOfNodes(); }
-    if (name=="numberOfSegments") { return getNumberOfSegments(); }
-    if (name=="hasMoved") { return hasMoved(); }
-    if (name=="oldNumberOfNodes") { return getOldNumberOfNodes(); }
-	if (name=="numberOfLaterals") { return getNumberOfLaterals(); }
-    // further
-    if (name=="creationTime") { return getNodeCT(0); }
-	if (name=="order") { // count how often it is possible to move up
+	case pk_iHeadingX: return getiHeading0().x; // root initial heading x - coordinate [cm]
+	case pk_iHeadingY: return getiHeading0().y; // root initial heading y - coordinate [cm]
+	case pk_iHeadingZ: return getiHeading0().z; // root initial heading z - coordinate [cm]
+	case pk_parentNI: return parentNI; // local parent node index where the lateral emerges
+	case pk_parentNode: { // local parent node index for RSML (higher order roots are missing the first node)
+		if (this->parent.expired()) {
+			return -1;
+		}
+		if (this->parent.lock()->organType()==Organism::ot_seed) { // if it is base root
+			return -1;
+		}
+		auto p = this->parent.lock();
+		if (p->parent.expired()) { // if parent is base root
+			return parentNI;
+		}
+		if (p->parent.lock()->organType()==Organism::ot_seed){ // if parent is base root
+			return parentNI;
+		} else {
+			return std::max(parentNI-1,0); // higher order roots are missing the first node
+			// TODO for 0 this can be negative... (belongs to other branch in rsml)
+		}
+	}
+	// organ member functions
+	case pk_organType: return this->organType();
+	case pk_numberOfChildren: return children.size();
+	case pk_id: return getId();
+	case pk_alive: return isAlive();
+	case pk_active: return isActive();
+	case pk_age: return getAge();
+	case pk_length: return getLength(true); //realized organ length, dependent on dxMin and dx
+	case pk_lengthTh: return getLength(false); //theoratical organ length, dependent on dxMin and dx
+	case pk_numberOfNodes: return getNumberOfNodes();
+	case pk_numberOfSegments: return getNumberOfSegments();
+	case pk_hasMoved: return hasMoved();
+	case pk_oldNumberOfNodes: return getOldNumberOfNodes();
+	case pk_numberOfLaterals: return getNumberOfLaterals();
+	// further
+	case pk_creationTime: return getNodeCT(0);
+	case pk_order: { // count how often it is possible to move up
 		int o = 0;
 		auto p = shared_from_this();
 		while ((!p->parent.expired()) && (p->parent.lock()->organType()!=Organism::ot_seed)) {
@@ -372,8 +541,9 @@ double Organ::getParameter(std::string name) const {
 		}
 		return o;
 	}
-	if (name=="one") { return 1; } // e.g. for counting the organs
-    return this->getOrganRandomParameter()->getParameter(name); // ask the random parameter
+	case pk_one: return 1; // e.g. for counting the organs
+	default: return this->getOrganRandomParameter()->getParameter(parameterName(key)); // ask the random parameter
+	}
 }
 
 /**
@@ -476,43 +646,86 @@ std::string Organ::toString() const
 
 /**
  * convert the nodes' positions from relative to absolute coordinates
+ *
+ * The positions are only recomputed (with the tropism, @see Organ::getIncrement) if the organ changed since the last
+ * call of abs2rel: if nodes were created or shifted, if the parent node the organ is attached to (or the one before,
+ * defining the heading) changed position, or if the tropism depends on the organ's age.
+ * Otherwise, the absolute coordinates kept by abs2rel are restored. Organs that could not grow were not converted
+ * by abs2rel, they are only converted here if they need to be recomputed.
+ *
+ * @param parentChanged		index of the first node of the parent that changed position,
+ * 							the number of parent nodes if none changed (default = 0, i.e. recompute)
  */
-void Organ::rel2abs()
+void Organ::rel2abs(int parentChanged)
 {
+	int changed = nodes.size(); // index of the first node that changed position
 	if(hasRelCoord())
 	{
-		nodes[0] = getOrigin(); //recompute postiion of the first node
-
-		for(size_t i=1; i<nodes.size(); i++)
-		{
-			double sdx = nodes[i].length();
-			Vector3d newdx = getIncrement(nodes[i-1], sdx, i-1); //add tropism
-			nodes[i] = nodes[i-1].plus(newdx); //replace relative by absolute position
+		bool update = (parentChanged<getParent()->getNumberOfNodes()) && (parentChanged<=std::max(parentNI, 1));
+		auto tf = orp()->f_tf;
+		update = update || (tf && (tf->ageSwitch>0));
+		if (keptAbsolute) { // the nodes did not change (see Organ::abs2rel)
+			keptAbsolute = false;
+			if (!update) {
+				moved = false;
+				for(size_t i=0; i<children.size(); i++){
+					(children[i])->rel2abs(changed);
+				}
+				return;
+			}
+			toRelative();
 		}
-		moved = true; //update position of existing nodes in MappedSegments
+		const auto& relNodes = nodes.vector(); // read only, keeps node data shared with copies of the organ
+		const auto& oldNodes = absNodes.vector();
+		update = update || (relNodes.size()!=oldNodes.size());
+		for (size_t i=1; (!update) && (i<relNodes.size()); i++) { // segment lengths changed?
+			update = (relNodes[i] != Vector3d((oldNodes[i].minus(oldNodes[i-1])).length(), 0., 0.));
+		}
+		if (update) {
+			nodes[0] = getOrigin(); //recompute postiion of the first node
+			for(size_t i=1; i<nodes.size(); i++)
+			{
+				double sdx = nodes[i].length();
+				Vector3d newdx = getIncrement(nodes[i-1], sdx, i-1); //add tropism
+				nodes[i] = nodes[i-1].plus(newdx); //replace relative by absolute position
+			}
+			changed = 0;
+			const auto& newNodes = nodes.vector();
+			while ((changed<int(newNodes.size())) && (changed<int(oldNodes.size())) && (newNodes[changed]==oldNodes[changed])) {
+				changed++;
+			}
+			moved = true; //update position of existing nodes in MappedSegments
+			setChanged();
+		} else {
+			std::swap(nodes, absNodes); // the organ did not change
+			moved = false;
+		}
+		updateLengths(1);
 	}
 	//if carry children, update their pos
 
 	for(size_t i=0; i<children.size(); i++){
-		(children[i])->rel2abs();//even if parent does not have relCoordinate, the laterals might
+		(children[i])->rel2abs(changed);//even if parent does not have relCoordinate, the laterals might
 	}
 }
 
 /**
  *  convert the nodes' positions from absolute to relative coordinates
+ *
+ *  Only organs that can grow in this time step (alive and active) are converted. The others keep their absolute
+ *  coordinates (and their node data stays shared with copies), Organ::rel2abs converts them if the parent moved.
  */
 void Organ::abs2rel()
 {
 	bool isShoot = ((organType()==Organism::ot_stem)||(organType()==Organism::ot_leaf));
 	if(isShoot||(getParent()->hasRelCoord()))//convert to relative coordinate if is shoot organ or carried by shoot organs
 	{
-		for (int j = nodes.size(); j>1; j--) {
-			double sdx = (nodes.at(j-1).minus(nodes.at(j-2))).length();
-			nodes.at(j-1) = Vector3d(sdx,0.,0.);
-			//nodes.at(j-1) = nodes.at(j-1).minus(nodes.at(j-2));
+		if (isAlive() && isActive()) {
+			toRelative();
+			moved = true; //update position of existing nodes in MappedSegments
+		} else {
+			keptAbsolute = true;
 		}
-		nodes[0] = Vector3d(0.,0.,0.);
-		moved = true; //update position of existing nodes in MappedSegments
 	}
 	for(size_t i=0; i<children.size(); i++){
 		//if((children[i])->organType()!=Organism::ot_root){
@@ -522,6 +735,21 @@ void Organ::abs2rel()
 
 }
 
+/**
+ * Replaces the absolute coordinates by the segment lengths (see Organ::abs2rel), keeps them in absNodes
+ */
+void Organ::toRelative()
+{
+	absNodes = nodes; // restored by rel2abs, if the organ does not change
+	for (int j = nodes.size(); j>1; j--) {
+		double sdx = (nodes.at(j-1).minus(nodes.at(j-2))).length();
+		nodes.at(j-1) = Vector3d(sdx,0.,0.);
+		//nodes.at(j-1) = nodes.at(j-1).minus(nodes.at(j-2));
+	}
+	nodes[0] = Vector3d(0.,0.,0.);
+	updateLengths(1);
+}
+
 /**
  * @return Current absolute heading of the organ at node n, based on initial heading, or segment before
  */
@@ -597,7 +825,7 @@ Vector3d Organ::getIncrement(const Vector3d& p, double sdx, int n)
 
     Vector3d h = heading(n);
     Matrix3d ons = Matrix3d::ons(h);
-    Vector2d ab = getOrganRandomParameter()->f_tf->getHeading(p, ons, dx(), shared_from_this(), n+1);
+    Vector2d ab = orp()->f_tf->getHeading(p, ons, dx(), shared_from_this(), n+1);
 	//for leaves: necessary?
 	//Vector2d ab = getLeafRandomParameter()->f_tf->getHeading(p, ons, dx(),shared_from_this());
     Vector3d sv = ons.times(Vector3d::rotAB(ab.x,ab.y));
@@ -682,9 +910,11 @@ void Organ::createSegments(double l, double dt, bool verbose, int PhytoIdx)
 					h.normalize();
 					nodes.at(nn-1) = Vector3d(n2.plus(h.times(sdx))); // n2.plus(newdxv)
 				}
+				updateLengths(nn-1);
                 double et = this->calcCreationTime(getLength(true)+shiftl, dt);
                 nodeCTs.at(nn-1) = et; // in case of impeded growth the node emergence time is not exact anymore, but might break down to temporal resolution
                 moved = true;
+                setChanged();
                 l -= shiftl;
                 if (l<=0) { // ==0 should be enough
                     return;
@@ -749,7 +979,7 @@ void Organ::createSegments(double l, double dt, bool verbose, int PhytoIdx)
  */
 void Organ::createLateral(double dt, bool verbose)
 { 
-	auto rp = getOrganRandomParameter(); // rename
+	auto rp = orp(); // rename
 	
 	for(int i = 0; i < rp->successorST.size(); i++){//go through each successor rule
 		//found id
@@ -771,7 +1001,7 @@ void Organ::createLateral(double dt, bool verbose)
 				
 					if((rp->successorOT.size()>i)&&(rp->successorOT.at(i).size()>p_id)){
 						ot = rp->successorOT.at(i).at(p_id);
-					}else{ot = getParameter("organType");}//default
+					}else{ot = getParameter(pk_organType);}//default
 					
 					int st = rp->successorST.at(i).at(p_id);
 				
@@ -815,7 +1045,7 @@ void Organ::createLateral(double dt, bool verbose)
 bool Organ::getApplyHere(int i) const
 {
 	bool applyHere;
-	auto rp = getOrganRandomParameter(); // rename
+	auto rp = orp(); // rename
 	if((rp->successorWhere.size()>i)&&(rp->successorWhere.at(i).size()>0)){
 			if(!std::signbit(rp->successorWhere.at(i).at(0)))//true if number is signed
 			{//gave which linking nodes to include
@@ -853,7 +1083,7 @@ double Organ::getLatInitialGrowth(double dt)
  */
 double Organ::getLatGrowthDelay(int ot_lat, int st_lat, double dt) const //override for stems
 {
-	auto rp = getOrganRandomParameter(); // rename
+	auto rp = orp(); // rename
 	double growthDelay; //store necessary variables to define lateral growth delay
 	int delayDefinition = std::static_pointer_cast<const SeedRandomParameter>(getOrganism()->getOrganRandomParameter(Organism::ot_seed,0))->delayDefinition;
 
@@ -862,8 +1092,8 @@ double Organ::getLatGrowthDelay(int ot_lat, int st_lat, double dt) const //overr
 	switch(delayDefinition){
 		case Organism::dd_distance:
 		{
-			double meanLn = getParameter("lnMean"); // mean inter-lateral distance
-			double effectiveLa = std::max(getParameter("la")-meanLn/2, 0.); // effective apical distance, observed apical distance is in [la-ln/2, la+ln/2]
+			double meanLn = getParameter(pk_lnMean); // mean inter-lateral distance
+			double effectiveLa = std::max(getParameter(pk_la)-meanLn/2, 0.); // effective apical distance, observed apical distance is in [la-ln/2, la+ln/2]
 			double ageLN = this->calcAge(getLength(true)); // theoretical age of root when lateral node is created
 			ageLN = std::max(ageLN, age-dt);
 			double ageLG = this->calcAge(getLength(true)+effectiveLa); // age of the root, when the lateral starts growing (i.e when the apical zone is developed)
@@ -901,6 +1131,9 @@ double Organ::getLatGrowthDelay(int ot_lat, int st_lat, double dt) const //overr
  */
 bool Organ::hasRelCoord() const
 {
+	if (keptAbsolute) { // see Organ::abs2rel
+		return true;
+	}
 	bool nullNode0 = (nodes.at(0) == Vector3d(0.,0.,0.));
 	bool isSeed = organType() == Organism::ot_seed;
 	bool basalOrgan = true;
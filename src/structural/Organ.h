@@ -3,6 +3,7 @@
 #define ORGAN_H_
 
 #include "mymath.h"
+#include "cowvector.h"
 
 #include "tinyxml2.h"
 
@@ -36,13 +37,25 @@ class Organ : public std::enable_shared_from_this<Organ>
 {
 public:
 
+    enum ParameterKeys { pk_subType = 0, pk_type, pk_a, pk_radius, pk_diameter, pk_iHeadingX, pk_iHeadingY, pk_iHeadingZ,
+        pk_parentNI, pk_parentNode, pk_organType, pk_numberOfChildren, pk_id, pk_alive, pk_active, pk_age, pk_length,
+        pk_lengthTh, pk_numberOfNodes, pk_numberOfSegments, pk_hasMoved, pk_oldNumberOfNodes, pk_numberOfLaterals,
+        pk_creationTime, pk_order, pk_one, pk_lb, pk_la, pk_r, pk_theta, pk_rlt, pk_nob, pk_k, pk_lmax, pk_lnMean, pk_lnDev,
+        pk_rootLength, pk_volume, pk_surface, pk_delayNGStart, pk_delayNGEnd, pk_shapeType, pk_Width_petiole, pk_Width_blade,
+        pk_volume_th, pk_surface_th, pk_volume_realized, pk_surface_realized, pk_numberOfKeys };
+    ///< keys of the organ parameters, further names (of the organ random parameters) get keys >= pk_numberOfKeys
+    static const std::vector<std::string> parameterKeyNames; ///< names of the parameter keys < pk_numberOfKeys
+
+    static int parameterKey(const std::string& name); ///< integer key of a parameter name (resolve once, and use Organ::getParameter(int))
+    static std::string parameterName(int key); ///< parameter name of a key
+
     Organ(int id, std::shared_ptr<const OrganSpecificParameter> param, bool alive, bool active, double age, double length,
     		Vector3d partialIHeading_,  int pni, bool moved = false, int oldNON = 0); ///< creates everything from scratch
     Organ(std::shared_ptr<Organism> plant, std::shared_ptr<Organ> parent, int organtype, int subtype, double delay,
     		int pni); ///< used within simulation
     virtual ~Organ() { }
 
-    virtual std::shared_ptr<Organ> copy(std::shared_ptr<Organism> plant); ///< deep copies the organ tree
+    virtual std::shared_ptr<Organ> copy(std::shared_ptr<Organism> plant, bool share = false); ///< deep copies the organ tree
 
     virtual int organType() const; ///< returns the organs type, overwrite for each organ
 
@@ -53,6 +66,7 @@ public:
     void setOrganism(std::shared_ptr<Organism> p) { plant = p; } ///< sets the organism of which the organ is part of
     std::shared_ptr<Organism> getOrganism() const { return plant.lock(); } ///< parent organism
     void setParent(std::shared_ptr<Organ> p) { parent = p; } ///< sets parent organ
+    void resolveOrganRandomParameter(); ///< looks up the organ type parameter of the organ and its children (see Organ::orp)
     std::shared_ptr<Plant> getPlant() const; ///< parent Organism (with a dynamic cast to Plant class)
     std::shared_ptr<Organ> getParent() const { return parent.lock(); } ///< parent organ
     void addChild(std::shared_ptr<Organ> c); ///< adds an subsequent organ
@@ -65,9 +79,9 @@ public:
     std::shared_ptr<OrganRandomParameter> getOrganRandomParameter() const;  ///< organ type parameter
     bool isAlive() const { return alive; } ///< checks if alive
     bool isActive() const { return active; } ///< checks if active
-    double getAge() const { return age; } ///< return age of the organ
+    virtual double getAge() const { return age; } ///< return age of the organ
     double getLength(bool realized = true) const; ///< length of the organ (realized => dependent on dx() and dxMin())
-    double getLength(int i) const; ///< length of the organ up to node index i, e.g. parent base length is getParent()->getLength(parentNI)
+    double getLength(int i) const; ///< length of the organ up to node index i, e.g. parent base length is getParent()->getLength(parentNI), O(1)
 	double getEpsilon() const { return epsilonDx; } ///< return stored growth not yet added because too small
 	virtual double calcAge(double length) const {throw std::runtime_error( "calcAge() not implemented" ); } ///< needed for @Organ::getOrgans
 	virtual double calcLength(double age){throw std::runtime_error( "calcLength() not implemented" ); }
@@ -87,20 +101,24 @@ public:
     std::vector<Vector2i> getSegments() const; ///< per default, the organ is represented by a polyline
 	double dx() const; ///< returns the max axial resolution
 	double dxMin() const; ///< returns the min axial resolution
-    void rel2abs() ;
+    void rel2abs(int parentChanged = 0); ///< relative to absolute coordinates, recomputes only organs that changed
 	void abs2rel() ;
 
 	void moveOrigin(int idx);//change idx of first node, in case of nodal growth
+	void shiftIds(int organBase, int organShift, int nodeBase, int nodeShift); ///< renumbers the ids handed out by a growth task, see Organism::simulateOrgans
+	virtual void shiftPhytomerIds(int organBase, const std::vector<int>& leafShift, const std::vector<int>& stemShift); ///< makes the phytomer ids of a growth task plant-wide, see Organism::simulateOrgans
 	double calcCreationTime(double length, double dt); ///< analytical creation (=emergence) time of a node at a length
 
     /* last time step */
     virtual bool hasMoved() const { return moved; }; ///< have any nodes moved during the last simulate call
     int getOldNumberOfNodes() const { return oldNumberOfNodes; } ///< the number of nodes before the last simulate call
+    void setChanged(); ///< registers the organ as changed in the current time step, see Organism::getStepDelta
 
     /* for post processing */
     std::vector<std::shared_ptr<Organ>> getOrgans(int ot=-1, bool all = false); ///< the organ including children in a sequential vector
     void getOrgans(int otype, std::vector<std::shared_ptr<Organ>>& v, bool all = false); ///< the organ including children in a sequential vector
-    virtual double getParameter(std::string name) const; ///< returns an organ parameter
+    double getParameter(std::string name) const { return getParameter(parameterKey(name)); } ///< returns an organ parameter
+    virtual double getParameter(int key) const; ///< returns an organ parameter, by its key (@see Organ::parameterKey)
 	int getNumberOfLaterals() const; ///< the number of emerged laterals (i.e. number of children with age>0)
 
     /* IO */
@@ -114,7 +132,7 @@ public:
 	bool hasRelCoord() const; //check if organ has relative coordinates
 	/* for carbon-limited growth (know future (or past) volume (or length))*/
 	virtual double orgVolume(double length_ = -1.,  bool realized = false) const;//organ volume for current or for a specific length
-	virtual double orgVolume2Length(double volume_){return volume_/(M_PI * getParameter("radius")* getParameter("radius"));}	//organ length for specific volume
+	virtual double orgVolume2Length(double volume_){return volume_/(M_PI * getParameter(pk_radius)* getParameter(pk_radius));}	//organ length for specific volume
 protected:
 
     mutable Vector3d partialIHeading;//variables mutable in case of pseudo stem (see @Leaf::heading)
@@ -123,17 +141,20 @@ protected:
 	virtual void storeLinkingNodeLocalId(int numCreatedLN, bool silence){;}; ///<  overriden by @see Stem::storeLinkingNodeLocalId()
 	virtual Vector3d getIncrement(const Vector3d& p, double sdx, int n = -1); ///< called by createSegments, to determine growth direction. overriden by @see Leaf::getIncrement()
     void createSegments(double l, double dt, bool silence, int PhytoIdx = -1 ); ///< creates segments of length l, called by Root::simulate()
+    void updateLengths(size_t first); ///< updates nodeLengths from node index first on, call after the nodes changed
     virtual double getLatInitialGrowth(double dt);
 	virtual double getLatGrowthDelay(int ot_lat, int st_lat, double dt) const;
 	bool getApplyHere(int i) const;
+	OrganRandomParameter* orp() const; ///< organ type parameter, resolved and non-owning (for the growth hot paths)
 	/* up and down the organ tree */
     std::weak_ptr<Organism> plant; ///< the plant of which this organ is part of
     std::weak_ptr<Organ> parent; ///< pointer to the parent organ (nullptr if it has no parent)
     std::vector<std::shared_ptr<Organ>> children; ///< the successive organs
 
     /* Parameters that are constant over the organ life time */
-    const int id; ///< unique organ id
+    int id; ///< unique organ id (only renumbered by Organ::shiftIds)
     std::shared_ptr<const OrganSpecificParameter> param_; ///< the parameter set of this organ (@see getParam())
+    OrganRandomParameter* orp_ = nullptr; ///< organ type parameter, see Organ::orp and Organ::resolveOrganRandomParameter
 
     /* Parameters are changing over time */
     bool alive = true; ///< true: alive, false: dead
@@ -144,14 +165,19 @@ protected:
 	size_t created_linking_node = 0;///number of nodes which carry childrens
 
     /* node data */
-    std::vector<Vector3d> nodes; ///< nodes of the organ [cm]
-    std::vector<int> nodeIds; ///< global node indices
-    std::vector<double> nodeCTs; ///< node creation times [days]
+    CowVector<Vector3d> nodes; ///< nodes of the organ [cm] (shared with copies of the organ until modified)
+    CowVector<int> nodeIds; ///< global node indices
+    CowVector<double> nodeCTs; ///< node creation times [days]
+    CowVector<double> nodeLengths; ///< length of the organ up to node i [cm], see Organ::getLength(int)
 
     /* last time step */
     bool moved = false; ///< nodes moved during last time step
     int oldNumberOfNodes = 0; ///< number of nodes at the end of previous time step
+    int changedStep = -1; ///< last time step the organ was registered as changed (see Organ::setChanged)
     bool firstCall = true;
+    CowVector<Vector3d> absNodes; ///< absolute coordinates of the nodes, kept by abs2rel for rel2abs
+    bool keptAbsolute = false; ///< treated as in relative coordinates, but abs2rel did not convert the nodes (the organ cannot grow)
+    void toRelative(); ///< converts the nodes to relative coordinates, see Organ::abs2rel
 };
 
 } // namespace CPlantBox
@@ -3,18 +3,23 @@
 
 #include "Organ.h"
 #include "Seed.h"
+#include "Plant.h"
 #include "organparameter.h"
+#include "VTPWriter.h"
+#include "parallel.h"
 
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
 #include <ctime>
 #include <numeric>
+#include <algorithm>
 
 namespace CPlantBox {
 
 std::vector<std::string> Organism::organTypeNames = { "organ", "seed", "root", "stem", "leaf" };
-int Organism::instances = 0; // number of instances
+std::atomic<int> Organism::instances(0); // number of instances
+thread_local GrowthTask* Organism::growthTask = nullptr;
 
 /**
  * Constructs organism, initializes random number generator
@@ -58,18 +63,31 @@ std::string Organism::organTypeName(int ot)
 
 /**
  * Deep copies the organism
+ *
+ * The node data of the organs is shared between the organism and its copy, until an organ changes it
+ * (copy on write, see CowVector), i.e. only the nodes of organs that grow after the copy are duplicated.
+ *
+ * A fork (@param share = true) additionally shares the organ specific parameters (which are constant).
+ * This makes it cheap to branch many scenarios from one simulation (e.g. different management after a spin up).
+ * The organ random parameters are copied in both cases, since they point to their organism.
+ *
+ * @param share     share the organ specific parameters with this organism (default = false)
  */
-std::shared_ptr<Organism> Organism::copy()
+std::shared_ptr<Organism> Organism::copy(bool share)
 {
     auto no = std::make_shared<Organism>(*this); // copy constructor
+    no->stepDeltaValid = false; // stepDelta points to the organs of this organism
+    no->changedOrgans.clear();
+    no->changedOrgansValid = false;
     for (int i = 0; i < baseOrgans.size(); i++) {
-        no->baseOrgans[i] = baseOrgans[i]->copy(no);
+        no->baseOrgans[i] = baseOrgans[i]->copy(no, share);
     }
     for (int ot = 0; ot < numberOfOrganTypes; ot++) { // copy organ type parameters
         for (auto& otp : no->organParam[ot]) {
             otp.second = otp.second->copy(no);
         }
     }
+    no->resolveOrganRandomParameters(); // the copied organs still point to the parameters of this organism
     return no;
 }
 
@@ -120,9 +138,21 @@ void Organism::setOrganRandomParameter(std::shared_ptr<OrganRandomParameter> p)
 {
     assert(p->plant.lock().get()==this && "OrganTypeParameter::plant should be this organism");
     organParam[p->organType][p->subType] = p;
+    resolveOrganRandomParameters(); // the organs might point to the replaced parameter
     // std::cout << "setting organ type " << p->organType << ", sub type " << p->subType << ", name "<< p->name << "\n";
 }
 
+/**
+ * Organs keep a pointer to their organ random parameter (see Organ::orp), which is looked up again for all organs,
+ * after organ random parameters were replaced or copied
+ */
+void Organism::resolveOrganRandomParameters()
+{
+    for (const auto& o : baseOrgans) {
+        o->resolveOrganRandomParameter();
+    }
+}
+
 /**
  * @return Get the organ sub type by its name
  *
@@ -164,12 +194,92 @@ void Organism::simulate(double dt, bool verbose)
 	this->dt = dt;
     oldNumberOfNodes = getNumberOfNodes();
     oldNumberOfOrgans = getNumberOfOrgans();
-    for (const auto& r : baseOrgans) {
-        r->simulate(dt, verbose);
-    }
+    stepDeltaValid = false;
+    step++;
+    changedOrgans.clear();
+    changedOrgansValid = true;
+    simulateOrgans(baseOrgans, dt, verbose);
     simtime+=dt;
 }
 
+/**
+ * Simulates the organs (and their laterals) for a time span of @param dt days,
+ * called by Organism::simulate for the base organs, and by Organ::simulate (e.g. for the organs of the seed).
+ *
+ * If there is more than one organ, each organ grows as an independent task: with its own random stream and phytomer
+ * counters (GrowthTask). The tasks run on up to Organism::parallel threads (see Organism::setParallel), or one after
+ * another on the calling thread (parallel = 0 or 1). Organ, node, and phytomer ids handed out by a task are provisional,
+ * afterwards they are renumbered as if the organs had grown one after another. Therefore, the results do not depend
+ * on the number of threads, and the serial simulation gives the same results. Since the organs grow as tasks, seeded
+ * organisms with more than one base (or seed) organ draw other random numbers than before.
+ *
+ * @param organs    the organs (e.g. the base organs)
+ * @param dt        time step [day]
+ * @param verbose   turns console output on or off
+ */
+void Organism::simulateOrgans(const std::vector<std::shared_ptr<Organ>>& organs, double dt, bool verbose)
+{
+    if ((organs.size()<2) || growthTask) { // a single organ, or already within a task
+        for (const auto& o : organs) {
+            o->simulate(dt, verbose);
+        }
+        return;
+    }
+    size_t n = organs.size();
+    for (size_t i = growthTasks.size(); i<n; i++) { // organs are only appended
+        std::seed_seq seq { seed_val, (unsigned int)i };
+        growthTasks.push_back(GrowthTask());
+        growthTasks.back().gen = std::mt19937(seq);
+    }
+    for (size_t i = 0; i<n; i++) {
+        growthTasks[i].organId = organId;
+        growthTasks[i].nodeId = nodeId;
+        std::fill(growthTasks[i].leafphytomerID.begin(), growthTasks[i].leafphytomerID.end(), 0);
+        std::fill(growthTasks[i].stemphytomerID.begin(), growthTasks[i].stemphytomerID.end(), 0);
+        growthTasks[i].changedOrgans.clear();
+    }
+
+    parallelFor(n, parallel, [&](size_t i) {
+        growthTask = &growthTasks[i];
+        try {
+            organs[i]->simulate(dt, verbose);
+        } catch (...) {
+            growthTask = nullptr;
+            throw;
+        }
+        growthTask = nullptr;
+    });
+
+    int organShift = 0; // renumber the new ids in the order of the organs
+    int nodeShift = 0;
+    auto plant = organs[0]->getPlant(); // phytomers are counted per plant
+    std::vector<int> leafShift = plant ? plant->leafphytomerID : std::vector<int>(10, 0);
+    std::vector<int> stemShift = plant ? plant->stemphytomerID : std::vector<int>(10, 0);
+    for (size_t i = 0; i<n; i++) {
+        organs[i]->shiftPhytomerIds(organId, leafShift, stemShift); // before shiftIds, new organs are identified by their provisional id
+        if ((organShift>0) || (nodeShift>0)) {
+            organs[i]->shiftIds(organId, organShift, nodeId, nodeShift);
+        }
+        organShift += growthTasks[i].organId-organId;
+        nodeShift += growthTasks[i].nodeId-nodeId;
+        for (size_t j = 0; j<leafShift.size(); j++) {
+            leafShift[j] += growthTasks[i].leafphytomerID.at(j);
+            stemShift[j] += growthTasks[i].stemphytomerID.at(j);
+        }
+    }
+    organId += organShift;
+    nodeId += nodeShift;
+    for (size_t i = 0; i<n; i++) { // in the order of the organs
+        auto& co = growthTasks[i].changedOrgans;
+        changedOrgans.insert(changedOrgans.end(), co.begin(), co.end());
+        co.clear();
+    }
+    if (plant) {
+        plant->leafphytomerID = leafShift;
+        plant->stemphytomerID = stemShift;
+    }
+}
+
 /**
  * Creates a sequential list of organs. Considers only organs with more than 1 node.
  *
@@ -204,13 +314,43 @@ std::vector<double> Organism::getParameter(std::string name, int ot, std::vector
     if (organs.empty()) {
         organs = getOrgans(ot);
     }
+    int key = Organ::parameterKey(name); // resolve once
     std::vector<double> p = std::vector<double>(organs.size());
     for (int i=0; i<organs.size(); i++) {
-        p[i] = organs[i]->getParameter(name);
+        p[i] = organs[i]->getParameter(key);
     }
     return p;
 }
 
+/**
+ * Returns a table of parameter values, with one row per organ and one column per parameter name,
+ * obtained in a single pass over the organs (e.g. for exporting many parameters)
+ *
+ * @param names     parameter names (keys are resolved once, @see Organ::parameterKey)
+ * @param ot        organ type, -1 for all organ types (default)
+ * @param organs    optionally, a list of organs, in this case ot is ignored
+ * @return column major table, i.e. the value of parameter j of organ i is at index j*organs.size()+i
+ */
+std::vector<double> Organism::getParameters(const std::vector<std::string>& names, int ot,
+    std::vector<std::shared_ptr<Organ>> organs) const
+{
+    if (organs.empty()) {
+        organs = getOrgans(ot);
+    }
+    std::vector<int> keys(names.size());
+    for (size_t j = 0; j<names.size(); j++) {
+        keys[j] = Organ::parameterKey(names[j]);
+    }
+    size_t n = organs.size();
+    std::vector<double> table(keys.size()*n);
+    for (size_t i = 0; i<n; i++) {
+        for (size_t j = 0; j<keys.size(); j++) {
+            table[j*n+i] = organs[i]->getParameter(keys[j]);
+        }
+    }
+    return table;
+}
+
 /**
  * Returns the summed parameter, obtained by Organism::getParameters (e.g. getSummed("length"))
  *
@@ -547,6 +687,77 @@ std::vector<std::shared_ptr<Organ>> Organism::getNewSegmentOrigins(int ot) const
     return so;
 }
 
+/**
+ * Collects the growth of the last time step in a single pass over the organ tree, i.e. the same information as
+ * Organism::getUpdatedNodeIndices, Organism::getUpdatedNodes, Organism::getUpdatedNodeCTs, Organism::getNewNodes,
+ * Organism::getNewNodeCTs, Organism::getNewSegments, and Organism::getNewSegmentOrigins (for all organ types),
+ * and the organs themselves.
+ *
+ * The result is computed once after each simulate call, and reused for further calls. Only the organs that changed
+ * in the last time step are visited (see Organ::setChanged), or all organs (before the first simulate call, and after
+ * Organism::copy, RootSystem::pop, or a reset).
+ *
+ * @return the growth of the last time step
+ */
+const StepDelta& Organism::getStepDelta()
+{
+    if (stepDeltaValid) {
+        return stepDelta;
+    }
+    auto& d = stepDelta;
+    int nnn = getNumberOfNewNodes();
+    d.movedNodeIds.clear();
+    d.movedNodes.clear();
+    d.movedNodeCTs.clear();
+    d.newNodes.assign(nnn, Vector3d());
+    d.newNodeCTs.assign(nnn, 0.);
+    d.newSegments.clear();
+    d.newSegments.reserve(nnn);
+    d.newSegmentOrigins.clear();
+    d.newSegmentOrigins.reserve(nnn);
+    d.newSegmentOrganTypes.clear();
+    d.newSegmentOrganTypes.reserve(nnn);
+    if (changedOrgansValid) {
+        d.organs.clear();
+        for (const auto& o : changedOrgans) {
+            if ((o->getNumberOfNodes()>1) && (o->organType()!=Organism::ot_seed)) { // as Organism::getOrgans
+                d.organs.push_back(o);
+            }
+        }
+    } else {
+        d.organs = getOrgans();
+    }
+    for (const auto& o : d.organs) {
+        int onon = o->getOldNumberOfNodes();
+        int non = o->getNumberOfNodes();
+        int ot = o->organType();
+        if (o->hasMoved()&&(onon>1)) { // moved nodes
+            int first = (ot>2) ? 1 : onon-1; // for stem and leaves, all old nodes can move
+            for (int i = first; i<onon; i++) {
+                d.movedNodeIds.push_back(o->getNodeId(i));
+                d.movedNodes.push_back(o->getNode(i));
+                d.movedNodeCTs.push_back(o->getNodeCT(i));
+            }
+        }
+        for (int i = onon; i<non; i++) { // new nodes
+            int ni = o->getNodeId(i)-oldNumberOfNodes;
+            d.newNodes.at(ni) = o->getNode(i);
+            if (i>0) { // never copy the root emergence time
+                d.newNodeCTs.at(ni) = o->getNodeCT(i);
+            }
+        }
+        if (onon>0) {
+            for (int i = onon-1; i<non-1; i++) { // new segments
+                d.newSegments.push_back(Vector2i(o->getNodeId(i),o->getNodeId(i+1)));
+                d.newSegmentOrigins.push_back(o);
+                d.newSegmentOrganTypes.push_back(ot);
+            }
+        }
+    }
+    stepDeltaValid = true;
+    return stepDelta;
+}
+
 /**
  * @return Quick info about the object for debugging
  */
@@ -659,8 +870,10 @@ void Organism::writeParameters(std::string name, std::string basetag, bool comme
  * (that must be lower case)
  *
  * @param name      file name e.g. output.vtp
+ * @param format    for vtp: VTPWriter::ascii (default), VTPWriter::raw, or VTPWriter::base64
+ * @param compressed    for binary vtp: zlib compressed data blocks (default = false)
  */
-void Organism::write(std::string name) const
+void Organism::write(std::string name, int format, bool compressed) const
 {
     std::string ext = name.substr(name.size()-3,name.size()); // pick the right writer
     if (ext.compare("sml")==0) {
@@ -669,8 +882,8 @@ void Organism::write(std::string name) const
     } else if (ext.compare("vtp")==0) {
         std::cout << "writing VTP... "<< name.c_str() <<"\n";
         std::ofstream fos;
-        fos.open(name.c_str());
-        writeVTP(-1, fos);
+        fos.open(name.c_str(), std::ios::binary);
+        writeVTP(-1, fos, format, compressed);
         fos.close();
     } else if (ext.compare(".py")==0)  {
         std::cout << "writing Geometry ... "<< name.c_str() <<"\n";
@@ -684,87 +897,72 @@ void Organism::write(std::string name) const
 }
 
 /**
-write VTP using tinyXML
- **/
-void Organism::writeVTP(int otype, std::ostream & os) const // Write .VTP file by using TinyXML2 performance slowed by 0.5 seconds but precision increased
+ * Writes the organs as polylines into a VTP file (@see VTPWriter).
+ * Node creation times are point data, the organ parameters are cell data.
+ *
+ * The data are collected in a single traversal of the organs.
+ *
+ * @param otype         the expected organ type, where -1 denotes all organ types
+ * @param os            typically a file out stream (opened in binary mode for binary formats)
+ * @param format        VTPWriter::ascii (default), VTPWriter::raw, or VTPWriter::base64
+ * @param compressed    for binary formats: zlib compressed data blocks (default = false)
+ */
+void Organism::writeVTP(int otype, std::ostream & os, int format, bool compressed) const
 {
-    tinyxml2::XMLPrinter printer( 0, false, 0 );
+    VTPWriter writer(os, format, compressed);
 
     auto organs = this->getOrgans(otype); // update roots (if necessary)
-    auto nodes = getPolylines(otype);
-    auto times = getPolylineCTs(otype);
-
-    os << "<?xml version=\"1.0\"?>";
-    printer.OpenElement("VTKFile"); printer.PushAttribute("type", "PolyData"); printer.PushAttribute("version", "0.1"); printer.PushAttribute("byte_order", "LittleEndian");
-    printer.OpenElement("PolyData");
-    int non = 0; // number of nodes
-    for (const auto& r : organs) {
-        non += r->getNumberOfNodes();
-    }
-    int nol=organs.size(); // number of lines
-    printer.OpenElement("Piece"); printer.PushAttribute("NumberOfLines",  nol); printer.PushAttribute("NumberOfPoints", non);
-
-    // POINTDATA
-    printer.OpenElement("PointData"); printer.PushAttribute("Scalars", "Pointdata");
-    printer.OpenElement("DataArray"); printer.PushAttribute("type", "Float32");  printer.PushAttribute("Name", "time"); printer.PushAttribute("NumberOfComponents", "1"); printer.PushAttribute("format", "ascii" );
-    for (std::vector<double> r: times) {
-        for (double t : r) {
-            printer.PushText(t); printer.PushText(" ");
-        }
-    }
-    printer.CloseElement();
-    printer.CloseElement();
-
-    // CELLDATA (live on the polylines)
-    printer.OpenElement("CellData"); printer.PushAttribute("Scalars", "CellData" );
-    std::vector<std::string> sTypeNames = { "organType", "id", "creationTime", "age", "subType", "order", "radius"}; //  , "order", "radius", "subtype" ,
-    for (size_t i=0; i<sTypeNames.size(); i++) {
-        std::string sType = sTypeNames[i];
-        const char *schar = sType.c_str();
-        printer.OpenElement("DataArray"); printer.PushAttribute("type", "Float32");  printer.PushAttribute("Name", schar); printer.PushAttribute("NumberOfComponents", "1"); printer.PushAttribute("format", "ascii" );
-        std::vector<double> scalars = getParameter(sTypeNames[i], otype);
-        for (double s : scalars) {
-            printer.PushText(s); printer.PushText(" ");
-        }
-        printer.CloseElement();
+    size_t non = 0; // number of nodes
+    for (const auto& o : organs) {
+        non += o->getNumberOfNodes();
     }
-    printer.CloseElement();
+    size_t nol = organs.size(); // number of lines
 
-    // POINTS (=nodes)
-    printer.OpenElement("Points");
-    printer.OpenElement("DataArray"); printer.PushAttribute("type", "Float32");  printer.PushAttribute("Name", "Coordinates"); printer.PushAttribute("NumberOfComponents", "3"); printer.PushAttribute("format", "ascii" );
-    for (const auto& r : nodes) {
-        for (const auto& n : r) {
-            printer.PushText(n.x); printer.PushText(" "); printer.PushText(n.y); printer.PushText(" "); printer.PushText(n.z); printer.PushText(" ");
-        }
+    std::vector<std::string> sTypeNames = { "organType", "id", "creationTime", "age", "subType", "order", "radius"};
+    std::vector<int> sTypeKeys(sTypeNames.size());
+    for (size_t i = 0; i<sTypeNames.size(); i++) {
+        sTypeKeys[i] = Organ::parameterKey(sTypeNames[i]);
     }
-    printer.CloseElement();
-    printer.CloseElement();
-
-    // LINES (polylines)
-    printer.OpenElement("Lines");
-    printer.OpenElement("DataArray"); printer.PushAttribute("type", "Int32");  printer.PushAttribute("Name", "connectivity"); printer.PushAttribute("NumberOfComponents", "1"); printer.PushAttribute("format", "ascii" );
-    int c=0;
-    for (const auto& r : organs) {
-        for (size_t i=0; i<r->getNumberOfNodes(); i++) {
-            printer.PushText(c); printer.PushText(" ");
+    std::vector<std::vector<double>> scalars(sTypeNames.size(), std::vector<double>(nol));
+    std::vector<double> times(non);
+    std::vector<double> coords(3*non);
+    std::vector<int> connectivity(non);
+    std::vector<int> offsets(nol);
+    int c = 0;
+    for (size_t j = 0; j<nol; j++) {
+        const auto& o = organs[j];
+        for (size_t i = 0; i<sTypeNames.size(); i++) {
+            scalars[i][j] = o->getParameter(sTypeKeys[i]);
+        }
+        for (size_t i = 0; i<o->getNumberOfNodes(); i++) {
+            Vector3d n = o->getNode(i);
+            coords[3*c] = n.x;
+            coords[3*c+1] = n.y;
+            coords[3*c+2] = n.z;
+            times[c] = o->getNodeCT(i);
+            connectivity[c] = c;
             c++;
         }
+        offsets[j] = c;
     }
-    printer.CloseElement();
 
-    printer.OpenElement("DataArray"); printer.PushAttribute("type", "Int32");  printer.PushAttribute("Name", "offsets"); printer.PushAttribute("NumberOfComponents", "1"); printer.PushAttribute("format", "ascii" );
-    c = 0;
-    for (const auto& r : organs) {
-        c += r->getNumberOfNodes();
-        printer.PushText(c); printer.PushText(" ");
+    writer.open(nol, non);
+    writer.openSection("PointData", "Scalars=\"Pointdata\"");
+    writer.addArray("time", times);
+    writer.closeSection("PointData");
+    writer.openSection("CellData", "Scalars=\"CellData\""); // live on the polylines
+    for (size_t i = 0; i<sTypeNames.size(); i++) {
+        writer.addArray(sTypeNames[i], scalars[i]);
     }
-    printer.CloseElement();
-    printer.CloseElement();
-    printer.CloseElement();
-    printer.CloseElement();
-    printer.CloseElement();
-    os << std::string(printer.CStr());
+    writer.closeSection("CellData");
+    writer.openSection("Points");
+    writer.addArray("Coordinates", coords, 3);
+    writer.closeSection("Points");
+    writer.openSection("Lines");
+    writer.addArray("connectivity", connectivity);
+    writer.addArray("offsets", offsets);
+    writer.closeSection("Lines");
+    writer.close();
 }
 
 /**
@@ -867,7 +1065,9 @@ tinyxml2:: XMLElement* Organism::getRSMLScene(tinyxml2::XMLDocument& xmlDoc) con
  */
 void Organism::setSeed(unsigned int seed)
 {
+    seed_val = seed; // also keys the random streams of the tropisms
     this->gen = std::mt19937(seed);
+    growthTasks.clear(); // are seeded again, see Organism::simulateOrgans
 }
 
 /**
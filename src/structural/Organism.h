@@ -12,6 +12,7 @@
 #include <map>
 #include <array>
 #include <memory>
+#include <atomic>
 #include <iostream>
 
 namespace CPlantBox {
@@ -20,6 +21,37 @@ class Organ;
 class OrganRandomParameter;
 class Seed;
 
+/**
+ * Growth of the organism during the last time step, collected in a single pass over the organ tree,
+ * see Organism::getStepDelta()
+ */
+struct StepDelta {
+    std::vector<int> movedNodeIds; ///< indices of nodes that were moved, see Organism::getUpdatedNodeIndices
+    std::vector<Vector3d> movedNodes; ///< new coordinates of the moved nodes
+    std::vector<double> movedNodeCTs; ///< new creation times of the moved nodes
+    std::vector<Vector3d> newNodes; ///< nodes created in the last time step, see Organism::getNewNodes
+    std::vector<double> newNodeCTs; ///< creation times of the new nodes, see Organism::getNewNodeCTs
+    std::vector<Vector2i> newSegments; ///< segments created in the last time step, see Organism::getNewSegments
+    std::vector<std::shared_ptr<Organ>> newSegmentOrigins; ///< organs containing the new segments, see Organism::getNewSegmentOrigins
+    std::vector<int> newSegmentOrganTypes; ///< organ types of the new segments
+    std::vector<std::shared_ptr<Organ>> organs; ///< organs that changed (new or moved nodes, moved origin, or growing leaves)
+};
+
+/**
+ * State of a base organ (and its laterals) growing independently of the other base organs,
+ * see Organism::simulateOrgans
+ */
+struct GrowthTask {
+    std::mt19937 gen; ///< random stream of the base organ, seeded by the organism's seed and the base organ index
+    std::uniform_real_distribution<double> UD;
+    std::normal_distribution<double> ND;
+    std::vector<int> leafphytomerID = std::vector<int>(10, 0); ///< leaf phytomers counted in the current time step (made plant-wide afterwards)
+    std::vector<int> stemphytomerID = std::vector<int>(10, 0); ///< stem phytomers counted in the current time step (made plant-wide afterwards)
+    int organId = -1; ///< last organ id handed out in the current time step (renumbered afterwards)
+    int nodeId = -1; ///< last node id handed out in the current time step (renumbered afterwards)
+    std::vector<std::shared_ptr<Organ>> changedOrgans; ///< organs that changed in the current time step (appended to the organism's list afterwards)
+};
+
 /**
  * Organism
  *
@@ -40,7 +72,7 @@ public:
 	enum DelayDefinition { dd_distance = 0, dd_time_lat = 1, dd_time_self = 2}; ///< definition of the growth delay
     enum OrganTypes { ot_organ = 0, ot_seed = 1, ot_root = 2, ot_stem = 3, ot_leaf = 4 }; ///< coarse organ classification
     static std::vector<std::string> organTypeNames; ///< names of the organ types
-    static int instances; ///< the number of instances of this or derived classes
+    static std::atomic<int> instances; ///< the number of instances of this or derived classes
 
     static int organTypeNumber(std::string name); ///< organ type number from a string
     static std::string organTypeName(int ot); ///< organ type name from an organ type number
@@ -48,7 +80,8 @@ public:
     Organism(unsigned int seednum  = 0); ///< constructor
     virtual ~Organism() { }; ///< destructor
 
-    virtual std::shared_ptr<Organism> copy(); ///< deep copies the organism
+    virtual std::shared_ptr<Organism> copy(bool share = false); ///< deep copies the organism
+    std::shared_ptr<Organism> fork() { return copy(true); } ///< copies the organism for scenario branching, sharing its history (see Organism::copy)
 	/* organs */
 	std::shared_ptr<Seed> getSeed(); ///< the plant seed
 
@@ -63,12 +96,18 @@ public:
     void addOrgan(std::shared_ptr<Organ> o) { baseOrgans.push_back(o); } ///< adds an organ, takes ownership
     virtual void initialize(bool verbose = true); ///< overwrite for initialization jobs
     virtual void simulate(double dt, bool verbose = false); ///< calls the base organs simulate methods
+    void simulateOrgans(const std::vector<std::shared_ptr<Organ>>& organs, double dt, bool verbose = false); ///< simulates the organs, in parallel if enabled
+    void setParallel(int threads) { parallel = threads; } ///< grows the base organs on up to @param threads threads (0 or 1 = serial), the results do not depend on it
+    int getParallel() const { return parallel; } ///< number of threads for the base organs, 0 or 1 if serial
+    void setSkipFinished(bool skip) { skipFinished = skip; } ///< finished root subtrees are only visited when a root dies (default), see Root::simulate
+    bool getSkipFinished() const { return skipFinished; } ///< finished root subtrees are skipped
     double getSimTime() const { return simtime; } ///< returns the current simulation time
     double getDt() const { return dt; } ///< returns the current simulation duration/time step
 
     /* as sequential list */
     std::vector<std::shared_ptr<Organ>> getOrgans(int ot=-1, bool all = false) const; ///< sequential list of organs
     virtual std::vector<double> getParameter(std::string name, int ot = -1, std::vector<std::shared_ptr<Organ>> organs = std::vector<std::shared_ptr<Organ>>(0)) const; ///< parameter value per organ
+    std::vector<double> getParameters(const std::vector<std::string>& names, int ot = -1, std::vector<std::shared_ptr<Organ>> organs = std::vector<std::shared_ptr<Organ>>(0)) const; ///< parameter values per organ and name (column major)
     double getSummed(std::string name, int ot = -1) const; ///< summed up parameters
     // std::shared_ptr<Organ> pickOrgan(int nodeId); // TODO
 
@@ -95,14 +134,17 @@ public:
     std::vector<double> getNewNodeCTs() const; ///< nodes created in the previous time step
     std::vector<Vector2i> getNewSegments(int ot=-1) const; ///< Segments created in the previous time step
     std::vector<std::shared_ptr<Organ>> getNewSegmentOrigins(int ot=-1) const; ///< Copies a pointer to the root containing the new segments
+    const StepDelta& getStepDelta(); ///< all of the above (for all organ types), collected from the organs that changed
+    void addChangedOrgan(std::shared_ptr<Organ> o) { if (growthTask) { growthTask->changedOrgans.push_back(o); } else { changedOrgans.push_back(o); } } ///< only Organ::setChanged should call this
+    int getStep() const { return step; } ///< number of simulate calls, identifies the current time step (see Organ::setChanged)
 
     /* io */
     virtual std::string toString() const; ///< quick info for debugging
     virtual void initializeReader() { } ///< initializes parameter reader
     virtual void readParameters(std::string name, std::string  basetag = "plant", bool fromFile = true, bool verbose = false); ///< reads all organ type parameters from a xml file
     virtual void writeParameters(std::string name, std::string basetag = "plant", bool comments = true) const; ///< write all organ type parameters into a xml file
-    virtual void write(std::string name) const; /// writes simulation results (type is determined from file extension in name)
-    virtual void writeVTP(int otype, std::ostream & os) const;
+    virtual void write(std::string name, int format = 0, bool compressed = false) const; /// writes simulation results (type is determined from file extension in name)
+    virtual void writeVTP(int otype, std::ostream & os, int format = 0, bool compressed = false) const; ///< writes a VTP file, format is a VTPWriter::Format
     virtual void writeGeometry(std::ostream & os) const;
     virtual void writeRSML(std::string name) const; ///< writes a RSML file
     int getRSMLSkip() const { return rsmlSkip; } ///< skips points in the RSML output (default = 0)
@@ -110,8 +152,9 @@ public:
     std::vector<std::string>& getRSMLProperties() { return rsmlProperties; } ///< reference to the vector<string> of RSML property names, default is { "organType", "subType","length", "age"  }
 
     /* id management */
-    int getOrganIndex() { organId++; return organId; } ///< returns next unique organ id, only organ constructors should call this
-    int getNodeIndex() { nodeId++; return nodeId; } ///< returns next unique node id, only organ constructors should call this
+    int getOrganIndex() { if (growthTask) { return ++growthTask->organId; } organId++; return organId; } ///< returns next unique organ id, only organ constructors should call this
+    int getNodeIndex() { if (growthTask) { return ++growthTask->nodeId; } nodeId++; return nodeId; } ///< returns next unique node id, only organ constructors should call this
+    static thread_local GrowthTask* growthTask; ///< task of the base organ growing on this thread, nullptr if none (see Organism::setParallel)
 
     /* discretisation*/
     void setMinDx(double dx) { minDx = dx; } ///< Minimum segment size, smaller segments will be skipped
@@ -120,8 +163,8 @@ public:
     /* random number generator */
     virtual void setSeed(unsigned int seed); ///< sets the seed of the organisms random number generator
 
-    virtual double rand() {if(stochastic){return UD(gen); } else {return 0.5; } }  ///< uniformly distributed random number [0, 1[
-    virtual double randn() {if(stochastic){return ND(gen); } else {return 0.0; } }  ///< normally distributed random number [-3, 3] in 99.73% of cases
+    virtual double rand() {if(stochastic){return growthTask ? growthTask->UD(growthTask->gen) : UD(gen); } else {return 0.5; } }  ///< uniformly distributed random number [0, 1[
+    virtual double randn() {if(stochastic){return growthTask ? growthTask->ND(growthTask->gen) : ND(gen); } else {return 0.0; } }  ///< normally distributed random number [-3, 3] in 99.73% of cases
 	unsigned int  getSeedVal(){return seed_val;}
 	void setStochastic(bool stochastic_){stochastic = stochastic_;}
 	bool getStochastic(){return stochastic;}
@@ -133,6 +176,7 @@ protected:
 
     virtual tinyxml2:: XMLElement* getRSMLMetadata(tinyxml2::XMLDocument& doc) const;
     virtual tinyxml2:: XMLElement* getRSMLScene(tinyxml2::XMLDocument& doc) const;
+    virtual void resolveOrganRandomParameters(); ///< organs look up their organ type parameters again (see Organ::orp)
 
     static const int numberOfOrganTypes = 5;
     std::array<std::map<int, std::shared_ptr<OrganRandomParameter>>, numberOfOrganTypes> organParam;
@@ -145,6 +189,11 @@ protected:
     int nodeId = -1;
     int oldNumberOfNodes = 0;
     int oldNumberOfOrgans = 0;
+    StepDelta stepDelta; ///< growth of the last time step, see Organism::getStepDelta
+    bool stepDeltaValid = false; ///< stepDelta is collected lazily after each simulate call
+    int step = 0; ///< number of simulate calls
+    std::vector<std::shared_ptr<Organ>> changedOrgans; ///< organs that changed in the last time step, see Organism::getStepDelta
+    bool changedOrgansValid = false; ///< false before the first simulate call, and after copy, pop, or reset (all organs are visited then)
 
     std::vector<std::string> rsmlProperties = { "organType", "subType", "length", "age", "parent-node", "diameter" };
     int rsmlSkip = 0; // skips points
@@ -156,6 +205,10 @@ protected:
     std::normal_distribution<double> ND;
 	bool stochastic = true;///<  wether to implement stochasticity
 
+    int parallel = 0; ///< number of threads for the base organs, see Organism::setParallel
+    bool skipFinished = true; ///< see Organism::setSkipFinished
+    std::vector<GrowthTask> growthTasks; ///< one per base organ, see Organism::simulateOrgans
+
 };
 
 } // namespace
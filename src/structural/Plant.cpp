@@ -20,19 +20,23 @@ Plant::Plant(unsigned int seednum): Organism(seednum)
 { }
 
 /**
- * Deep copies the plant
+ * Deep copies the plant, @see Organism::copy
+ *
+ * @param share     share the organ specific parameters with this plant (default = false)
  */
-std::shared_ptr<Organism> Plant::copy()
+std::shared_ptr<Organism> Plant::copy(bool share)
 {
     auto no = std::make_shared<Plant>(*this); // copy constructor
+    no->stepDeltaValid = false;
     for (int i=0; i<baseOrgans.size(); i++) {
-        no->baseOrgans[i] = baseOrgans[i]->copy(no);
+        no->baseOrgans[i] = baseOrgans[i]->copy(no, share);
     }
     for (int ot = 0; ot < numberOfOrganTypes; ot++) { // copy organ type parameters
-        for (auto& otp : organParam[ot]) {
+        for (auto& otp : no->organParam[ot]) {
             otp.second = otp.second->copy(no);
         }
     }
+    no->resolveOrganRandomParameters(); // the copied organs still point to the parameters of this organism
     return no;
 }
 
@@ -66,6 +70,7 @@ void Plant::reset()
 {
     baseOrgans.clear();
     simtime = 0;
+    changedOrgansValid = false;
     organId = -1;
     nodeId = -1;
 }
@@ -265,7 +270,7 @@ void Plant::rel2abs()
 	for (int i = 0; i< s->getNumberOfChildren();i++) {
 		auto child = s->getChild(i);
 		//if(child->organType() >2){ //if aboveground-organ
-			child->rel2abs();//apply to all organs
+			child->rel2abs(s->getNumberOfNodes());//apply to all organs, the seed does not move
 		//}
 
     }
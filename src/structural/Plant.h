@@ -40,7 +40,7 @@ public:
   Plant(unsigned int seednum  = 0.);
   virtual ~Plant() { };
 
-  std::shared_ptr<Organism> copy() override; ///< deep copies the organism
+  std::shared_ptr<Organism> copy(bool share = false) override; ///< deep copies the organism
 
 
   /* parameters */
@@ -68,6 +68,7 @@ public:
   std::string toString() const override;
 
   std::vector<int> leafphytomerID = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+  std::vector<int> stemphytomerID = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }; ///< per plant (and not static), so that plants can grow concurrently
   void abs2rel();
   void rel2abs();
 
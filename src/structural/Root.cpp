@@ -49,7 +49,7 @@ Root::Root(std::shared_ptr<Organism> rs, int type,  double delay, std::shared_pt
     double beta = 2*M_PI*plant.lock()->rand(); // initial rotation
     double theta = param()->theta;
     if (parent->organType()!=Organism::ot_seed) { // scale if not a baseRoot
-        double scale = getRootRandomParameter()->f_sa->getValue(parent->getNode(pni), parent);
+        double scale = rrp()->f_sa->getValue(parent->getNode(pni), parent);
         theta*=scale;
     }
     insertionAngle = theta;
@@ -67,7 +67,7 @@ Root::Root(std::shared_ptr<Organism> rs, int type,  double delay, std::shared_pt
 			//if lateral of stem, initial creation time: 
 			//time when stem reached end of basal zone (==CT of parent node of first lateral) + delay
 			// @see stem::leafGrow
-			creationTime = parent->getChild(0)->getParameter("creationTime") + delay;
+			creationTime = parent->getChild(0)->getParameter(pk_creationTime) + delay;
 		}
 			addNode(Vector3d(0.,0.,0.), parent->getNodeId(pni), creationTime);
 		}
@@ -79,15 +79,18 @@ Root::Root(std::shared_ptr<Organism> rs, int type,  double delay, std::shared_pt
  * All laterals are deep copied, plant and parent pointers are updated.
  *
  * @param plant     the plant the copied organ will be part of
+ * @param share     share the organ specific parameters (see Organism::fork)
  */
-std::shared_ptr<Organ> Root::copy(std::shared_ptr<Organism> rs)
+std::shared_ptr<Organ> Root::copy(std::shared_ptr<Organism> rs, bool share)
 {
     auto r = std::make_shared<Root>(*this); // shallow copy
     r->parent = std::weak_ptr<Organ>();
     r->plant = rs;
-    r->param_ = std::make_shared<RootSpecificParameter>(*param()); // copy parameters
+    if (!share) { // a fork shares the parameters (they are constant)
+        r->param_ = std::make_shared<RootSpecificParameter>(*param()); // copy parameters
+    }
     for (size_t i=0; i< children.size(); i++) {
-        r->children[i] = children[i]->copy(rs); // copy laterals
+        r->children[i] = children[i]->copy(rs, share); // copy laterals
         r->children[i]->setParent(r);
     }
     return r;
@@ -102,6 +105,20 @@ std::shared_ptr<Organ> Root::copy(std::shared_ptr<Organism> rs)
 void Root::simulate(double dt, bool verbose)
 {
     // std::cout << "\nstart" << getId() <<  std::flush;
+    if (finished) { // nothing but the age changes in the subtree
+        if (plant.lock()->getSkipFinished()) {
+            if (pendingDt+dt<nextDeath) { // no root of the subtree dies, the ages are added later
+                if (alive) {
+                    pendingDt += dt;
+                }
+            } else {
+                nextDeath = simulateFinished(dt);
+            }
+            return;
+        } else if (pendingDt>0.) {
+            simulateFinished(0.);
+        }
+    }
     firstCall = true;
     moved = false;
     oldNumberOfNodes = nodes.size();
@@ -119,7 +136,7 @@ void Root::simulate(double dt, bool verbose)
 
         // probabilistic branching model
         if ((age>0) && (age-dt<=0)) { // the root emerges in this time step
-            double P = getRootRandomParameter()->f_sbp->getValue(nodes.back(),shared_from_this());
+            double P = rrp()->f_sbp->getValue(nodes.back(),shared_from_this());
             if (P<1.) { // P==1 means the lateral emerges with probability 1 (default case)
                 double p = 1.-std::pow((1.-P), dt); //probability of emergence in this time step
                 if (plant.lock()->rand()>p) { // not rand()<p
@@ -149,7 +166,7 @@ void Root::simulate(double dt, bool verbose)
                 double targetlength = calcLength(age_+dt_)+ this->epsilonDx;
 
                 double e = targetlength-length; // unimpeded elongation in time step dt
-                double scale = getRootRandomParameter()->f_se->getValue(nodes.back(), shared_from_this());
+                double scale = rrp()->f_se->getValue(nodes.back(), shared_from_this());
                 double dl = std::max(scale*e, 0.);//  length increment = calculated length + increment from last time step too small to be added
                 length = getLength();
                 this->epsilonDx = 0.; // now it is "spent" on targetlength (no need for -this->epsilonDx in the following)
@@ -220,11 +237,80 @@ void Root::simulate(double dt, bool verbose)
                 } // if lateralgetLengths
             } // if active
             active = getLength(false)<=(p.getK()*(1 - 1e-11)); // become inactive, if final length is nearly reached
+            finished = !active;
+            for (const auto& l : children) {
+                finished = finished && (l->organType()==Organism::ot_root) && (std::static_pointer_cast<Root>(l)->finished || !l->isAlive());
+            }
+            nextDeath = 0.; // the first call as finished root visits the subtree
         }
     } // if alive
     // std::cout << "end" << getId() << "\n" << std::flush;
 }
 
+/**
+ * Simulates a finished root (and its laterals), i.e. the root and its laterals are inactive or dead,
+ * and only their age increases (until the root life time is reached).
+ *
+ * Has the same effect as Root::simulate, but without visiting all organs through Organ::simulate.
+ * Root::simulate only calls it, if a root of the subtree dies in the time step (or for the first time step
+ * after the root finished). Otherwise the time step is added to Root::pendingDt, and the ages are derived from it
+ * (@see Root::getAge). Therefore, in long simulations (where most roots are finished) the costs of a time step
+ * scale with the growing roots, not with all roots.
+ *
+ * @param dt        time step [day], Root::pendingDt is added
+ * @return time until the next death of a root in the subtree [day], infinite for none
+ */
+double Root::simulateFinished(double dt)
+{
+    dt += pendingDt;
+    pendingDt = 0.;
+    firstCall = true;
+    moved = false;
+    oldNumberOfNodes = nodes.size();
+    double next = std::numeric_limits<double>::infinity();
+    if (alive) {
+        double rlt = param()->rlt;
+        if (age+dt>rlt) { // root life time
+            dt = rlt-age; // remaining life span
+            alive = false; // this root is dead
+        }
+        age += dt;
+        if (alive) {
+            next = rlt-age;
+            for (const auto& l : children) {
+                next = std::min(next, static_cast<Root*>(l.get())->simulateFinished(dt));
+            }
+        } else {
+            for (const auto& l : children) {
+                static_cast<Root*>(l.get())->simulateFinished(dt);
+            }
+        }
+    }
+    return next;
+}
+
+/**
+ * The age of a finished root is derived from the time that it, and its finished ancestors, have not yet passed on
+ * (@see Root::simulateFinished). Dead roots do not pass on time.
+ */
+double Root::getAge() const
+{
+    if (!finished || !alive) {
+        return age;
+    }
+    double a = age + pendingDt;
+    auto p = getParent();
+    while (p && (p->organType()==Organism::ot_root)) {
+        auto r = static_cast<const Root*>(p.get());
+        if (!r->finished || !r->alive) {
+            break;
+        }
+        a += r->pendingDt;
+        p = r->getParent();
+    }
+    return a;
+}
+
 /**
  * Analytical length of the single root at a given age
  *
@@ -234,7 +320,7 @@ void Root::simulate(double dt, bool verbose)
 double Root::calcLength(double age)
 {
     assert(age >= 0 && "Root::calcLength() negative root age");
-    return getRootRandomParameter()->f_gf->getLength(age,param()->r,param()->getK(), shared_from_this());
+    return rrp()->f_gf->getLength(age,param()->r,param()->getK(), shared_from_this());
 }
 
 /**
@@ -246,7 +332,7 @@ double Root::calcLength(double age)
 double Root::calcAge(double length) const
 {
     assert(length >= 0 && "Root::calcAge() negative root length");
-    return getRootRandomParameter()->f_gf->getAge(length,param()->r,param()->getK(), shared_from_this());
+    return rrp()->f_gf->getAge(length,param()->r,param()->getK(), shared_from_this());
 }
 
 /**
@@ -275,22 +361,23 @@ std::shared_ptr<const RootSpecificParameter> Root::param() const
  * lnMean, and lnDev denotes the mean and standard deviation of the inter-lateral distance of this organ
  * ln_mean, and ln_dev is the mean and standard deviation from the RootRandomParmaeters
  */
-double Root::getParameter(std::string name) const
+double Root::getParameter(int key) const
 {
+    switch (key) {
     // specific parameters
-    if (name=="type") { return this->param_->subType; }  // delete to avoid confusion?
-	if (name=="subType") { return this->param_->subType; }  // organ sub-type [-]
-    if (name=="lb") { return param()->lb; } // basal zone [cm]
-    if (name=="la") { return param()->la; } // apical zone [cm]
-    if (name=="r"){ return param()->r; }  // initial growth rate [cm day-1]
-    if (name=="theta") { return insertionAngle; } // angle between root and parent root [rad]
-    if (name=="rlt") { return param()->rlt; } // root life time [day]
+    case pk_type: return this->param_->subType;  // delete to avoid confusion?
+    case pk_subType: return this->param_->subType;  // organ sub-type [-]
+    case pk_lb: return param()->lb; // basal zone [cm]
+    case pk_la: return param()->la; // apical zone [cm]
+    case pk_r: return param()->r;  // initial growth rate [cm day-1]
+    case pk_theta: return insertionAngle; // angle between root and parent root [rad]
+    case pk_rlt: return param()->rlt; // root life time [day]
     // specific parameters member functions
-    if (name=="nob") { return param()->nob(); } // number of lateral emergence nodes/branching points
-    if (name=="k") { return param()->getK(); }; // maximal root length [cm]
-    if (name=="lmax") { return param()->getK(); }; // maximal root length [cm]
+    case pk_nob: return param()->nob(); // number of lateral emergence nodes/branching points
+    case pk_k: return param()->getK(); // maximal root length [cm]
+    case pk_lmax: return param()->getK(); // maximal root length [cm]
     // further
-    if (name=="lnMean") { // mean lateral distance [cm]	
+    case pk_lnMean: { // mean lateral distance [cm]
         auto& v =param()->ln;
 		if(v.size()>0){
 			return std::accumulate(v.begin(), v.end(), 0.0) / v.size();
@@ -298,16 +385,17 @@ double Root::getParameter(std::string name) const
 			return 0;
 		}
     }
-    if (name=="lnDev") { // standard deviation of lateral distance [cm]
+    case pk_lnDev: { // standard deviation of lateral distance [cm]
         auto& v =param()->ln;
         double mean = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
         double sq_sum = std::inner_product(v.begin(), v.end(), v.begin(), 0.0);
         return std::sqrt(sq_sum / v.size() - mean * mean);
     }
-    if (name=="rootLength") { return getLength(true); } // root length [cm], same as length, but a SegmentAnalyser::getParameter call would give the segment length
-    if (name=="volume") { return param()->a*param()->a*M_PI*getLength(true); } // root volume [cm^3]
-    if (name=="surface") { return 2*param()->a*M_PI*getLength(true); } // root surface [cm^2]
-    return Organ::getParameter(name); // pass to base class
+    case pk_rootLength: return getLength(true); // root length [cm], same as length, but a SegmentAnalyser::getParameter call would give the segment length
+    case pk_volume: return param()->a*param()->a*M_PI*getLength(true); // root volume [cm^3]
+    case pk_surface: return 2*param()->a*M_PI*getLength(true); // root surface [cm^2]
+    default: return Organ::getParameter(key);
+    }
 }
 
 
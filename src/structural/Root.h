@@ -30,13 +30,15 @@ public:
     Root(std::shared_ptr<Organism> rs, int type, double delay, std::shared_ptr<Organ> parent, int pni); ///< used within simulation
     virtual ~Root() { }; ///< no need to do anything, children are deleted in ~Organ()
 
-    std::shared_ptr<Organ> copy(std::shared_ptr<Organism> rs) override;  ///< deep copies the root tree
+    std::shared_ptr<Organ> copy(std::shared_ptr<Organism> rs, bool share = false) override;  ///< deep copies the root tree
 
     int organType() const override { return Organism::ot_root; }; ///< returns the organs type
 
     void simulate(double dt, bool silence = false) override; ///< root growth for a time span of @param dt
 
-    double getParameter(std::string name) const override; ///< returns an organ pa:vector<CPlantBox::Vector3d>::size_type)’
+    double getAge() const override; ///< age of the root, including the time a finished subtree has not yet passed on (@see Root::simulate)
+    using Organ::getParameter;
+    double getParameter(int key) const override; ///< returns an organ parameter, by its key (@see Organ::parameterKey)
     std::string toString() const override;
 
     /* From analytical equations */
@@ -51,6 +53,12 @@ public:
 
 protected:
 
+    RootRandomParameter* rrp() const { return static_cast<RootRandomParameter*>(orp()); } ///< cached root type parameter, see Organ::orp
+
+    double simulateFinished(double dt); ///< ages a finished root and its laterals, returns the time until the next death, see Root::simulate
+    bool finished = false; ///< the root and all its laterals stopped growing (or are dead), only their age changes
+    double pendingDt = 0.; ///< time passed to the finished root, but not yet added to the ages of its subtree [day]
+    double nextDeath = 0.; ///< time until the next death in the finished subtree, after adding pendingDt [day]
 
 };
 
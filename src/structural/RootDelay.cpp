@@ -8,15 +8,18 @@ namespace CPlantBox {
  * All laterals are deep copied, plant and parent pointers are updated.
  *
  * @param plant     the plant the copied organ will be part of
+ * @param share     share the organ specific parameters (see Organism::fork)
  */
-std::shared_ptr<Organ> RootDelay::copy(std::shared_ptr<Organism> rs)
+std::shared_ptr<Organ> RootDelay::copy(std::shared_ptr<Organism> rs, bool share)
 {
     auto r = std::make_shared<RootDelay>(*this); // shallow copy
     r->parent = std::weak_ptr<Organ>();
     r->plant = rs;
-    r->param_ = std::make_shared<RootSpecificParameter>(*param()); // copy parameters
+    if (!share) { // a fork shares the parameters (they are constant)
+        r->param_ = std::make_shared<RootSpecificParameter>(*param()); // copy parameters
+    }
     for (size_t i=0; i< children.size(); i++) {
-        r->children[i] = children[i]->copy(rs); // copy laterals
+        r->children[i] = children[i]->copy(rs, share); // copy laterals
         r->children[i]->setParent(r);
     }
     return r;
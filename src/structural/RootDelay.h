@@ -19,7 +19,7 @@ class RootDelay :public Root
 public:
 
     using Root::Root;
-    std::shared_ptr<Organ> copy(std::shared_ptr<Organism> rs) override;  ///< deep copies the root tree
+    std::shared_ptr<Organ> copy(std::shared_ptr<Organism> rs, bool share = false) override;  ///< deep copies the root tree
     std::string toString() const override;
 
 	protected:
@@ -4,6 +4,9 @@
 #include "organparameter.h"
 #include "Organism.h"
 #include "RootDelay.h"
+#include "parallel.h"
+
+#include <algorithm>
 
 namespace CPlantBox {
 
@@ -14,23 +17,42 @@ RootSystem::RootSystem(): Organism()
 { }
 
 /**
- * Deep copies the organism
+ * Deep copies the organism, @see Organism::copy
+ *
+ * @param share     share the organ specific parameters with this root system (default = false)
  */
-std::shared_ptr<Organism> RootSystem::copy()
+std::shared_ptr<Organism> RootSystem::copy(bool share)
 {
-    roots.clear(); // clear buffer
     auto nrs = std::make_shared<RootSystem>(*this); // copy constructor
-    nrs->seed = std::static_pointer_cast<Seed>(seed->copy(nrs));
-    baseOrgans = nrs->seed->copyBaseOrgans();
+    nrs->roots.clear(); // clear buffer (it points to the roots of this root system)
+    nrs->stepDeltaValid = false;
+    if (seed) { // seed is null before initialization, e.g. for a prototype (@see Ensemble)
+        nrs->seed = std::static_pointer_cast<Seed>(seed->copy(nrs, share));
+        for (int i = 0; i < baseOrgans.size(); i++) { // the grown base roots, not the seed's initial ones
+            nrs->baseOrgans[i] = baseOrgans[i]->copy(nrs, share);
+        }
+    }
     for (int ot = 0; ot < numberOfOrganTypes; ot++) { // copy organ type parameters
         for (auto& otp : nrs->organParam[ot]) {
             otp.second = otp.second->copy(nrs);
-			nrs->setOrganRandomParameter(otp.second);
         }
     }
+    nrs->resolveOrganRandomParameters(); // the copied organs still point to the parameters of this root system
     return nrs;
 }
 
+/**
+ * Organs look up their organ random parameters again (@see Organism::resolveOrganRandomParameters),
+ * including the seed, which is not a base organ of the root system
+ */
+void RootSystem::resolveOrganRandomParameters()
+{
+    Organism::resolveOrganRandomParameters();
+    if (seed) {
+        seed->resolveOrganRandomParameter();
+    }
+}
+
 /**
  * @return the i-th root parameter of sub type @param type.
  */
@@ -75,6 +97,7 @@ void RootSystem::reset()
 {
     roots.clear(); // clear buffer
     baseOrgans.clear();
+    changedOrgansValid = false;
     simtime = 0;
     organId = -1;
     nodeId = -1;
@@ -294,6 +317,9 @@ void RootSystem::simulate()
  * Simulates root system growth for a time span, elongates a maximum of @param maxinc total length [cm/day]
  * using the proportional elongation @param se to impede overall growth.
  *
+ * The scale of @param se is found by regula falsi, @see RootSystem::searchScale. If the root system grows in parallel
+ * (@see Organism::setParallel) the search evaluates several scales at once.
+ *
  * @param dt        time step [day]
  * @param maxinc_   maximal total length [cm/day] the root system is allowed to grow in this time step
  * @param se        The class ProportionalElongation is used to scale overall root growth
@@ -305,7 +331,6 @@ void RootSystem::simulate(double dt, double maxinc_, ProportionalElongation* se,
     const int maxiter = 20;
     double maxinc = dt*maxinc_; // [cm]
     double ol = getSummed("length");
-    int i = 0;
 
     push();
     se->setScale(1.);
@@ -318,33 +343,110 @@ void RootSystem::simulate(double dt, double maxinc_, ProportionalElongation* se,
     }
     pop();
 
-    if ((inc_>maxinc) && (std::abs(inc_-maxinc)>accuracy)) { // check if we have to perform a binary search
-
-        double sl = 0.; // left
-        double sr = 1.; // right
-
-        while ( ((std::abs(inc_-maxinc)) > accuracy) && (i<maxiter) )  { // binary search
+    if ((inc_>maxinc) && (std::abs(inc_-maxinc)>accuracy)) { // search the scale
+        se->setScale(searchScale(dt, ol, maxinc, inc_, se, accuracy, maxiter, verbose));
+    }
+    this->simulate(dt, verbose);
+}
 
-            double m = (sl+sr)/2.; // mid
-            push();
-            se->setScale(m);
-            simulate(dt, verbose);
-            l = getSummed("length");
-            inc_ = l - ol;
-            pop();
-            if (verbose) {
-                std::cout << "\t(sl, mid, sr) = (" << sl << ", " <<  m << ", " <<  sr << "), inc " <<  inc_ << ", err: " << std::abs(inc_-maxinc) << " > " << accuracy << "\n";
+/**
+ * Searches the scale of the proportional elongation @param se, such that the root system grows @param maxinc [cm] in
+ * the time step @param dt, for RootSystem::simulate(dt, maxinc, se, verbose).
+ *
+ * The increase is monotone in the scale. The search keeps a bracket [sl, sr] of the scale, and evaluates Organism::parallel
+ * scales per round: the regula falsi estimate (with the Illinois modification), and equidistant points of the bracket.
+ * The scales are evaluated on forks of the root system (@see Organism::fork), one per thread. Each fork starts from the
+ * state of this root system (including its random numbers), so the increase is the same as for a push(), simulate(),
+ * pop() cycle. With one thread, or if @param se is not the scale elongation of any root type (but e.g. the base look up
+ * of it), the scales are evaluated one after another using push() and pop().
+ *
+ * @param dt        time step [day]
+ * @param ol        length of the root system before the time step [cm]
+ * @param maxinc    maximal increase of the length in the time step [cm]
+ * @param inc1      increase of the length with scale 1 (> maxinc) [cm]
+ * @param se        the scale elongation
+ * @param accuracy  tolerated difference of the increase to maxinc [cm]
+ * @param maxiter   maximal number of rounds
+ * @param verbose   indicates if status is written to the console (cout)
+ * @return the scale, with the increase closest to maxinc
+ */
+double RootSystem::searchScale(double dt, double ol, double maxinc, double inc1, ProportionalElongation* se, double accuracy,
+    int maxiter, bool verbose)
+{
+    std::vector<int> seTypes; // root types that use se
+    for (const auto& p : organParam[Organism::ot_root]) {
+        if (p.second && (std::static_pointer_cast<RootRandomParameter>(p.second)->f_se.get()==se)) {
+            seTypes.push_back(p.first);
+        }
+    }
+    size_t nt = seTypes.empty() ? 1 : std::max(parallel, 1);
+
+    auto evaluate = [&](const std::vector<double>& scales) { // increase per scale
+        std::vector<double> inc(scales.size());
+        if (nt==1) {
+            for (size_t j = 0; j<scales.size(); j++) {
+                push();
+                se->setScale(scales[j]);
+                simulate(dt, false);
+                inc[j] = getSummed("length") - ol;
+                pop();
             }
-            if (inc_>maxinc) { // concatenate
-                sr = m;
-            } else {
-                sl = m;
+            return inc;
+        }
+        parallelFor(scales.size(), int(nt), [&](size_t j) {
+            auto rs = std::static_pointer_cast<RootSystem>(fork());
+            rs->parallel = 0; // one thread per fork (the results do not depend on it)
+            for (int st : seTypes) {
+                auto p = std::static_pointer_cast<RootRandomParameter>(rs->getOrganRandomParameter(Organism::ot_root, st));
+                std::static_pointer_cast<ProportionalElongation>(p->f_se)->setScale(scales[j]); // the fork's copy of se
             }
-            i++;
+            rs->simulate(dt, false);
+            inc[j] = rs->getSummed("length") - ol;
+        });
+        return inc;
+    };
 
+    double sl = 0.; // left, no elongation at scale 0
+    double fl = -maxinc;
+    double sr = 1.; // right
+    double fr = inc1 - maxinc;
+    double best = 1.;
+    double bestErr = std::abs(fr);
+    for (int i = 0; (i<maxiter) && (bestErr>accuracy); i++) {
+        std::vector<double> scales = { (sl*fr - sr*fl)/(fr - fl) }; // regula falsi
+        for (size_t j = 1; j<nt; j++) {
+            scales.push_back(sl + j*(sr - sl)/nt);
+        }
+        std::sort(scales.begin(), scales.end());
+        auto inc = evaluate(scales);
+        size_t k = 0; // first scale with a too large increase
+        while ((k<scales.size()) && (inc[k]<=maxinc)) {
+            k++;
+        }
+        if (k<scales.size()) {
+            sr = scales[k];
+            fr = inc[k] - maxinc;
+        } else {
+            fr /= 2.; // Illinois, the right end is kept
+        }
+        if (k>0) {
+            sl = scales[k-1];
+            fl = inc[k-1] - maxinc;
+        } else {
+            fl /= 2.; // Illinois, the left end is kept
+        }
+        for (size_t j = 0; j<scales.size(); j++) {
+            if (std::abs(inc[j] - maxinc)<bestErr) {
+                best = scales[j];
+                bestErr = std::abs(inc[j] - maxinc);
+            }
+        }
+        if (verbose) {
+            std::cout << "\t(sl, sr) = (" << sl << ", " << sr << "), " << scales.size() << " scales, best " << best
+                << ", err: " << bestErr << " > " << accuracy << "\n";
         }
     }
-    this->simulate(dt, verbose);
+    return best;
 }
 
 /**
@@ -487,6 +589,7 @@ void RootSystem::pop()
     RootSystemState& rss = stateStack.back();
     rss.restore(*this);
     stateStack.pop_back();
+    changedOrgansValid = false; // the organs are restored
 }
 
 /**
@@ -506,7 +609,7 @@ std::string RootSystem::toString() const
  * @param rs        the root system to be stored
  */
 RootSystemState::RootSystemState(const RootSystem& rs) : simtime(rs.simtime), dt(rs.dt), organId(rs.organId), nodeId(rs.nodeId),
-    oldNumberOfOrgans(rs.oldNumberOfOrgans), numberOfCrowns(rs.numberOfCrowns), gen(rs.gen), UD(rs.UD), ND(rs.ND)
+    oldNumberOfOrgans(rs.oldNumberOfOrgans), numberOfCrowns(rs.numberOfCrowns), gen(rs.gen), UD(rs.UD), ND(rs.ND), growthTasks(rs.growthTasks)
 {
     baseRoots = std::vector<RootState>(rs.baseOrgans.size()); // store base roots
     for (size_t i=0; i<baseRoots.size(); i++) {
@@ -529,10 +632,12 @@ void RootSystemState::restore(RootSystem& rs)
     rs.oldNumberOfNodes = oldNumberOfNodes;
     rs.oldNumberOfOrgans = oldNumberOfOrgans;
     rs.numberOfCrowns = numberOfCrowns;
+    rs.stepDeltaValid = false; // the organ tree changes
 
     rs.gen = gen;
     rs.UD = UD;
     rs.ND = ND;
+    rs.growthTasks = growthTasks;
     for (size_t i=0; i<baseRoots.size(); i++) { // restore base roots
         baseRoots[i].restore(*(std::static_pointer_cast<Root>(rs.baseOrgans[i])));
     }
@@ -544,7 +649,8 @@ void RootSystemState::restore(RootSystem& rs)
  * @param r        the root to be stored
  */
 RootState::RootState(const Root& r): alive(r.alive), active(r.active), age(r.age), length(r.getLength(true)),
-    epsilonDx(r.epsilonDx), moved(r.moved), oldNumberOfNodes(r.oldNumberOfNodes), firstCall(r.firstCall)
+    epsilonDx(r.epsilonDx), moved(r.moved), oldNumberOfNodes(r.oldNumberOfNodes), firstCall(r.firstCall), finished(r.finished),
+    pendingDt(r.pendingDt), nextDeath(r.nextDeath)
 {
     lNode = r.nodes.back();
     lNodeId = r.nodeIds.back();
@@ -571,11 +677,15 @@ void RootState::restore(Root& r)
     r.moved = moved;
     r.oldNumberOfNodes = oldNumberOfNodes;
     r.firstCall = firstCall; //
+    r.finished = finished;
+    r.pendingDt = pendingDt;
+    r.nextDeath = nextDeath;
 
     r.nodes.resize(non); // shrink vectors
     r.nodeIds.resize(non);
     r.nodeCTs.resize(non);
     r.nodes.back() = lNode; // restore last value
+    r.updateLengths(non-1);
     r.nodeIds.back() = lNodeId;
     r.nodeCTs.back() = lneTime;
     r.children.resize(laterals.size()); // shrink and restore laterals
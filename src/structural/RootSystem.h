@@ -37,7 +37,7 @@ public:
     RootSystem(); ///< empty root system
     virtual ~RootSystem() { };
 
-    std::shared_ptr<Organism> copy() override; ///< deep copies the organism
+    std::shared_ptr<Organism> copy(bool share = false) override; ///< deep copies the organism
 
     /* Parameter input output */
     std::shared_ptr<RootRandomParameter> getRootRandomParameter(int type) const;///< returns the i-th root parameter set (i=1..n)
@@ -94,11 +94,15 @@ public:
 
 protected:
 
+    void resolveOrganRandomParameters() override; ///< also for the seed
+
     int numberOfCrowns = 0;
 
 private:
 
     void initialize_(int basal = 4, int shootborne = 5, bool verbose = true);
+    double searchScale(double dt, double ol, double maxinc, double inc1, ProportionalElongation* se, double accuracy,
+        int maxiter, bool verbose); ///< scale of the proportional elongation, such that the increase is maxinc
 
     std::shared_ptr<Seed> seed = nullptr;
     SeedSpecificParameter seedParam;
@@ -144,6 +148,7 @@ private:
     mutable std::mt19937 gen; ///< random generator state
     mutable std::uniform_real_distribution<double> UD;  ///< random generator state
     mutable std::normal_distribution<double> ND; ///< random generator state
+    std::vector<GrowthTask> growthTasks; ///< random streams of the base roots
 
 };
 
@@ -174,6 +179,9 @@ private:
     bool moved = false;
     int oldNumberOfNodes = 0;
     bool firstCall = true;
+    bool finished = false;
+    double pendingDt = 0.;
+    double nextDeath = 0.;
 
     /* down the root branch*/
     std::vector<RootState> laterals = std::vector<RootState>(0); ///< the lateral roots of this root
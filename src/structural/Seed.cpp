@@ -29,15 +29,18 @@ Seed::Seed(std::shared_ptr<Organism> plant)
  * All laterals are deep copied, plant and parent pointers are updated.
  *
  * @param plant     the plant the copied organ will be part of
+ * @param share     share the organ specific parameters (see Organism::fork)
  */
-std::shared_ptr<Organ> Seed::copy(std::shared_ptr<Organism> rs)
+std::shared_ptr<Organ> Seed::copy(std::shared_ptr<Organism> rs, bool share)
 {
 	auto s = std::make_shared<Seed>(*this); // shallow copy
 	s->parent = std::weak_ptr<Organ>();
 	s->plant = rs;
-	s->param_ = std::make_shared<SeedSpecificParameter>(*param()); // copy parameters
+	if (!share) { // a fork shares the parameters (they are constant)
+		s->param_ = std::make_shared<SeedSpecificParameter>(*param()); // copy parameters
+	}
 	for (size_t i=0; i< children.size(); i++) {
-		s->children[i] = children[i]->copy(rs); // copy laterals
+		s->children[i] = children[i]->copy(rs, share); // copy laterals
 		s->children[i]->setParent(s);
 	}
 	return s;
@@ -23,7 +23,7 @@ public:
     Seed(std::shared_ptr<Organism> plant); ///< used within simulation
     virtual ~Seed() { };
 
-    std::shared_ptr<Organ> copy(std::shared_ptr<Organism> rs) override;  ///< deep copies the seed
+    std::shared_ptr<Organ> copy(std::shared_ptr<Organism> rs, bool share = false) override;  ///< deep copies the seed
 
     virtual int organType() const override { return Organism::ot_seed; }
 
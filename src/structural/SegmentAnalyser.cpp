@@ -6,6 +6,8 @@
 #include "MappedOrganism.h"
 #include "XylemFlux.h"
 #include "PlantHydraulicParameters.h"
+#include "VTPWriter.h"
+#include "parallel.h"
 #include <algorithm>
 #include <iomanip>
 #include <istream>
@@ -15,6 +17,7 @@
 #include <fstream>
 #include <set>
 #include <math.h>
+#include <stdexcept>
 
 namespace CPlantBox {
 
@@ -60,11 +63,18 @@ SegmentAnalyser::SegmentAnalyser(const Organism& plant)
     auto organType = std::vector<double>(segments.size());
     for (size_t i=0; i<segments.size(); i++) {
         segO[i] = sego[i]; // convert shared_ptr to weak_ptr
-        radii[i] = segO[i].lock()->getParameter("radius");
-        subType[i] = segO[i].lock()->getParameter("subType");
-        id[i] = segO[i].lock()->getParameter("id");
-        organType[i] = segO[i].lock()->getParameter("organType"); // = 2
-
+        if ((i>0) && (sego[i]==sego[i-1])) { // segments of an organ are consecutive
+            radii[i] = radii[i-1];
+            subType[i] = subType[i-1];
+            id[i] = id[i-1];
+            organType[i] = organType[i-1];
+        } else {
+            const auto& o = sego[i];
+            radii[i] = o->getParameter(Organ::pk_radius);
+            subType[i] = o->getParameter(Organ::pk_subType);
+            id[i] = o->getParameter(Organ::pk_id);
+            organType[i] = o->getParameter(Organ::pk_organType); // = 2
+        }
     }
     data["radius"] = radii;
     data["subType"] = subType;
@@ -318,9 +328,10 @@ std::vector<double> SegmentAnalyser::getParameter(std::string name, double def)
         }
         return d;
     }
+    int key = Organ::parameterKey(name); // resolve the name once
     for (size_t i=0; i<segO.size(); i++) { // else pass to Organs
         if (!segO.at(i).expired()) {
-            d.at(i) = segO.at(i).lock()->getParameter(name);
+            d.at(i) = segO.at(i).lock()->getParameter(key);
         } else { // in case the segment has no origin
             if (std::isnan(def)) {
                 throw std::invalid_argument("SegmentAnalyser::getParameter: segment origin expired (segment has no owner), "
@@ -356,45 +367,44 @@ double SegmentAnalyser::getSegmentLength(int i) const
 void SegmentAnalyser::crop(std::shared_ptr<SignedDistanceFunction> geometry)
 {
     //std::cout << "cropping " << segments.size() << " segments...";
-    std::vector<Vector2i> seg;
-    std::vector<std::weak_ptr<Organ>> sO;
-    std::map<std::string, std::vector<double>> ndata;
-    for (size_t i=0; i<segments.size(); i++) {
-        auto s = segments.at(i);
-        bool x_ = geometry->getDist(nodes.at(s.x))<=0; // in?
-        bool y_ = geometry->getDist(nodes.at(s.y))<=0; // in?
-        if (x_ && y_) { //segment is inside
-            seg.push_back(s);
-            if (segO.size()>0) {
-                sO.push_back(segO.at(i));
-            }
-            for(auto iter = data.begin(); iter != data.end(); ++iter) {
-                std::string key =  iter->first;
-                ndata[key].push_back(data[key].at(i));
-            }
-        } else if ((x_==false) && (y_==false)) { // segment is outside
-        } else { // one node is inside, one outside
-            if (x_==false) { // swap indices
-                int ind = s.x;
-                s.x = s.y;
-                s.y = ind;
-            }
-            Vector3d newnode = cut(nodes[s.x], nodes[s.y], geometry);
-            nodes.push_back(newnode); // add new segment
-            Vector2i newseg(s.x,nodes.size()-1);
-            seg.push_back(newseg);
-            if (segO.size()>0) {
-                sO.push_back(segO.at(i));
-            }
-            for(auto iter = data.begin(); iter != data.end(); ++iter) { // copy data
-                std::string key =  iter->first;
-                ndata[key].push_back(data[key].at(i));
+    size_t n = segments.size();
+    std::vector<char> state(n); // 0: outside, 1: inside, 2: only s.x is inside, 3: only s.y is inside
+    parallelFor(n, [&](size_t begin, size_t end) {
+        for (size_t i=begin; i<end; i++) {
+            const auto& s = segments.at(i);
+            bool x_ = geometry->getDist(nodes.at(s.x))<=0; // in?
+            bool y_ = geometry->getDist(nodes.at(s.y))<=0; // in?
+            state[i] = (x_ && y_) ? 1 : (x_ ? 2 : (y_ ? 3 : 0));
+        }
+    });
+    std::vector<size_t> rows;
+    std::vector<size_t> cutRows; // one node is inside, one outside
+    rows.reserve(n);
+    for (size_t i=0; i<n; i++) {
+        if (state[i]>0) {
+            rows.push_back(i);
+        }
+        if (state[i]>1) {
+            cutRows.push_back(i);
+        }
+    }
+    std::vector<Vector3d> newnodes(cutRows.size());
+    parallelFor(cutRows.size(), [&](size_t begin, size_t end) {
+        for (size_t j=begin; j<end; j++) {
+            auto s = segments[cutRows[j]];
+            if (state[cutRows[j]]==3) { // swap indices
+                std::swap(s.x, s.y);
             }
+            newnodes[j] = cut(nodes[s.x], nodes[s.y], geometry);
         }
+    });
+    for (size_t j=0; j<cutRows.size(); j++) { // new nodes are added in segment order
+        auto& s = segments[cutRows[j]];
+        int in = (state[cutRows[j]]==2) ? s.x : s.y;
+        nodes.push_back(newnodes[j]); // add new segment
+        s = Vector2i(in, nodes.size()-1);
     }
-    segments = seg;
-    segO  = sO;
-    data = ndata;
+    gather(rows);
     //std::cout << " cropped to " << segments.size() << " segments " << "\n";
 }
 
@@ -417,24 +427,14 @@ void SegmentAnalyser::cropDomain(double xx, double yy, double zz)
 void SegmentAnalyser::filter(std::string name, double min, double max)
 {
     std::vector<double> d_ = getParameter(name);
-    std::vector<Vector2i> seg;
-    std::vector<std::weak_ptr<Organ>> sO;
-    std::map<std::string, std::vector<double>> ndata;
+    std::vector<size_t> rows;
+    rows.reserve(segments.size());
     for (size_t i=0; i<segments.size(); i++) {
         if ((d_.at(i)>=min) && (d_.at(i)<=max)) {
-            seg.push_back(segments.at(i));
-            if (segO.size()>0) {
-                sO.push_back(segO.at(i));
-            }
-            for(auto iter = data.begin(); iter != data.end(); ++iter) {
-                std::string key =  iter->first;
-                ndata[key].push_back(data[key].at(i));
-            }
+            rows.push_back(i);
         }
     }
-    segments = seg;
-    segO  = sO;
-    data = ndata;
+    gather(rows);
 }
 
 /**
@@ -447,24 +447,87 @@ void SegmentAnalyser::filter(std::string name, double min, double max)
 void SegmentAnalyser::filter(std::string name, double value)
 {
     std::vector<double> d_ = getParameter(name);
-    std::vector<Vector2i> seg;
-    std::vector<std::weak_ptr<Organ>> sO;
-    std::map<std::string, std::vector<double>> ndata;
+    std::vector<size_t> rows;
+    rows.reserve(segments.size());
     for (size_t i=0; i<segments.size(); i++) {
         if (d_.at(i)==value) {
-            seg.push_back(segments.at(i));
-            if (segO.size()>0) {
-                sO.push_back(segO.at(i));
-            }
-            for(auto iter = data.begin(); iter != data.end(); ++iter) {
-                std::string key =  iter->first;
-                ndata[key].push_back(data[key].at(i));
+            rows.push_back(i);
+        }
+    }
+    gather(rows);
+}
+
+/**
+ * Keeps the segments where @param mask is true, i.e. all other segments are deleted.
+ * Masks of several criteria (e.g. from SegmentAnalyser::getParameter) can be combined first,
+ * and applied in a single pass.
+ *
+ * @param mask      one entry per segment
+ */
+void SegmentAnalyser::select(const std::vector<bool>& mask)
+{
+    if (mask.size()!=segments.size()) {
+        throw std::invalid_argument("SegmentAnalyser::select: mask size "+std::to_string(mask.size())+
+            " does not equal the number of segments "+std::to_string(segments.size()));
+    }
+    std::vector<size_t> rows;
+    rows.reserve(segments.size());
+    for (size_t i=0; i<mask.size(); i++) {
+        if (mask[i]) {
+            rows.push_back(i);
+        }
+    }
+    gather(rows);
+}
+
+/**
+ * Keeps the segments with indices @param rows (in this order, indices may repeat), together with their
+ * segment origins (if used) and data. The data columns are compacted independently, on SegmentAnalyser::parallel threads.
+ */
+void SegmentAnalyser::gather(const std::vector<size_t>& rows)
+{
+    size_t maxRow = rows.empty() ? 0 : *std::max_element(rows.begin(), rows.end());
+    for (const auto& d : data) {
+        if ((!rows.empty()) && (d.second.size()<=maxRow)) {
+            throw std::invalid_argument("SegmentAnalyser::gather: data '"+d.first+"' has less values than segments");
+        }
+    }
+    std::vector<std::vector<double>*> columns;
+    for (auto& d : data) {
+        columns.push_back(&d.second);
+    }
+    auto gatherRows = [&rows](auto& v) {
+        typename std::remove_reference<decltype(v)>::type nv(rows.size());
+        for (size_t i=0; i<rows.size(); i++) {
+            nv[i] = v[rows[i]];
+        }
+        v.swap(nv);
+    };
+    parallelFor(columns.size()+2, [&](size_t begin, size_t end) {
+        for (size_t j=begin; j<end; j++) {
+            if (j<columns.size()) {
+                gatherRows(*columns[j]);
+            } else if (j==columns.size()) {
+                gatherRows(segments);
+            } else if (segO.size()>0) { // if used
+                gatherRows(segO);
             }
         }
+    });
+}
+
+/**
+ * Calls @param f(begin, end) for consecutive chunks of [0, @param n), each chunk on its own thread
+ * (SegmentAnalyser::parallel threads, serial if 0 or 1, @see CPlantBox::parallelFor). The first exception is rethrown.
+ */
+void SegmentAnalyser::parallelFor(size_t n, const std::function<void(size_t, size_t)>& f) const
+{
+    size_t nt = std::min(size_t(std::max(parallel, 1)), n);
+    if (nt<=1) {
+        f(0, n);
+        return;
     }
-    segments = seg;
-    segO  = sO;
-    data = ndata;
+    CPlantBox::parallelFor(nt, int(nt), [&](size_t t) { f((t*n)/nt, ((t+1)*n)/nt); });
 }
 
 /**
@@ -563,6 +626,85 @@ Vector3d SegmentAnalyser::cut(Vector3d in, Vector3d out, const std::shared_ptr<S
     }
 }
 
+/**
+ * Clips the line segment from @param a to @param b against the cells of the rectangular grid [min, max] with nx*ny*nz cells.
+ * Points on the upper domain boundary are outside (like MappedSegments::soil_index_), a segment of length zero is located by its point.
+ *
+ * @param a, b      segment nodes
+ * @param min       minimum corner of the grid
+ * @param max       maximum corner of the grid
+ * @param nx, ny, nz    number of cells in each direction
+ * @param cells     (out) indices of the cells the segment passes in order from a to b (k*nx*ny+j*nx+i), empty if it is outside
+ * @param t         (out) parametric boundaries of the pieces, i.e. the segment is within cells[c] for t in [t[c], t[c+1]]
+ *                  (cells.size()+1 values, in [0,1])
+ */
+void SegmentAnalyser::voxelise(const Vector3d& a, const Vector3d& b, const Vector3d& min, const Vector3d& max, int nx, int ny, int nz,
+    std::vector<int>& cells, std::vector<double>& t)
+{
+    cells.clear();
+    t.clear();
+    const double p0[3] = { a.x, a.y, a.z };
+    const double d[3] = { b.x-a.x, b.y-a.y, b.z-a.z };
+    const double lo[3] = { min.x, min.y, min.z };
+    const double hi[3] = { max.x, max.y, max.z };
+    const int n[3] = { nx, ny, nz };
+    double t0 = 0., t1 = 1.;
+    for (int k=0; k<3; k++) { // clip to the domain
+        if (d[k]==0.) {
+            if ((p0[k]<lo[k]) || (p0[k]>=hi[k])) {
+                return;
+            }
+        } else {
+            double ta = (lo[k]-p0[k])/d[k];
+            double tb = (hi[k]-p0[k])/d[k];
+            t0 = std::max(t0, std::min(ta, tb));
+            t1 = std::min(t1, std::max(ta, tb));
+        }
+    }
+    bool point = (d[0]==0.) && (d[1]==0.) && (d[2]==0.);
+    if ((t0>t1) || ((t0==t1) && !point)) {
+        return;
+    }
+    t.push_back(t0); // collect the parameters of the cell faces between t0 and t1
+    for (int k=0; k<3; k++) {
+        if (d[k]!=0.) {
+            double h = (hi[k]-lo[k])/n[k];
+            double s0 = (p0[k]+t0*d[k]-lo[k])/h;
+            double s1 = (p0[k]+t1*d[k]-lo[k])/h;
+            int jmin = std::max(int(std::floor(std::min(s0, s1)))+1, 1);
+            int jmax = std::min(int(std::ceil(std::max(s0, s1)))-1, n[k]-1);
+            for (int j=jmin; j<=jmax; j++) {
+                double tj = (lo[k]+j*h-p0[k])/d[k];
+                if ((tj>t0) && (tj<t1)) {
+                    t.push_back(tj);
+                }
+            }
+        }
+    }
+    t.push_back(t1);
+    std::sort(t.begin(), t.end());
+    size_t w = 0; // compact in place, merges pieces in the same cell and skips empty pieces (at edges and corners)
+    for (size_t i=0; i+1<t.size(); i++) {
+        if ((t[i+1]<=t[i]) && !point) {
+            continue;
+        }
+        double tm = 0.5*(t[i]+t[i+1]);
+        int c = 0;
+        for (int k=2; k>=0; k--) { // cell of the midpoint of the piece
+            double h = (hi[k]-lo[k])/n[k];
+            int ik = std::floor((p0[k]+tm*d[k]-lo[k])/h);
+            c = c*n[k] + std::min(std::max(ik, 0), n[k]-1);
+        }
+        if ((!cells.empty()) && (cells.back()==c)) {
+            t[w] = t[i+1];
+        } else {
+            cells.push_back(c);
+            t[++w] = t[i+1];
+        }
+    }
+    t.resize(cells.size()+1);
+}
+
 /**
  * @return The sum of parameter @param name
  */
@@ -617,8 +759,9 @@ void SegmentAnalyser::mapPeriodic(double xx, double yy) {
 void SegmentAnalyser::mapPeriodic_(double xx, Vector3d axis, double eps) {
     /* 1. split segments at the boundaries */
     std::vector<Vector2i> seg;
-    std::vector<std::weak_ptr<Organ>> sO;
-    std::map<std::string, std::vector<double>> ndata;
+    std::vector<size_t> rows; // original segment of seg
+    seg.reserve(segments.size());
+    rows.reserve(segments.size());
 
     for (size_t i=0; i<segments.size(); i++) {
         auto s = segments.at(i);
@@ -628,13 +771,7 @@ void SegmentAnalyser::mapPeriodic_(double xx, Vector3d axis, double eps) {
         int p2 = floor((n2.times(axis)+xx/2.)/xx);
         if (p1 == p2) { //same periodicity index, do nothing [0,xx)
             seg.push_back(s);
-            if (segO.size()>0) { // if used
-                sO.push_back(segO.at(i));
-            }
-            for(auto iter = data.begin(); iter != data.end(); ++iter) { // copy data
-                std::string key =  iter->first;
-                ndata[key].push_back(data[key].at(i));
-            }
+            rows.push_back(i);
         } else { // otherwise split
             if (p1 > p2) { // sort
                 int ind = s.x;
@@ -665,19 +802,12 @@ void SegmentAnalyser::mapPeriodic_(double xx, Vector3d axis, double eps) {
                 c++;
             }
             for (int j=0; j<c; j++) { // copy attached data
-                if (segO.size()>0) { // if used
-                    sO.push_back(segO.at(i));
-                }
-                for(auto iter = data.begin(); iter != data.end(); ++iter) {
-                    std::string key =  iter->first;
-                    ndata[key].push_back(data[key].at(i));
-                }
+                rows.push_back(i);
             }
         }
     }
+    gather(rows); // origins and data
     segments = seg;
-    segO  = sO;
-    data = ndata;
     /* 2. map points to period [-xx/2, xx/2] */
     for (auto& n : nodes) {
         n = n.minus(axis.times(floor((n.times(axis)+xx/2.)/xx)*xx));
@@ -922,6 +1052,65 @@ std::vector<std::vector<SegmentAnalyser>> SegmentAnalyser::distribution2(double
     return d;
 }
 
+/**
+ * Creates a three-dimensional distribution of the parameter @param name on the rectangular grid [min, max] with nx*ny*nz cells,
+ * @see SegmentAnalyser::distribution3(const std::vector<std::string>& names, ...)
+ */
+std::vector<double> SegmentAnalyser::distribution3(std::string name, Vector3d min, Vector3d max, int nx, int ny, int nz, bool exact) const
+{
+    return distribution3(std::vector<std::string>{ name }, min, max, nx, ny, nz, exact).at(0);
+}
+
+/**
+ * Creates three-dimensional distributions of the parameters @param names on a rectangular grid, in a single pass over the segments
+ * (e.g. root length density, for soil coupling, or for comparison with voxel data).
+ *
+ * If @param exact the segments are clipped against the cells (@see SegmentAnalyser::voxelise), "length", "surface", and "volume"
+ * are split proportional to the segment length within each cell, other parameters are added to each cell the segment passes
+ * (as if the segments were cropped to each cell). Otherwise, the segments are located by their midpoints.
+ *
+ * @param names     parameter names
+ * @param min       minimum corner of the grid (cm)
+ * @param max       maximum corner of the grid (cm)
+ * @param nx        number of cells in x-direction
+ * @param ny        number of cells in y-direction
+ * @param nz        number of cells in z-direction
+ * @param exact     clips the segments against the cells (true), only based on segment midpoints (false)
+ * @return          per name the summed parameter per cell, the cell index is k*nx*ny+j*nx+i
+ *                  (like MappedSegments::soil_index_), with z index k starting at min.z
+ */
+std::vector<std::vector<double>> SegmentAnalyser::distribution3(const std::vector<std::string>& names, Vector3d min, Vector3d max,
+    int nx, int ny, int nz, bool exact) const
+{
+    assert(nx>0 && ny>0 && nz>0 && "SegmentAnalyser::distribution3: number of cells must be positive");
+    assert(max.x>min.x && max.y>min.y && max.z>min.z && "SegmentAnalyser::distribution3: max must be larger than min");
+    std::vector<std::vector<double>> d(names.size(), std::vector<double>(size_t(nx)*ny*nz));
+    std::vector<std::vector<double>> values(names.size());
+    std::vector<bool> extensive(names.size()); // proportional to the segment length
+    for (size_t j=0; j<names.size(); j++) {
+        values[j] = getParameter(names[j]);
+        extensive[j] = (names[j]=="length") || (names[j]=="surface") || (names[j]=="volume");
+    }
+    std::vector<int> cells;
+    std::vector<double> t;
+    for (size_t i=0; i<segments.size(); i++) {
+        const Vector3d& n1 = nodes.at(segments[i].x);
+        const Vector3d& n2 = nodes.at(segments[i].y);
+        if (exact) {
+            voxelise(n1, n2, min, max, nx, ny, nz, cells, t);
+        } else {
+            voxelise(n1.plus(n2).times(0.5), n1.plus(n2).times(0.5), min, max, nx, ny, nz, cells, t); // midpoint
+        }
+        for (size_t c=0; c<cells.size(); c++) {
+            double f = exact ? t[c+1]-t[c] : 1.; // fraction of the segment within the cell
+            for (size_t j=0; j<names.size(); j++) {
+                d[j][cells[c]] += extensive[j] ? f*values[j][i] : values[j][i];
+            }
+        }
+    }
+    return d;
+}
+
 /**
  * Adds user data that can be accessed by SegmentAnalyser::getParameter, and that can be written to the VTP file
  * (e.g. used to add simulation results like xylem pressure to the output).
@@ -954,16 +1143,18 @@ void SegmentAnalyser::addData(std::string name, std::vector<double> values)
  * @param name      file name e.g. output.vtp
  * @param types 	Optionally, for vtp we can determine the cell data by a vector of parameter names
  *                  (default = { "radius", "subType", "creationTime", "organType" })
+ * @param format    Optionally, for vtp: VTPWriter::ascii (default), VTPWriter::raw, or VTPWriter::base64
+ * @param compressed    Optionally, for binary vtp: zlib compressed data blocks (default = false)
  */
-void SegmentAnalyser::write(std::string name, std::vector<std::string> types)
+void SegmentAnalyser::write(std::string name, std::vector<std::string> types, int format, bool compressed)
 {
     this->pack(); // a good idea before writing any file
     std::ofstream fos;
-    fos.open(name.c_str());
+    fos.open(name.c_str(), std::ios::binary);
     std::string ext = name.substr(name.size()-3,name.size()); // pick the right writer
     if (ext.compare("vtp")==0) {
         std::cout << "writing VTP: " << name << "\n" << std::flush;
-        this->writeVTP(fos, types);
+        this->writeVTP(fos, types, format, compressed);
     } else if (ext.compare("txt")==0)  {
         std::cout << "writing text file for Matlab import: "<< name << "\n"<< std::flush;
         writeRBSegments(fos);
@@ -977,48 +1168,41 @@ void SegmentAnalyser::write(std::string name, std::vector<std::string> types)
 }
 
 /**
- * Writes a VTP file with @param types data per segment.
+ * Writes a VTP file with @param types data per segment (@see VTPWriter).
  *
- * @param os        a file out stream
+ * @param os        a file out stream (opened in binary mode for binary formats)
  * @param types     parameter names of the cell data  (default = { "radius", "subType", "creationTime", "organType" })
+ * @param format    VTPWriter::ascii (default), VTPWriter::raw, or VTPWriter::base64
+ * @param compressed    for binary formats: zlib compressed data blocks (default = false)
  */
-void SegmentAnalyser::writeVTP(std::ostream & os, std::vector<std::string> types) const
+void SegmentAnalyser::writeVTP(std::ostream & os, std::vector<std::string> types, int format, bool compressed) const
 {
-    os << "<?xml version=\"1.0\"?>";
-    os << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
-    os << "<PolyData>\n";
-    os << "<Piece NumberOfLines=\""<< segments.size() << "\" NumberOfPoints=\""<< nodes.size()<< "\">\n";
+    static_assert(sizeof(Vector3d)==3*sizeof(double), "SegmentAnalyser::writeVTP: nodes are written as contiguous coordinates");
+    static_assert(sizeof(Vector2i)==2*sizeof(int), "SegmentAnalyser::writeVTP: segments are written as contiguous connectivity");
+    VTPWriter writer(os, format, compressed);
+    writer.open(segments.size(), nodes.size());
     // data (CellData)
-    os << "<CellData Scalars=\" CellData\">\n";
-    for (auto name : types) {
-        std::vector<double> data = getParameter(name, -1.);
-        os << "<DataArray type=\"Float32\" Name=\"" << name << "\" NumberOfComponents=\"1\" format=\"ascii\" >\n";
-        for (const auto& t : data) {
-            os << t << " ";
-        }
-        os << "\n</DataArray>\n";
+    writer.openSection("CellData", "Scalars=\"CellData\"");
+    std::vector<std::vector<double>> data(types.size()); // must stay valid until writer.close()
+    for (size_t i=0; i<types.size(); i++) {
+        data[i] = getParameter(types[i], -1.);
+        writer.addArray(types[i], data[i]);
     }
-    os << "\n</CellData>\n";
+    writer.closeSection("CellData");
     // nodes (Points)
-    os << "<Points>\n"<<"<DataArray type=\"Float32\" Name=\"Coordinates\" NumberOfComponents=\"3\" format=\"ascii\" >\n";
-    for (const auto& n : nodes) {
-        os << n.x << " "<< n.y <<" "<< n.z<< " ";
-    }
-    os << "\n</DataArray>\n"<< "</Points>\n";
+    writer.openSection("Points");
+    writer.addArray("Coordinates", reinterpret_cast<const double*>(nodes.data()), 3*nodes.size(), 3);
+    writer.closeSection("Points");
     // segments (Lines)
-    os << "<Lines>\n"<<"<DataArray type=\"Int32\" Name=\"connectivity\" NumberOfComponents=\"1\" format=\"ascii\" >\n";
-    for (const auto& s : segments) {
-        os << s.x << " " << s.y << " ";
-    }
-    os << "\n</DataArray>\n"<<"<DataArray type=\"Int32\" Name=\"offsets\" NumberOfComponents=\"1\" format=\"ascii\" >\n";
+    writer.openSection("Lines");
+    writer.addArray("connectivity", reinterpret_cast<const int*>(segments.data()), 2*segments.size());
+    std::vector<int> offsets(segments.size());
     for (size_t i=0; i<segments.size(); i++) {
-        os << 2*i+2 << " ";
+        offsets[i] = 2*i+2;
     }
-    os << "\n</DataArray>\n";
-    os << "\n</Lines>\n";
-    //
-    os << "</Piece>\n";
-    os << "</PolyData>\n" << "</VTKFile>\n";
+    writer.addArray("offsets", offsets);
+    writer.closeSection("Lines");
+    writer.close();
 }
 
 /**
@@ -1056,11 +1240,11 @@ void SegmentAnalyser::writeRBSegments(std::ostream & os) const
         Vector3d n2 = nodes.at(s.y);
         int x = s.x;
         int y = s.y;
-        double radius = o->getParameter("radius");
+        double radius = o->getParameter(Organ::pk_radius);
         double time = ctime[i];
-        double age = o->getParameter("age");
-        int subType = o->getParameter("subType");
-        int id = o->getParameter("id");
+        double age = o->getParameter(Organ::pk_age);
+        int subType = o->getParameter(Organ::pk_subType);
+        int id = o->getParameter(Organ::pk_id);
         ctime_seg.push_back( std::make_tuple(time, x, y, branchnumber, n1.x, n1.y, n1.z, n2.x, n2.y, n2.z, radius, age, subType, organ, id  ));
         //        auto parent_id = std::find_if(segments.begin(), segments.end(), [y](const Vector2i s_){return s_.x == y; });
         //        if (parent_id != segments.end())
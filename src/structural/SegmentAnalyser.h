@@ -9,6 +9,7 @@
 #include <memory>
 #include <limits>
 #include <tuple>
+#include <functional>
 
 namespace CPlantBox {
 
@@ -49,6 +50,7 @@ public:
     void cropDomain(double xx, double yy, double zz); // crops to the domain @see SDF_PlantBox
     void filter(std::string name, double min, double max); ///< filters the segments to the data @see AnalysisSDF::getParameter
     void filter(std::string name, double value); ///< filters the segments to the data @see AnalysisSDF::getParameter
+    void select(const std::vector<bool>& mask); ///< keeps the segments where @param mask is true
     void pack(); ///< sorts the nodes and deletes unused nodes
     Vector3d getMinBounds(); ///< get minimum of node coordinates (e.g. minimum corner of bounding box)
     Vector3d getMaxBounds(); ///< get maximum of node coordinates (e.g. maximum corner of bounding box)
@@ -62,7 +64,9 @@ public:
     std::vector<SegmentAnalyser> distribution(double top, double bot, int n) const; ///< vertical distribution
     std::vector<std::vector<double>> distribution2(std::string name, double top, double bot, double left, double right, int n, int m, bool exact=false) const; ///< 2d distribution (x,z) of a parameter
     std::vector<std::vector<SegmentAnalyser>> distribution2(double top, double bot, double left, double right, int n, int m) const; ///< 2d distribution (x,z)
-    // todo distribution3
+    std::vector<double> distribution3(std::string name, Vector3d min, Vector3d max, int nx, int ny, int nz, bool exact=false) const; ///< 3d distribution of a parameter
+    std::vector<std::vector<double>> distribution3(const std::vector<std::string>& names, Vector3d min, Vector3d max, int nx, int ny, int nz,
+        bool exact=false) const; ///< 3d distributions of several parameters (in a single pass)
 
     // rather specialized things we want to know
     void mapPeriodic(double xx, double yy); /// maps into a periodic domain, splits up intersecting segments
@@ -73,17 +77,25 @@ public:
     SegmentAnalyser cut(const SDF_HalfPlane& plane) const; ///< returns the segments intersecting with a plane (e.g. for trenches)
 
 
+    // multithreading
+    void setParallel(int threads) { parallel = threads; } ///< uses @param threads threads for crop and for compacting the segment data (0 = off)
+    int getParallel() const { return parallel; } ///< number of threads, 0 if off
+
     // User data for export or distributions
     void addData(std::string name, std::vector<double> data); ///< adds user data that are written into the VTP file, @see SegmentAnalyser::writeVTP
 
     // some exports
-    void write(std::string name, std::vector<std::string>  types = { "radius", "subType", "creationTime", "organType" }); ///< writes simulation results (type is determined from file extension in name)
-    void writeVTP(std::ostream & os, std::vector<std::string>  types = { "radius", "subType", "creationTime", "organType"  }) const; ///< writes a VTP file
+    void write(std::string name, std::vector<std::string>  types = { "radius", "subType", "creationTime", "organType" },
+        int format = 0, bool compressed = false); ///< writes simulation results (type is determined from file extension in name)
+    void writeVTP(std::ostream & os, std::vector<std::string>  types = { "radius", "subType", "creationTime", "organType"  },
+        int format = 0, bool compressed = false) const; ///< writes a VTP file, format is a VTPWriter::Format
     void writeRBSegments(std::ostream & os) const; ///< Writes the segments of the root system, mimics the Matlab script getSegments()
     void writeDGF(std::ostream & os) const; ///< Writes the segments of the root system in DGF format used by DuMux
 
     // auxiliary
     static Vector3d cut(Vector3d in, Vector3d out, const std::shared_ptr<SignedDistanceFunction>& geometry, double eps = 1.e-6); ///< intersects a line with  the geometry
+    static void voxelise(const Vector3d& a, const Vector3d& b, const Vector3d& min, const Vector3d& max, int nx, int ny, int nz,
+        std::vector<int>& cells, std::vector<double>& t); ///< clips the line segment a-b against the cells of a rectangular grid
 
     std::vector<Vector3d> nodes; ///< nodes
     std::vector<Vector2i> segments; ///< connectivity of the nodes
@@ -93,6 +105,10 @@ public:
 protected:
 
     void mapPeriodic_(double xx, Vector3d axis, double eps);
+    void gather(const std::vector<size_t>& rows); ///< keeps the segments with indices @param rows (in this order), together with their origins and data
+    void parallelFor(size_t n, const std::function<void(size_t, size_t)>& f) const; ///< calls f(begin, end) for chunks of [0,n), on SegmentAnalyser::parallel threads
+
+    int parallel = 0; ///< number of threads, see SegmentAnalyser::setParallel
 
 };
 
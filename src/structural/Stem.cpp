@@ -8,8 +8,6 @@
 
 namespace CPlantBox {
 
-std::vector<int> Stem::phytomerId = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
-
 /**
  * Constructs a root from given data.
  * The organ tree must be created, @see Organ::setPlant, Organ::setParent, Organ::addChild
@@ -54,15 +52,16 @@ Stem::Stem(std::shared_ptr<Organism> plant, int type, double delay,  std::shared
 	assert(parent!=nullptr && "Stem::Stem parent must be set");
 	auto p = this->param();
 	addPhytomerId(p->subType);
-	double beta = getphytomerId(p->subType)*M_PI*getStemRandomParameter()->rotBeta +
-			M_PI*plant->rand()*getStemRandomParameter()->betaDev;
-	beta = beta + getStemRandomParameter()->initBeta*M_PI;
-	if (getStemRandomParameter()->initBeta >0 && getphytomerId(p->subType)==0 ){
-		beta = beta + getStemRandomParameter()->initBeta*M_PI;
+	phytomerId = getphytomerId(p->subType);
+	double beta = getphytomerId(p->subType)*M_PI*srp()->rotBeta +
+			M_PI*plant->rand()*srp()->betaDev;
+	beta = beta + srp()->initBeta*M_PI;
+	if (srp()->initBeta >0 && getphytomerId(p->subType)==0 ){
+		beta = beta + srp()->initBeta*M_PI;
 	}
 	double theta = p->theta;//M_PI*p->theta;
 	if (parent->organType()!=Organism::ot_seed) { // scale if not a base organ, to delete?
-		double scale = getStemRandomParameter()->f_sa->getValue(parent->getNode(pni), parent);
+		double scale = srp()->f_sa->getValue(parent->getNode(pni), parent);
 		theta *= scale;
 	}
 	//used when computing actual heading, @see Stem::getIHeading
@@ -73,7 +72,7 @@ Stem::Stem(std::shared_ptr<Organism> plant, int type, double delay,  std::shared
 		// @see stem::createLateral
 		double creationTime;
 		if (parent->getNumberOfChildren() == 0){creationTime = parent->getNodeCT(pni)+delay;
-		}else{creationTime = parent->getChild(0)->getParameter("creationTime") + delay;}
+		}else{creationTime = parent->getChild(0)->getParameter(pk_creationTime) + delay;}
 		
 		Organ::addNode(Vector3d(0.,0.,0.), parent->getNodeId(pni), creationTime);//do not know why, but i have to add "Organ::" now
 	}
@@ -84,15 +83,18 @@ Stem::Stem(std::shared_ptr<Organism> plant, int type, double delay,  std::shared
  * All laterals are deep copied, plant and parent pointers are updated.
  *
  * @param plant     the plant the copied organ will be part of
+ * @param share     share the organ specific parameters (see Organism::fork)
  */
-std::shared_ptr<Organ> Stem::copy(std::shared_ptr<Organism> p)
+std::shared_ptr<Organ> Stem::copy(std::shared_ptr<Organism> p, bool share)
 {
 	auto s = std::make_shared<Stem>(*this); // shallow copy
 	s->parent = std::weak_ptr<Organ>();
 	s->plant = p;
-	s->param_ = std::make_shared<StemSpecificParameter>(*param()); // copy parameters
+	if (!share) { // a fork shares the parameters (they are constant)
+		s->param_ = std::make_shared<StemSpecificParameter>(*param()); // copy parameters
+	}
 	for (size_t i=0; i< children.size(); i++) {
-		s->children[i] = children[i]->copy(p); // copy laterals
+		s->children[i] = children[i]->copy(p, share); // copy laterals
 		s->children[i]->setParent(s);
 	}
 	return s;
@@ -129,7 +131,7 @@ void Stem::simulate(double dt, bool verbose)
 		// probabilistic branching model (todo test)
 		if ((age>0) && (age-dt<=0)) { // the root emerges in this time step
 			//use relative coordinates for this function. Delete as it s not a root?
-			double P = getStemRandomParameter()->f_sbp->getValue(nodes.back(),shared_from_this());
+			double P = srp()->f_sbp->getValue(nodes.back(),shared_from_this());
 			if (P<1.) { // P==1 means the lateral emerges with probability 1 (default case)
 				double p = 1.-std::pow((1.-P), dt); //probability of emergence in this time step
 				if (plant.lock()->rand()>p) { // not rand()<p
@@ -273,7 +275,7 @@ double Stem::getLatGrowthDelay(int ot_lat, int st_lat, double dt) const //overri
 {
 	
 	bool verbose = false;
-	auto rp = getOrganRandomParameter(); // rename
+	auto rp = orp(); // rename
 	double forDelay; //store necessary variables to define lateral growth delay
 	int delayDefinition = std::static_pointer_cast<const SeedRandomParameter>(getOrganism()->getOrganRandomParameter(Organism::ot_seed,0))->delayDefinition;
 
@@ -288,7 +290,7 @@ double Stem::getLatGrowthDelay(int ot_lat, int st_lat, double dt) const //overri
 	//count the number of laterals of subtype st already created on this organ std::function<double(int, int, std::shared_ptr<Organ>)> 
 	auto correctST = [ot_lat, st_lat](std::shared_ptr<Organ> org) -> double
 		{
-			return double((org->getParameter("organType") == ot_lat)&&(org->getParameter("subType")==st_lat));
+			return double((org->getParameter(pk_organType) == ot_lat)&&(org->getParameter(pk_subType)==st_lat));
 		};//return 1. if organ of correct type and subtype, 0. otherwise
 	
 	double multiplyDelay = double(std::count_if(children.begin(), children.end(),
@@ -297,12 +299,12 @@ double Stem::getLatGrowthDelay(int ot_lat, int st_lat, double dt) const //overri
 	switch(delayDefinition){
 		case Organism::dd_distance:
 		{
-			double meanLn = getParameter("lnMean"); // mean inter-lateral distance
-			double effectiveLa = std::max(getParameter("la")-meanLn/2, 0.); // effective apical distance, observed apical distance is in [la-ln/2, la+ln/2]
+			double meanLn = getParameter(pk_lnMean); // mean inter-lateral distance
+			double effectiveLa = std::max(getParameter(pk_la)-meanLn/2, 0.); // effective apical distance, observed apical distance is in [la-ln/2, la+ln/2]
 			if(verbose)
 			{
-				std::cout<<"case Organism::dd_distance "<<organType()<<" "<<getParameter("subType")<<" "<<getLength(true)
-				<<" "<<effectiveLa<<" "<<getParameter("la")<<" "<<meanLn<<std::endl;
+				std::cout<<"case Organism::dd_distance "<<organType()<<" "<<getParameter(pk_subType)<<" "<<getLength(true)
+				<<" "<<effectiveLa<<" "<<getParameter(pk_la)<<" "<<meanLn<<std::endl;
 			}
 			double ageLN = this->calcAge(param()->lb); // age of root when lateral node is created
 			ageLN = std::max(ageLN, age-dt);
@@ -410,20 +412,21 @@ void Stem::internodalGrowth(double dl,double dt, bool verbose)
  * @param name 		parameter name (returns nan if not available)
  *
  */
-double Stem::getParameter(std::string name) const
+double Stem::getParameter(int key) const
 {
-	if (name=="lb") { return param()->lb; } // basal zone [cm]
-	if (name=="delayNGStart") { return param()->delayNGStart; } // delay for nodal growth [day]
-	if (name=="delayNGEnd") { return param()->delayNGEnd; } // delay for nodal growth [day]
-	if (name=="la") { return param()->la; } // apical zone [cm]
-	if (name=="nob") { return param()->nob(); } // number of branching points
-	if (name=="r"){ return param()->r; }  // initial growth rate [cm day-1]
-	if (name=="radius") { return param()->a; } // root radius [cm]
-	if (name=="a") { return param()->a; } // root radius [cm]
-	if (name=="theta") { return param()->theta; } // angle between root and parent root [rad]
-	if (name=="rlt") { return param()->rlt; } // root life time [day]
-	if (name=="k") { return param()->getK(); }; // maximal root length [cm]
-	if (name=="lnMean") { // mean lateral distance [cm]
+	switch (key) {
+	case pk_lb: return param()->lb; // basal zone [cm]
+	case pk_delayNGStart: return param()->delayNGStart; // delay for nodal growth [day]
+	case pk_delayNGEnd: return param()->delayNGEnd; // delay for nodal growth [day]
+	case pk_la: return param()->la; // apical zone [cm]
+	case pk_nob: return param()->nob(); // number of branching points
+	case pk_r: return param()->r;  // initial growth rate [cm day-1]
+	case pk_radius: return param()->a; // root radius [cm]
+	case pk_a: return param()->a; // root radius [cm]
+	case pk_theta: return param()->theta; // angle between root and parent root [rad]
+	case pk_rlt: return param()->rlt; // root life time [day]
+	case pk_k: return param()->getK(); // maximal root length [cm]
+	case pk_lnMean: { // mean lateral distance [cm]
         auto& v =param()->ln;
 		if(v.size()>0){
 			return std::accumulate(v.begin(), v.end(), 0.0) / v.size();
@@ -431,18 +434,19 @@ double Stem::getParameter(std::string name) const
 			return 0;
 		}
 	}
-	if (name=="lnDev") { // standard deviation of lateral distance [cm]
+	case pk_lnDev: { // standard deviation of lateral distance [cm]
 		auto& v =param()->ln;
 		double mean = std::accumulate(v.begin(), v.end(), 0.0) / v.size();
 		double sq_sum = std::inner_product(v.begin(), v.end(), v.begin(), 0.0);
 		return std::sqrt(sq_sum / v.size() - mean * mean);
 	}
-	if (name=="volume") { return param()->a*param()->a*M_PI*getLength(true); } // // root volume [cm^3]
-	if (name=="surface") { return 2*param()->a*M_PI*getLength(true); }
-	if (name=="type") { return this->param_->subType; }  // delete to avoid confusion?
-	if (name=="subType") { return this->param_->subType; }  // organ sub-type [-]
-	if (name=="parentNI") { return parentNI; } // local parent node index where the lateral emerges
-	return Organ::getParameter(name);
+	case pk_volume: return param()->a*param()->a*M_PI*getLength(true); // // root volume [cm^3]
+	case pk_surface: return 2*param()->a*M_PI*getLength(true);
+	case pk_type: return this->param_->subType;  // delete to avoid confusion?
+	case pk_subType: return this->param_->subType;  // organ sub-type [-]
+	case pk_parentNI: return parentNI; // local parent node index where the lateral emerges
+	default: return Organ::getParameter(key);
+	}
 }
 
 
@@ -456,7 +460,7 @@ double Stem::getParameter(std::string name) const
 double Stem::calcLength(double age)
 {
 	assert(age>=0 && "Stem::calcLength() negative root age");
-	return getStemRandomParameter()->f_gf->getLength(age,getStemRandomParameter()->r,param()->getK(),shared_from_this());
+	return srp()->f_gf->getLength(age,srp()->r,param()->getK(),shared_from_this());
 }
 
 /**
@@ -468,7 +472,7 @@ double Stem::calcLength(double age)
 double Stem::calcAge(double length) const
 {
 	assert(length>=0 && "Stem::calcAge() negative root age");
-	double age__ = getStemRandomParameter()->f_gf->getAge(length,getStemRandomParameter()->r,param()->getK(),shared_from_this());
+	double age__ = srp()->f_gf->getAge(length,srp()->r,param()->getK(),shared_from_this());
 	if(age__ >param()->delayNGStart ){age__ += (param()->delayNGEnd - param()->delayNGStart);}
 	return age__;
 }
@@ -507,7 +511,7 @@ void Stem::addNode(Vector3d n, int id, double t, size_t index, bool shift)
 	bool verbose = false;
 	if(verbose)
 	{
-		std::cout<<"Organ::addNode "<<id<<" "<<getId()<<" "<<organType()<<" "<<getParameter("subType")<<std::endl;
+		std::cout<<"Organ::addNode "<<id<<" "<<getId()<<" "<<organType()<<" "<<getParameter(pk_subType)<<std::endl;
 		std::cout<<"Organ::addNode "<<n.toString()<<" "<<t<<" "<<index<<" "<<shift<<std::endl;
 		
 	}
@@ -515,9 +519,11 @@ void Stem::addNode(Vector3d n, int id, double t, size_t index, bool shift)
 		nodes.push_back(n); // node
 		nodeIds.push_back(id); //unique id
 		nodeCTs.push_back(t); // exact creation time
+		updateLengths(nodes.size()-1);
 	}
 	else{//could be quite slow  to insert, but we won t have that many (node-)tillers (?)
 		nodes.insert(nodes.begin() + index-1, n);//add the node at index
+		updateLengths(index-1);
 		//add a global index.
 		//no need for the nodes to keep the same global index and makes the update of the nodes position for MappedPlant object more simple)
 		//if(verbose){
@@ -540,6 +546,7 @@ void Stem::addNode(Vector3d n, int id, double t, size_t index, bool shift)
 		}
 
 	}
+	setChanged();
 }
 
 
@@ -570,4 +577,55 @@ std::string Stem::toString() const
 	return Organ::toString()+newstring.str();
 }
 
+/**
+ * The phytomer counter per sub type is stored in the plant (@see Plant::stemphytomerID), or in the growth task
+ */
+void Stem::minusPhytomerId(int subtype)
+{
+	stemphytomerIDs().at(subtype)--;
+}
+
+int Stem::getphytomerId(int subtype)
+{
+	return stemphytomerIDs().at(subtype);
+}
+
+void Stem::addPhytomerId(int subtype)
+{
+	stemphytomerIDs().at(subtype)++;
+}
+
+std::vector<int>& Stem::stemphytomerIDs()
+{
+	auto t = Organism::growthTask; // within a growth task, @see GrowthTask
+	return t ? t->stemphytomerID : getPlant()->stemphytomerID;
+}
+
+/**
+ * The part of the rotation beta (see Stem::Stem) that depends on the phytomer id @param id
+ */
+double Stem::phytomerBeta(int id) const
+{
+	double b = id*M_PI*srp()->rotBeta;
+	if (srp()->initBeta >0 && id==0 ){
+		b += srp()->initBeta*M_PI;
+	}
+	return b;
+}
+
+/**
+ * Within a growth task the phytomer id is counted from zero, afterwards @param stemShift (per sub type) is added
+ * to make it plant-wide, and the stem is rotated accordingly (@see Leaf::shiftPhytomerIds)
+ */
+void Stem::shiftPhytomerIds(int organBase, const std::vector<int>& leafShift, const std::vector<int>& stemShift)
+{
+	int shift = stemShift.at(param()->subType);
+	if ((id>organBase) && (shift!=0)) {
+		double db = phytomerBeta(phytomerId+shift)-phytomerBeta(phytomerId);
+		phytomerId += shift;
+		partialIHeading = Matrix3d::rotX(db).times(partialIHeading); // rotAB(theta, beta+db)
+	}
+	Organ::shiftPhytomerIds(organBase, leafShift, stemShift);
+}
+
 } // namespace CPlantBox
@@ -23,14 +23,12 @@ class Stem : public Organ
 {
 public:
 
-    static std::vector<int> phytomerId;
-
     Stem(int id,  std::shared_ptr<const OrganSpecificParameter> param, bool alive, bool active, double age, double length,
     		Vector3d partialIHeading_, int pni, bool moved = true, int oldNON = 0);
     Stem(std::shared_ptr<Organism> plant, int type, double delay, std::shared_ptr<Organ> parent, int pni); ///< used within simulation
     virtual ~Stem() { };
 
-    std::shared_ptr<Organ> copy(std::shared_ptr<Organism> plant) override;   ///< deep copies the root tree
+    std::shared_ptr<Organ> copy(std::shared_ptr<Organism> plant, bool share = false) override;   ///< deep copies the root tree
 
     int organType() const override { return Organism::ot_stem; } ///< returns the organs type
 
@@ -41,7 +39,8 @@ public:
 	Vector3d getNode(int i) const override { return nodes.at(i); } ///< i-th node of the organ
 	void addNode(Vector3d n, int id, double t, size_t index, bool shift) override; //< adds a node to the root
 
-    double getParameter(std::string name) const override; ///< returns an organ parameter
+    using Organ::getParameter;
+    double getParameter(int key) const override; ///< returns an organ parameter, by its key (@see Organ::parameterKey)
 	std::string toString() const override;
 
     /* exact from analytical equations */
@@ -53,14 +52,19 @@ public:
     std::shared_ptr<const StemSpecificParameter> param() const; ///< root parameter
 
     int shootborneType = 5;
+    void shiftPhytomerIds(int organBase, const std::vector<int>& leafShift, const std::vector<int>& stemShift) override; ///< shifts the phytomer id, and rotates the stem accordingly
 
 																										 
 protected:
+	StemRandomParameter* srp() const { return static_cast<StemRandomParameter*>(orp()); } ///< cached stem type parameter, see Organ::orp
 	void storeLinkingNodeLocalId(int numCreatedLN, bool silence) override; ///<  override by @see Organ::createNonGrowingLateral()
 	std::vector<int> localId_linking_nodes;
-	void minusPhytomerId(int subtype) { phytomerId[subtype]--;  }
-    int getphytomerId(int subtype) { return phytomerId[subtype]; }
-    void addPhytomerId(int subtype) { phytomerId[subtype]++;  }
+	void minusPhytomerId(int subtype);
+    int getphytomerId(int subtype);
+    void addPhytomerId(int subtype);
+    std::vector<int>& stemphytomerIDs(); ///< phytomer counters of the plant, or of the growth task
+    double phytomerBeta(int id) const; ///< part of the rotation beta that depends on the phytomer id
+    int phytomerId = 0; ///< phytomer id within the sub type (@see Stem::phytomerBeta)
 
 };
 
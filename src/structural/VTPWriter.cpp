@@ -0,0 +1,291 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#include "VTPWriter.h"
+
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+
+#ifdef CPLANTBOX_ZLIB
+#include <zlib.h>
+#endif
+
+namespace CPlantBox {
+
+namespace {
+
+/**
+ * Base64 encoder writing to a stream, that can be fed in several pieces
+ */
+class Base64Encoder
+{
+public:
+
+    Base64Encoder(std::ostream& os) :os(os) { }
+
+    void write(const char* bytes, size_t size) {
+        for (size_t i = 0; i<size; i++) {
+            buf[n++] = (unsigned char)bytes[i];
+            if (n==3) {
+                encode();
+            }
+        }
+    }
+
+    void flush() { ///< encodes the remaining bytes with padding, and writes the encoded characters
+        if (n>0) {
+            encode();
+        }
+        os.write(out, m);
+        m = 0;
+    }
+
+private:
+
+    void encode() {
+        static const char* table = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i = n; i<3; i++) {
+            buf[i] = 0;
+        }
+        out[m++] = table[buf[0] >> 2];
+        out[m++] = table[((buf[0] & 0x03) << 4) | (buf[1] >> 4)];
+        out[m++] = n>1 ? table[((buf[1] & 0x0f) << 2) | (buf[2] >> 6)] : '=';
+        out[m++] = n>2 ? table[buf[2] & 0x3f] : '=';
+        n = 0;
+        if (m==sizeof(out)) {
+            os.write(out, m);
+            m = 0;
+        }
+    }
+
+    std::ostream& os;
+    unsigned char buf[3] = { 0, 0, 0 };
+    int n = 0;
+    char out[4096]; // encoded characters
+    size_t m = 0;
+};
+
+size_t base64Size(size_t size) { // number of characters of the encoded (and padded) data
+    return 4*((size+2)/3);
+}
+
+/**
+ * Passes the 32 bit values of a data array in pieces of at most VTPWriter::blockSize bytes to @param f,
+ * Float32 data is converted from double piece by piece
+ */
+template<class F>
+void forEachBlock(const void* data, size_t n, bool isFloat, F f)
+{
+    const size_t m = VTPWriter::blockSize/4; // values per block
+    std::vector<float> buf;
+    for (size_t i = 0; i<n; i += m) {
+        size_t k = std::min(m, n-i);
+        if (isFloat) {
+            const double* d = (const double*)data+i;
+            buf.assign(d, d+k);
+            f((const char*)buf.data(), 4*k);
+        } else {
+            f((const char*)((const int*)data+i), 4*k);
+        }
+    }
+}
+
+bool isLittleEndian() {
+    uint16_t one = 1;
+    return *((const char*)&one)==1;
+}
+
+} // namespace
+
+/**
+ * @param os            the output stream, e.g. a std::ofstream
+ * @param format        VTPWriter::ascii, VTPWriter::raw, or VTPWriter::base64
+ * @param compressed    zlib compression of binary data (needs CPlantBox built with zlib)
+ */
+VTPWriter::VTPWriter(std::ostream& os, int format, bool compressed) :os(os), format(format), compressed(compressed)
+{
+    if ((format<ascii) || (format>base64)) {
+        throw std::invalid_argument("VTPWriter::VTPWriter: unknown format "+std::to_string(format));
+    }
+    if (format==ascii) {
+        this->compressed = false; // ascii data is never compressed
+    }
+    if (this->compressed && !hasCompression()) {
+        throw std::invalid_argument("VTPWriter::VTPWriter: CPlantBox was built without zlib, compression is not available");
+    }
+}
+
+bool VTPWriter::hasCompression()
+{
+#ifdef CPLANTBOX_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Writes the xml header and opens the piece
+ *
+ * @param numberOfLines     number of polylines (or segments)
+ * @param numberOfPoints    number of points
+ */
+void VTPWriter::open(size_t numberOfLines, size_t numberOfPoints)
+{
+    appended.clear();
+    offset = 0;
+    os << "<?xml version=\"1.0\"?>\n";
+    os << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"" << (isLittleEndian() ? "LittleEndian" : "BigEndian") << "\"";
+    if (format!=ascii) {
+        os << " header_type=\"UInt64\"";
+    }
+    if (compressed) {
+        os << " compressor=\"vtkZLibDataCompressor\"";
+    }
+    os << ">\n<PolyData>\n";
+    os << "<Piece NumberOfLines=\"" << numberOfLines << "\" NumberOfPoints=\"" << numberOfPoints << "\">\n";
+}
+
+/**
+ * Opens a section of the piece
+ *
+ * @param name          e.g. PointData, CellData, Points, or Lines
+ * @param attributes    optional xml attributes of the section, e.g. Scalars="CellData"
+ */
+void VTPWriter::openSection(std::string name, std::string attributes)
+{
+    os << "<" << name << (attributes.empty() ? "" : " ") << attributes << ">\n";
+}
+
+void VTPWriter::closeSection(std::string name)
+{
+    os << "</" << name << ">\n";
+}
+
+/**
+ * Closes the piece, and writes the appended data (in case of binary formats),
+ * each data array is streamed (and encoded) directly from its buffer
+ */
+void VTPWriter::close()
+{
+    os << "</Piece>\n</PolyData>\n";
+    if (format!=ascii) {
+        os << "<AppendedData encoding=\"" << (format==raw ? "raw" : "base64") << "\">\n_";
+        for (const auto& a : appended) {
+            if (compressed) {
+                if (format==raw) {
+                    os.write(a.blocks.data(), a.blocks.size());
+                } else { // header and blocks are encoded separately
+                    Base64Encoder enc(os);
+                    enc.write(a.blocks.data(), a.headerSize);
+                    enc.flush();
+                    enc.write(a.blocks.data()+a.headerSize, a.blocks.size()-a.headerSize);
+                    enc.flush();
+                }
+            } else {
+                uint64_t header = 4*a.n;
+                if (format==raw) {
+                    os.write((const char*)&header, sizeof(uint64_t));
+                    forEachBlock(a.data, a.n, a.isFloat, [&](const char* bytes, size_t size) { os.write(bytes, size); });
+                } else { // header and data are encoded together
+                    Base64Encoder enc(os);
+                    enc.write((const char*)&header, sizeof(uint64_t));
+                    forEachBlock(a.data, a.n, a.isFloat, [&](const char* bytes, size_t size) { enc.write(bytes, size); });
+                    enc.flush();
+                }
+            }
+        }
+        os << "\n</AppendedData>\n";
+        appended.clear();
+    }
+    os << "</VTKFile>\n";
+}
+
+/**
+ * Adds a Float32 data array
+ *
+ * @param name          name of the data array
+ * @param data          contiguous data of size n
+ * @param n             number of values (i.e. number of tuples times components)
+ * @param components    number of components per tuple (e.g. 3 for coordinates)
+ */
+void VTPWriter::addArray(std::string name, const double* data, size_t n, int components)
+{
+    if (format==ascii) {
+        os << "<DataArray type=\"Float32\" Name=\"" << name << "\" NumberOfComponents=\"" << components << "\" format=\"ascii\">\n";
+        auto precision = os.precision(std::numeric_limits<float>::max_digits10); // exact for Float32
+        for (size_t i = 0; i<n; i++) {
+            os << (float)data[i] << " ";
+        }
+        os.precision(precision);
+        os << "\n</DataArray>\n";
+    } else {
+        addBinary(name, "Float32", data, n, true, components);
+    }
+}
+
+/**
+ * Adds an Int32 data array
+ *
+ * @param name          name of the data array
+ * @param data          contiguous data of size n
+ * @param n             number of values (i.e. number of tuples times components)
+ * @param components    number of components per tuple
+ */
+void VTPWriter::addArray(std::string name, const int* data, size_t n, int components)
+{
+    static_assert(sizeof(int)==4, "VTPWriter: expects 32 bit integers");
+    if (format==ascii) {
+        os << "<DataArray type=\"Int32\" Name=\"" << name << "\" NumberOfComponents=\"" << components << "\" format=\"ascii\">\n";
+        for (size_t i = 0; i<n; i++) {
+            os << data[i] << " ";
+        }
+        os << "\n</DataArray>\n";
+    } else {
+        addBinary(name, "Int32", data, n, false, components);
+    }
+}
+
+/**
+ * Writes the DataArray element referencing the appended data, and registers the data array for VTPWriter::close
+ * (UInt64 header followed by the data, see VTK file formats). Compressed data is compressed here,
+ * since its size determines the offset of the next data array.
+ *
+ * @param data      contiguous data of n values (double for Float32, int for Int32)
+ */
+void VTPWriter::addBinary(std::string name, std::string type, const void* data, size_t n, bool isFloat, int components)
+{
+    os << "<DataArray type=\"" << type << "\" Name=\"" << name << "\" NumberOfComponents=\"" << components
+        << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+    Appended a = { data, n, isFloat, "", 0 };
+    size_t size = 4*n; // Float32 or Int32
+    if (!compressed) {
+        size_t bytes = sizeof(uint64_t)+size;
+        offset += (format==raw) ? bytes : base64Size(bytes);
+    } else {
+#ifdef CPLANTBOX_ZLIB
+        size_t nb = (size+blockSize-1)/blockSize; // number of blocks
+        std::vector<uint64_t> header(3+nb);
+        header[0] = nb;
+        header[1] = blockSize;
+        header[2] = size%blockSize; // size of the last partial block, 0 if full
+        a.headerSize = header.size()*sizeof(uint64_t);
+        a.blocks.assign(a.headerSize, 0); // header is set after compression
+        std::vector<Bytef> buf(compressBound(blockSize));
+        size_t i = 0;
+        forEachBlock(data, n, isFloat, [&](const char* bytes, size_t bs) {
+            uLongf cs = buf.size();
+            if (compress2(buf.data(), &cs, (const Bytef*)bytes, bs, Z_DEFAULT_COMPRESSION)!=Z_OK) {
+                throw std::runtime_error("VTPWriter::addBinary: zlib compression failed for "+name);
+            }
+            header[3+i++] = cs;
+            a.blocks.append((const char*)buf.data(), cs);
+        });
+        std::copy((const char*)header.data(), (const char*)header.data()+a.headerSize, a.blocks.begin());
+        size_t bs = a.blocks.size()-a.headerSize;
+        offset += (format==raw) ? a.headerSize+bs : base64Size(a.headerSize)+base64Size(bs);
+#endif
+    }
+    appended.push_back(std::move(a));
+}
+
+} // namespace
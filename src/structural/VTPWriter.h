@@ -0,0 +1,69 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#ifndef VTPWRITER_H_
+#define VTPWRITER_H_
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace CPlantBox {
+
+/**
+ * Writes VTK XML poly data (.vtp) with lines,
+ * either as ascii, or as binary appended data (raw or base64 encoded, optionally zlib compressed).
+ *
+ * The data arrays are passed as contiguous buffers, and are written (or encoded) directly.
+ * For binary formats, the DataArray elements (with their offsets) are written first, and VTPWriter::close
+ * streams the data arrays into the AppendedData section, i.e. the buffers must stay valid until close is called.
+ * Compressed blocks are the only data kept by the writer.
+ *
+ * Usage: open(), openSection("CellData"), addArray(...), ..., closeSection(), ..., close()
+ */
+class VTPWriter
+{
+public:
+
+    enum Format { ascii = 0, raw = 1, base64 = 2 }; ///< ascii inline data, appended raw binary data, appended base64 encoded data
+
+    VTPWriter(std::ostream& os, int format = ascii, bool compressed = false);
+
+    static bool hasCompression(); ///< true, if CPlantBox was built with zlib
+
+    void open(size_t numberOfLines, size_t numberOfPoints); ///< writes the header, and opens the piece
+    void openSection(std::string name, std::string attributes = ""); ///< e.g. PointData, CellData, Points, or Lines
+    void closeSection(std::string name);
+    void close(); ///< closes the piece, and writes the appended data
+
+    void addArray(std::string name, const double* data, size_t n, int components = 1); ///< Float32 data array
+    void addArray(std::string name, const std::vector<double>& data, int components = 1) { addArray(name, data.data(), data.size(), components); }
+    void addArray(std::string name, std::vector<double>&& data, int components = 1) = delete; ///< the data is written by close
+    void addArray(std::string name, const int* data, size_t n, int components = 1); ///< Int32 data array
+    void addArray(std::string name, const std::vector<int>& data, int components = 1) { addArray(name, data.data(), data.size(), components); }
+    void addArray(std::string name, std::vector<int>&& data, int components = 1) = delete; ///< the data is written by close
+
+    static constexpr size_t blockSize = 32768; ///< uncompressed size of the compressed blocks [bytes]
+
+protected:
+
+    struct Appended { // a data array of the AppendedData section
+        const void* data; // Float32 arrays are converted from double
+        size_t n; // number of values
+        bool isFloat;
+        std::string blocks; // header and compressed blocks (if compressed)
+        size_t headerSize; // size of the header of the compressed blocks [bytes]
+    };
+
+    void addBinary(std::string name, std::string type, const void* data, size_t n, bool isFloat, int components); ///< writes the element, and registers the data
+
+    std::ostream& os;
+    int format;
+    bool compressed;
+    std::vector<Appended> appended; // the data arrays of the AppendedData section
+    size_t offset = 0; // offset of the next data array in the AppendedData section [bytes]
+
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,86 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#ifndef COWVECTOR_H_
+#define COWVECTOR_H_
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <utility>
+
+namespace CPlantBox {
+
+/**
+ * A std::vector with copy on write semantics
+ *
+ * Copies share the same data, until one of them is modified. Used for the node data of the organs,
+ * so that copies of an organism (see Organism::copy, Organism::fork) only duplicate the nodes of organs that grow
+ * after the copy was made.
+ *
+ * Non-const access (operator[], at, back, begin, ...) detaches the data, if it is shared.
+ * References and iterators of non-const accesses are invalidated by copying the CowVector.
+ */
+template<class T>
+class CowVector
+{
+public:
+
+    using const_iterator = typename std::vector<T>::const_iterator;
+    using iterator = typename std::vector<T>::iterator;
+
+    CowVector() { }
+    CowVector(const std::vector<T>& v) : data(std::make_shared<std::vector<T>>(v)) { }
+
+    /* read access */
+    const std::vector<T>& vector() const { return data ? *data : empty(); } ///< the data (valid until the next non-const access)
+    operator const std::vector<T>&() const { return vector(); }
+    size_t size() const { return data ? data->size() : 0; }
+    bool isEmpty() const { return size()==0; }
+    const T& operator[](size_t i) const { return (*data)[i]; }
+    const T& at(size_t i) const { return vector().at(i); }
+    const T& back() const { return data->back(); }
+    const_iterator begin() const { return vector().begin(); }
+    const_iterator end() const { return vector().end(); }
+    bool isShared() const { return data && (data.use_count()>1); } ///< data is shared with a copy
+
+    /* write access (detaches shared data) */
+    std::vector<T>& mutableVector() { return *mutableData(); } ///< the data for writing (valid until the CowVector is copied)
+    T& operator[](size_t i) { return (*mutableData())[i]; }
+    T& at(size_t i) { return mutableData()->at(i); }
+    T& back() { return mutableData()->back(); }
+    iterator begin() { return mutableData()->begin(); }
+    iterator end() { return mutableData()->end(); }
+    void push_back(const T& x) { mutableData()->push_back(x); }
+    iterator insert(const_iterator pos, const T& x) { // pos refers to the (possibly shared) data before the call
+        size_t i = pos - vector().begin();
+        auto& d = *mutableData();
+        return d.insert(d.begin() + i, x);
+    }
+    void resize(size_t n) { mutableData()->resize(n); }
+    void clear() { data.reset(); }
+    void swap(CowVector& other) { data.swap(other.data); }
+
+private:
+
+    static const std::vector<T>& empty() { static const std::vector<T> e; return e; }
+
+    std::vector<T>* mutableData() {
+        if (!data) {
+            data = std::make_shared<std::vector<T>>();
+        } else if (data.use_count()>1) {
+            data = std::make_shared<std::vector<T>>(*data); // copy on write
+        } else {
+            std::atomic_thread_fence(std::memory_order_acquire); // the last other owner might just have released the data
+        }
+        return data.get();
+    }
+
+    std::shared_ptr<std::vector<T>> data; ///< nullptr for an empty vector
+
+};
+
+template<class T>
+void swap(CowVector<T>& a, CowVector<T>& b) { a.swap(b); }
+
+} // end namespace CPlantBox
+
+#endif
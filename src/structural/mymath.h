@@ -8,6 +8,7 @@
  */
 
 #include <cmath>
+#include <cstdint>
 #include <sstream>
 #include <assert.h>
 #include <vector>
@@ -308,6 +309,77 @@ public:
 
 
 
+/**
+ * Counter based random number generator (Philox4x32-10, Salmon et al. 2011)
+ *
+ * The random numbers are a pure function of the key (seed, id, index) and the number of draws,
+ * therefore setting a new key costs nothing, and the numbers do not depend on the call order
+ */
+class Philox {
+public:
+
+	Philox() { setKey(0, 0, 0); } ///< default constructor
+
+	void setKey(uint32_t seed, uint32_t id, uint32_t index) {
+		key[0] = seed; key[1] = 0x9E3779B9u;
+		ctr[0] = 0; ctr[1] = 0; ctr[2] = index; ctr[3] = id;
+		pos = 4;
+		hasSpare = false;
+	} ///< starts a new stream, e.g. for organ id and node index
+
+	double rand() {
+		if (pos>2) {
+			next();
+		}
+		uint64_t r = (uint64_t(out[pos]) << 32) | uint64_t(out[pos+1]);
+		pos += 2;
+		return (r >> 11) * (1./9007199254740992.); // 2^-53
+	} ///< uniformly distributed random number [0, 1[
+
+	double randn() {
+		if (hasSpare) {
+			hasSpare = false;
+			return spare;
+		}
+		double u1 = 1.-rand(); // ]0, 1]
+		double u2 = rand();
+		double r = std::sqrt(-2.*std::log(u1));
+		spare = r*std::sin(2.*M_PI*u2);
+		hasSpare = true;
+		return r*std::cos(2.*M_PI*u2);
+	} ///< normally distributed random number (Box-Muller)
+
+protected:
+
+	void next() {
+		uint32_t c[4] = { ctr[0], ctr[1], ctr[2], ctr[3] };
+		uint32_t k[2] = { key[0], key[1] };
+		for (int i = 0; i<10; i++) {
+			uint64_t p0 = uint64_t(0xD2511F53u) * c[0];
+			uint64_t p1 = uint64_t(0xCD9E8D57u) * c[2];
+			uint32_t n0 = uint32_t(p1 >> 32) ^ c[1] ^ k[0];
+			uint32_t n2 = uint32_t(p0 >> 32) ^ c[3] ^ k[1];
+			c[0] = n0; c[1] = uint32_t(p1); c[2] = n2; c[3] = uint32_t(p0);
+			k[0] += 0x9E3779B9u; k[1] += 0xBB67AE85u;
+		}
+		for (int i = 0; i<4; i++) {
+			out[i] = c[i];
+		}
+		pos = 0;
+		if (++ctr[0]==0) {
+			++ctr[1];
+		}
+	} ///< Philox4x32 with 10 rounds, increments the counter
+
+	uint32_t key[2];
+	uint32_t ctr[4];
+	uint32_t out[4];
+	int pos; ///< next unused output word
+	double spare = 0.;
+	bool hasSpare = false;
+
+};
+
 
 
 } // end namespace CPlantBox
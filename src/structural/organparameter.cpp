@@ -94,6 +94,37 @@ double OrganRandomParameter::getParameter(std::string name) const
     return std::numeric_limits<double>::quiet_NaN(); // default if name is unknown
 }
 
+/**
+ * Sets a single scalar parameter, using the same names as OrganRandomParameter::getParameter,
+ * i.e. name_dev sets the standard deviation, and name_mean (or name) the mean value.
+ * Integer parameters are rounded.
+ *
+ * @param name      name of the parameter
+ * @param value     the new value
+ */
+void OrganRandomParameter::setParameter(std::string name, double value)
+{
+    if ((name.length()>4) && (name.substr(name.length()-4)=="_dev")) {// setting standard deviation?
+        std::string n = name.substr(0,name.length()-4);
+        if (param_sd.count(n)) {
+            *param_sd.at(n) = value;
+            return;
+        }
+    }
+    if ((name.length()>5) && (name.substr(name.length()-5)=="_mean")) {// setting the mean value?
+        name = name.substr(0,name.length()-5);
+    }
+    if (iparam.count(name)) { // setting an int parameter
+        *iparam.at(name) = (int)std::round(value);
+        return;
+    }
+    if (dparam.count(name)) { // setting a double parameter
+        *dparam.at(name) = value;
+        return;
+    }
+    throw std::invalid_argument("OrganRandomParameter::setParameter: parameter "+name+" not found");
+}
+
 /**
  * Quick info about the object for debugging
  *
@@ -61,6 +61,7 @@ public:
     virtual std::shared_ptr<OrganSpecificParameter> realize(); ///< creates a specific organ from the root parameter set
 
     virtual double getParameter(std::string name) const; // get a scalar parameter
+    virtual void setParameter(std::string name, double value); // set a scalar parameter
 
     virtual std::string toString(bool verbose = true) const; ///< info for debugging
 
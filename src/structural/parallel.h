@@ -0,0 +1,64 @@
+// -*- mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-
+#ifndef PARALLEL_H_
+#define PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace CPlantBox {
+
+/**
+ * Calls @param f(i) for i = 0..n-1 on up to @param threads threads (serial if 0 or 1), the calling thread works too.
+ *
+ * The indices are handed out in chunks of @param chunk consecutive indices to the next idle thread, i.e. f(i) must not
+ * depend on the thread it runs on. After the first exception no further chunks are started, and the exception is
+ * rethrown on the calling thread when all threads have finished.
+ *
+ * Used by Organism::simulateOrgans, RootSystem::searchScale, Ensemble::run, SegmentAnalyser, and ExudationModel.
+ */
+template<class F>
+void parallelFor(size_t n, int threads, F&& f, size_t chunk = 1)
+{
+    size_t nt = std::min(size_t(std::max(threads, 1)), (n+chunk-1)/chunk);
+    if (nt<=1) {
+        for (size_t i = 0; i<n; i++) {
+            f(i);
+        }
+        return;
+    }
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error = nullptr;
+    auto work = [&]() {
+        try {
+            size_t i0;
+            while (!failed && (i0 = next.fetch_add(chunk))<n) {
+                for (size_t i = i0; i<std::min(i0+chunk, n); i++) {
+                    f(i);
+                }
+            }
+        } catch (...) {
+            if (!failed.exchange(true)) { // keep the first exception
+                error = std::current_exception();
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (size_t t = 1; t<nt; t++) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto& t : pool) {
+        t.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+} // namespace CPlantBox
+
+#endif
@@ -366,7 +366,7 @@ public:
         data.at(map(i,j,k)) = d;
     }
 
-    Vector3d getGridPoint(size_t i, size_t j, size_t k) {
+    Vector3d getGridPoint(size_t i, size_t j, size_t k) const {
         return Vector3d(xgrid->grid[i], ygrid->grid[j], zgrid->grid[k]);
     } ///< grid point at indices
 
@@ -9,6 +9,8 @@
 
 namespace CPlantBox {
 
+thread_local Philox Tropism::gen;
+
 /**
  * Copies this tropism
  */
@@ -94,7 +96,7 @@ Vector2d Tropism::getUCHeading(const Vector3d& pos, const Matrix3d& old, double
  */
 Vector2d Tropism::getHeading(const Vector3d& pos, const Matrix3d& old, double dx, const std::shared_ptr<Organ> o, int nodeIdx)
 {
-    if(nodeIdx > 0 ){gen =  std::mt19937(plant.lock()->getSeedVal() + nodeIdx + o->getId());}
+    if(nodeIdx > 0 ){gen.setKey(plant.lock()->getSeedVal(), o->getId(), nodeIdx);}
     Vector2d h = this->getUCHeading(pos, old, dx, o, nodeIdx);
     double a = h.x;
     double b = h.y;
@@ -79,11 +79,9 @@ protected:
 	double sigma; ///< Standard deviation
 
 	std::weak_ptr<SignedDistanceFunction> geometry; ///< confining geometry todo
-	double randn(int nNode) {if((nNode > 0)&&(plant.lock()->getStochastic())){ return ND(gen);}else{return plant.lock()->randn();}; } ///< normally distributed random number (0,1)
-    double rand(int nNode) {if((nNode > 0)&&(plant.lock()->getStochastic())){ return UD(gen);}else{return plant.lock()->randn();}; } ///< uniformly distributed random number (0,1)
-	std::normal_distribution<double> ND;
-    std::uniform_real_distribution<double> UD;
-	std::mt19937 gen; ///<random number generator
+	double randn(int nNode) {if((nNode > 0)&&(plant.lock()->getStochastic())){ return gen.randn();}else{return plant.lock()->randn();}; } ///< normally distributed random number (0,1)
+    double rand(int nNode) {if((nNode > 0)&&(plant.lock()->getStochastic())){ return gen.rand();}else{return plant.lock()->randn();}; } ///< uniformly distributed random number (0,1)
+	static thread_local Philox gen; ///< counter based random number generator, keyed on (seed, organ id, node index) in getHeading (per thread, since organs of the same type can grow on several threads)
 
 };
 
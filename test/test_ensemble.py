@@ -0,0 +1,59 @@
+import sys; sys.path.append(".."); sys.path.append("../src/")
+import unittest
+
+import plantbox as pb
+
+path = "../modelparameter/structural/rootsystem/"
+name = "Zea_mays_1_Leitner_2010.xml"
+
+
+class TestEnsemble(unittest.TestCase):
+
+    def ensemble(self, threads):
+        """ three members, the third with a smaller elongation rate of the first order laterals """
+        prototype = pb.RootSystem()
+        prototype.readParameters(path + name)
+        e = pb.Ensemble(prototype)
+        for seed in [1, 2, 3]:
+            e.addMember(seed)
+        e.setParameter(2, 2, 1, "r", 0.5)
+        e.threads = threads
+        e.distributionName = "length"
+        e.distributionLayers = 20
+        e.run(30)
+        return e
+
+    def standalone(self, seed, r = None):
+        """ a root system simulated without the ensemble """
+        rs = pb.RootSystem()
+        rs.readParameters(path + name)
+        rs.setSeed(seed)
+        if r is not None:
+            rs.getOrganRandomParameter(2, 1).setParameter("r", r)
+        rs.initialize(False)
+        rs.simulate(30, False)
+        return rs
+
+    def test_threads(self):
+        """the results must not depend on the number of threads"""
+        e0 = self.ensemble(0)
+        e3 = self.ensemble(3)
+        self.assertEqual(list(e0.summed), list(e3.summed), "threads: summed lengths differ")
+        self.assertEqual(list(e0.numberOfNodes), list(e3.numberOfNodes), "threads: numbers of nodes differ")
+        self.assertEqual(list(e0.numberOfOrgans), list(e3.numberOfOrgans), "threads: numbers of organs differ")
+        self.assertEqual(list(e0.distribution), list(e3.distribution), "threads: distributions differ")
+
+    def test_member(self):
+        """a member must equal a standalone root system with the same seed (and parameter overrides)"""
+        e = self.ensemble(3)
+        rs = self.standalone(2)
+        self.assertEqual(e.summed[1], rs.getSummed("length"), "member: length differs from the standalone root system")
+        self.assertEqual(e.numberOfNodes[1], rs.getNumberOfNodes(), "member: number of nodes differs from the standalone root system")
+        rs = self.standalone(3, 0.5)
+        self.assertEqual(e.summed[2], rs.getSummed("length"), "setParameter: length differs from the standalone root system")
+        self.assertEqual(e.numberOfNodes[2], rs.getNumberOfNodes(), "setParameter: number of nodes differs from the standalone root system")
+        self.assertLess(e.summed[2], self.standalone(3).getSummed("length"), "setParameter: the override has no effect")
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -15,7 +15,7 @@ sys.path.append('..')
 import plantbox as rb
 
 class TestMaxInc(unittest.TestCase):
-    def ShortSim(self, dt: int, soildepth: float, layers: float, rootparfile: str, maxinc: float, re_reduction: np.array):
+    def ShortSim(self, dt: int, soildepth: float, layers: float, rootparfile: str, maxinc: float, re_reduction: np.array, threads: int = 0):
         ''' A short root growth simulation (1 step) using RootSystem::simulate(double dt, double maxinc_, ProportionalElongation* se, bool verbose) '''
         #--- read some root pars
         rootparname = rootparfile
@@ -35,6 +35,7 @@ class TestMaxInc(unittest.TestCase):
             p.r = 5. # set a high initial growth
         
         #--- intialize root system
+        rs.setParallel(threads)
         rs.initialize()
 
         #--- set a low maxinc and simulate        
@@ -62,6 +63,15 @@ class TestMaxInc(unittest.TestCase):
         layers=60
         self.ShortSim(dt=1, soildepth=180, layers=layers, rootparfile=rootparfile, maxinc=maxinc, re_reduction=np.ones((layers-1,))*0.9) # -10% reduction
         self.assertGreater(maxinc+tol, self.inc, 'maxinc not taking an effect')
+
+    def test_Accuracy(self):
+        ''' Tests that the increase meets maxinc within the accuracy of the search (1.e-3 cm), serial and on several threads'''
+        rootparfile = '../modelparameter/structural/rootsystem/Zea_mays_3_Postma_2011.xml'
+        maxinc = 4.
+        layers=60
+        for threads in [0, 4]:
+            self.ShortSim(dt=1, soildepth=180, layers=layers, rootparfile=rootparfile, maxinc=maxinc, re_reduction=np.ones((layers-1,))*0.9, threads=threads)
+            self.assertLessEqual(abs(self.inc - maxinc), 1.e-3, 'increase does not meet maxinc ({:d} threads)'.format(threads))
  
 if __name__ == '__main__':
     unittest.main()
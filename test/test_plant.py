@@ -64,8 +64,102 @@ class TestPlant(unittest.TestCase):
         #print(l.shape)
 #         plant_ana = pb.SegmentAnalyser(p)
 #         node_connection_o = seg2a(p.getSegments(15)) # plant segments
-        pass
-        
+        self.assertTrue(np.array_equal(p.getNodesArray() / 100, nodes), "getNodesArray and getNodes disagree")
+        self.assertTrue(np.array_equal(p.getSegmentsArray(pb.OrganTypes.root), rseg), "getSegmentsArray and getSegments disagree")
+
+    def test_mapped_views(self):
+        """tests the numpy arrays of MappedSegments, and the batched soil cell index call back"""
+        p = pb.MappedPlant(2)
+        p.readParameters(path + "Heliantus_Pagès_2013.xml", fromFile = True, verbose = False)
+        p.setRectangularGrid(pb.Vector3d(-10, -10, -40), pb.Vector3d(10, 10, 0), pb.Vector3d(20, 20, 40), False)
+        p.initialize(False)
+        p.simulate(30, False)
+        nodes = np.array([np.array(n) for n in p.nodes])
+        segs = np.array([np.array(s) for s in p.segments])
+        self.assertTrue(np.array_equal(p.nodesArray, nodes), "nodesArray and nodes disagree")
+        self.assertTrue(np.array_equal(p.segmentsArray, segs), "segmentsArray and segments disagree")
+        self.assertEqual(p.radii.shape[0], segs.shape[0], "wrong number of radii")
+        self.assertEqual(p.subTypes.shape[0], segs.shape[0], "wrong number of sub types")
+        self.assertEqual(p.organTypes.shape[0], segs.shape[0], "wrong number of organ types")
+        self.assertEqual(p.nodeCTs.shape[0], nodes.shape[0], "wrong number of node creation times")
+        self.assertTrue(np.shares_memory(p.radii, p.radii), "radii must be a view")
+        self.assertTrue(np.shares_memory(p.nodesArray, p.nodesArray), "nodesArray must be a view")
+        with self.assertRaises(ValueError):
+            p.radii[0] = 1.  # views are read-only
+        seg2cell = np.array(p.seg2cell)
+        def soil_indices(x):  # same grid, all points at once
+            i = np.floor((x - np.array([-10., -10., -40.])) / np.array([20., 20., 40.]) * np.array([20, 20, 40])).astype(int)
+            inside = np.all((i >= 0) & (i < np.array([20, 20, 40])), axis = 1)
+            return np.where(inside, i[:, 2] * 400 + i[:, 1] * 20 + i[:, 0], -1)
+        p.setSoilIndices(soil_indices)
+        self.assertTrue(np.array_equal(p.seg2cell, seg2cell), "batched soil index call back and rectangular grid disagree")
+        radii = np.array(p.radii)  # a copy, the view is invalid after the next simulate call
+        p.simulate(10, False)  # reallocates the vectors
+        self.assertGreater(p.radii.shape[0], radii.shape[0], "views must be taken at the time of access")
+        self.assertTrue(np.array_equal(p.radii[:radii.shape[0]], radii), "radii of the old segments changed")
+        view, radii = p.radii, np.array(p.radii)
+        del p
+        self.assertTrue(np.array_equal(view, radii), "the view must keep the plant alive")
+
+    def test_cell2seg(self):
+        """seg2cell and cell2seg must agree after each step of a simulate and cut cycle (segments above ground are in cell -1)"""
+        p = pb.MappedPlant(2)
+        p.readParameters(path + "Heliantus_Pagès_2013.xml", fromFile = True, verbose = False)
+        p.setRectangularGrid(pb.Vector3d(-5, -5, -20), pb.Vector3d(5, 5, 0), pb.Vector3d(5, 5, 10), True)
+        p.initialize(False)
+        for i in range(10):
+            p.simulate(3, False)
+            seg2cell = np.array(p.seg2cell)
+            c2s = p.cell2seg
+            self.assertEqual(seg2cell.shape[0], len(p.segments), "cell2seg: seg2cell has a wrong size")
+            cells = np.unique(seg2cell)
+            self.assertEqual(len(c2s), cells.shape[0], "cell2seg: wrong number of cells")
+            self.assertEqual(list(c2s.keys()), list(cells), "cell2seg: wrong cells")
+            n = 0
+            for c, segs in c2s.items():
+                self.assertEqual(segs, c2s[c], "cell2seg: items() and [] disagree")
+                self.assertTrue(np.all(seg2cell[segs] == c), "cell2seg: segment is mapped to another cell in seg2cell")
+                n += len(segs)
+            self.assertEqual(n, seg2cell.shape[0], "cell2seg: each segment must be in exactly one cell")
+            self.assertTrue(np.array_equal(seg2cell[c2s.segments], np.sort(seg2cell)), "cell2seg: segments are not sorted by cell")
+            self.assertIn(-1, c2s, "cell2seg: the shoot segments must be in cell -1")
+            nodes = np.array([np.array(x) for x in p.nodes])
+            segs = np.array([np.array(s) for s in p.segments], dtype = np.int64)
+            mid = 0.5 * (nodes[segs[:, 0]] + nodes[segs[:, 1]])
+            inside = np.all((mid > np.array([-5., -5., -20.])) & (mid < np.array([5., 5., 0.])), axis = 1)
+            outside = np.zeros((seg2cell.shape[0],), dtype = bool)
+            outside[c2s[-1]] = True
+            self.assertTrue(np.array_equal(outside, ~inside), "cell2seg: cell -1 must contain exactly the segments outside of the grid")
+
+    def test_cut_periodic(self):
+        """cutting at a periodic grid, each cut segment must lie within a single cell (also outside of the domain)"""
+        p = pb.MappedPlant(2)
+        p.readParameters(path + "Heliantus_Pagès_2013.xml", fromFile = True, verbose = False)
+        p.setRectangularGrid(pb.Vector3d(-2, -2, -10), pb.Vector3d(2, 2, 0), pb.Vector3d(4, 4, 10), False)
+        p.initialize(False)
+        p.simulate(30, False)
+        nodes = np.array([np.array(n) for n in p.nodes])
+        segs = np.array([np.array(s) for s in p.segments], dtype = np.int64)
+        length = np.sum(np.linalg.norm(nodes[segs[:, 1]] - nodes[segs[:, 0]], axis = 1))
+        n = segs.shape[0]
+        lo, w, res = np.array([-2., -2., -10.]), np.array([4., 4., 10.]), np.array([4, 4, 10])
+        def cell(x):  # periodic in all directions
+            i = np.floor(np.mod(x - lo, w) / w * res).astype(int)
+            return i[:, 2] * 16 + i[:, 1] * 4 + i[:, 0]
+        p.setSoilGrid(lambda x, y, z: int(cell(np.array([[x, y, z]]))[0]), pb.Vector3d(-2, -2, -10), pb.Vector3d(2, 2, 0), pb.Vector3d(4, 4, 10), True)
+        nodes = np.array([np.array(n) for n in p.nodes])
+        segs = np.array([np.array(s) for s in p.segments], dtype = np.int64)
+        self.assertGreater(segs.shape[0], n, "cut periodic: no segments were cut")
+        n1, n2 = nodes[segs[:, 0]], nodes[segs[:, 1]]
+        l = np.linalg.norm(n2 - n1, axis = 1)
+        self.assertAlmostEqual(np.sum(l) / length, 1., 10, "cut periodic: cutting changed the total length")
+        eps = 1.e-5  # cuts creating shorter segments are omitted (MappedSegments::eps)
+        long = l > 2 * eps
+        d = (n2 - n1)[long] / l[long, None] * eps
+        mid = cell(0.5 * (n1 + n2)[long])
+        self.assertTrue(np.array_equal(cell(n1[long] + d), mid), "cut periodic: segment starts in another cell")
+        self.assertTrue(np.array_equal(cell(n2[long] - d), mid), "cut periodic: segment ends in another cell")
+
     def test_CPlantBox_step(self):
         """tests the functions needed by CPlantBox defined in CPlantBox_PiafMunch.py"""
         p1 = pb.MappedPlant(2)
@@ -88,7 +182,129 @@ class TestPlant(unittest.TestCase):
         self.assertAlmostEqual(len(root1), len(root2), 10, "number of stem organs do not agree")
         root1 = p1.getOrgans(4)
         root2 = p2.getOrgans(4)
-        self.assertAlmostEqual(len(root1), len(root2), 10, "number of leaf organs do not agree")                   
+        self.assertAlmostEqual(len(root1), len(root2), 10, "number of leaf organs do not agree")
+
+    def test_step_delta(self):
+        """the step delta (only the organs that changed) must agree with the traversal of all organs"""
+        p = pb.Plant()
+        p.readParameters(path + "Anagallis_femina_leaf_shape.xml", fromFile = True, verbose = False)
+        p.setSeed(1)
+        p.initialize(False)
+        for i in range(10):
+            old = np.array([np.array(n) for n in p.getNodes()])
+            p.simulate(1.5, False)
+            d = p.getStepDelta()
+            nodes = np.array([np.array(n) for n in p.getNodes()])
+            self.assertTrue(np.array_equal(np.array([np.array(n) for n in d.newNodes]), nodes[old.shape[0]:]), "step delta: new nodes differ")
+            self.assertEqual(sorted([s.y for s in d.newSegments]), sorted([s.y for s in p.getNewSegments()]), "step delta: new segments differ")
+            moved = set(d.movedNodeIds)
+            self.assertTrue(moved.issubset(set(p.getUpdatedNodeIndices())), "step delta: unexpected moved nodes")
+            for j in set(p.getUpdatedNodeIndices()) - moved:  # nodes of organs that did not change
+                self.assertTrue(np.array_equal(old[j], nodes[j]), "step delta: a moved node is missing")
+        self.assertLess(len(d.organs), len(p.getOrgans()), "step delta: all organs were visited")
+
+    def test_parallel(self):
+        """growing the base organs on several threads must give the same plant as the serial simulation"""
+        nodes, segs = [], []
+        for threads in [0, 1, 4]:
+            p = pb.Plant()
+            p.readParameters(path + "Triticum_aestivum_test_2021.xml", fromFile = True, verbose = False)
+            p.setSeed(1)
+            p.setParallel(threads)
+            p.initialize(False)
+            for i in range(10):
+                p.simulate(3, False)
+            nodes.append(np.array((list(map(np.array, p.getNodes())))))
+            segs.append(np.array((list(map(np.array, p.getSegments()))), dtype = np.int64))
+        for i in [1, 2]:
+            self.assertEqual(nodes[i].shape, nodes[0].shape, "parallel: number of nodes differs from the serial simulation")
+            self.assertEqual(np.sum(nodes[i] != nodes[0]), 0, "parallel: nodes differ from the serial simulation")
+            self.assertEqual(np.sum(segs[i] != segs[0]), 0, "parallel: segments differ from the serial simulation")
+
+    def test_serial(self):
+        """the serial simulation (parallel = 0) of a seeded multi-tiller plant must not change (reference values since the base organs grow as tasks)"""
+        p = pb.Plant()
+        p.readParameters(path + "Triticum_aestivum_test_2021.xml", fromFile = True, verbose = False)
+        p.setSeed(1)
+        p.initialize(False)
+        for i in range(10):
+            p.simulate(3, False)
+        nodes = np.array((list(map(np.array, p.getNodes()))))
+        self.assertEqual(nodes.shape[0], 4711, "serial: wrong number of nodes")
+        self.assertEqual(len(p.getSegments()), 4710, "serial: wrong number of segments")
+        self.assertEqual([len(p.getOrgans(ot)) for ot in [2, 3, 4]], [2591, 4, 9], "serial: wrong number of roots, stems, and leaves")
+        ref = {10: [-0.17093408595860052, 1.7555207211006147, -3.8176828307333732],
+               2355: [0.95670318571160273, -3.7977621345478667, -13.83908007344038],
+               4710: [-0.38831793555625782, -0.049565021923922439, 3.3995115879718076]}  # last node is on a leaf
+        for i, x in ref.items():
+            for j in range(3):
+                self.assertAlmostEqual(nodes[i, j], x[j], 12, "serial: node {:d} moved".format(i))
+        s = np.sum(nodes, axis = 0)
+        for j, x in enumerate([-3116.5664352150229, -4356.1975887278386, -61205.301504810974]):
+            self.assertAlmostEqual(s[j] / x, 1., 12, "serial: nodes moved")
+        self.assertAlmostEqual(sum([o.getLength() for o in p.getOrgans(4)]), 227.57368453387318, 10, "serial: wrong leaf length")
+
+    def test_fork(self):
+        """a fork shares the node data with its parent (copy on write), growing one of them must not change the other"""
+        def plant():
+            p = pb.Plant()
+            p.readParameters(path + "Triticum_aestivum_test_2021.xml", fromFile = True, verbose = False)
+            p.setSeed(5)
+            p.initialize(False)
+            return p
+        def nodes(p):
+            return np.array((list(map(np.array, p.getNodes()))))
+        p = plant()
+        for i in range(4):
+            p.simulate(2, False)
+        n0, l0 = nodes(p), np.array(p.getParameter("length"))
+        f = p.fork()
+        for i in range(4):
+            f.simulate(2, False)
+        self.assertTrue(np.array_equal(nodes(p), n0), "fork: growing the fork changed the nodes of the parent")
+        self.assertTrue(np.array_equal(np.array(p.getParameter("length")), l0), "fork: growing the fork changed the parent's organ lengths")
+        n1, l1 = nodes(f), np.array(f.getParameter("length"))
+        self.assertGreater(n1.shape[0], n0.shape[0], "fork: the fork did not grow")
+        for i in range(4):
+            p.simulate(2, False)
+        self.assertTrue(np.array_equal(nodes(f), n1), "fork: growing the parent changed the nodes of the fork")
+        self.assertTrue(np.array_equal(np.array(f.getParameter("length")), l1), "fork: growing the parent changed the fork's organ lengths")
+        q = plant()  # same seed, without fork
+        for i in range(8):
+            q.simulate(2, False)
+        self.assertTrue(np.array_equal(nodes(q), n1), "fork: the fork differs from a fresh simulation")
+        self.assertTrue(np.array_equal(nodes(q), nodes(p)), "fork: the parent differs from a fresh simulation")
+
+    def test_parameter_keys(self):
+        """getParameter by key and by name must agree for each parameter key name, and each organ type"""
+        p = pb.Plant()
+        p.readParameters(path + "Heliantus_Pagès_2013.xml", fromFile = True, verbose = False)
+        p.setSeed(1)
+        p.initialize(False)
+        p.simulate(40, False)
+        def value(f):  # parameter value, or the exception type (unknown random parameters throw)
+            try:
+                return f()
+            except Exception as e:
+                return type(e)
+        organs = [p.getSeed()] + [p.getOrgans(ot)[-1] for ot in [pb.OrganTypes.root, pb.OrganTypes.stem, pb.OrganTypes.leaf]]
+        self.assertEqual([o.organType() for o in organs], [1, 2, 3, 4], "parameter keys: wrong organ types")
+        for i, name in enumerate(pb.Organ.parameterKeyNames):
+            key = pb.Organ.parameterKey(name)
+            self.assertEqual(key, i, "parameter keys: wrong key of " + name)
+            self.assertEqual(pb.Organ.parameterName(key), name, "parameter keys: wrong name of key {:d}".format(key))
+            for o in organs:
+                v, w = value(lambda: o.getParameter(key)), value(lambda: o.getParameter(name))
+                msg = "parameter keys: {:s} of organ type {:d} differs by key and by name".format(name, o.organType())
+                if isinstance(w, float) and np.isnan(w):
+                    self.assertTrue(isinstance(v, float) and np.isnan(v), msg)
+                else:
+                    self.assertEqual(v, w, msg)
+        for o in organs:
+            self.assertEqual(o.getParameter("length"), o.getLength(), "parameter keys: wrong length")
+            self.assertEqual(o.getParameter("id"), o.getId(), "parameter keys: wrong id")
+            self.assertEqual(o.getParameter("organType"), o.organType(), "parameter keys: wrong organ type")
+            self.assertEqual(o.getParameter("numberOfNodes"), o.getNumberOfNodes(), "parameter keys: wrong number of nodes")
 
     def test_DB_delay(self):
         p = pb.MappedPlant(2)
@@ -1,6 +1,6 @@
 import sys; sys.path.append(".."); sys.path.append("../src/")
 import unittest
-
+
 import plantbox as pb
 from rsml.rsml_reader import *
 
@@ -261,6 +261,34 @@ class TestRootSystem(unittest.TestCase):
         floats = [int(item) for item in check_str.split()]
         self.assertEqual(floats, [0, 10, 13, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46, 49, 52, 55, 58], "creation times are unexpected")
 
+    def test_skip_finished(self):
+        """ skipping finished subtrees must not change the results, also with finite root life times """
+        results = []
+        for skip in [True, False]:
+            rs = pb.RootSystem()
+            rs.readParameters("../modelparameter/structural/rootsystem/Anagallis_femina_Leitner_2010.xml")
+            for p in rs.getOrganRandomParameter(pb.OrganTypes.root):
+                if p is not None:
+                    p.setParameter("rlt", 5 * (p.subType + 1))
+            rs.setSeed(3)
+            rs.setSkipFinished(skip)
+            rs.initialize(False)
+            for i in range(0, 60):
+                rs.simulate(0.7, False)
+                if i == 30:
+                    rs.push()
+                    rs.simulate(5, False)
+                    rs.pop()
+            roots = rs.getOrgans(pb.OrganTypes.root)
+            results.append((rs.getNodes(), [r.isAlive() for r in roots], [r.getParameter("age") for r in roots]))
+        self.assertEqual(len(results[0][0]), len(results[1][0]), "skip finished: numbers of nodes differ")
+        for a, b in zip(results[0][0], results[1][0]):
+            self.assertEqual([a.x, a.y, a.z], [b.x, b.y, b.z], "skip finished: nodes differ")
+        self.assertEqual(results[0][1], results[1][1], "skip finished: alive flags differ")
+        self.assertIn(False, results[0][1], "skip finished: no root died")
+        for a, b in zip(results[0][2], results[1][2]):
+            self.assertAlmostEqual(a, b, 10, "skip finished: ages differ")
+
     def test_stack(self):
         """ checks if push and pop are working """
         pass
@@ -0,0 +1,47 @@
+import sys; sys.path.append(".."); sys.path.append("../src/")
+import unittest
+
+import numpy as np
+
+import plantbox as pb
+
+path = "../modelparameter/structural/rootsystem/"
+
+
+class TestSegmentAnalyser(unittest.TestCase):
+
+    def test_distribution3(self):
+        """the exact 3d length distribution must sum up to the length within the grid"""
+        rs = pb.RootSystem()
+        rs.readParameters(path + "Zea_mays_4_Leitner_2014.xml")
+        rs.setSeed(1)
+        rs.initialize(False)
+        rs.simulate(20, False)
+        ana = pb.SegmentAnalyser(rs)
+        d = np.array(ana.distribution3("length", pb.Vector3d(-5, -5, -30), pb.Vector3d(5, 5, 0), 5, 5, 15, True))
+        self.assertEqual(d.shape[0], 5 * 5 * 15, "distribution3: wrong number of cells")
+        box = pb.SegmentAnalyser(rs)
+        box.crop(pb.SDF_PlantBox(10, 10, 30))  # [-5,-5,0] - [5,5,-30]
+        self.assertLess(box.getSummed("length"), ana.getSummed("length"), "distribution3: the root system should exceed the grid")
+        self.assertAlmostEqual(np.sum(d) / box.getSummed("length"), 1., 6, "distribution3: summed length differs from the length within the grid")
+
+    def test_voxelise(self):
+        """a single segment crossing known cell faces"""
+        a, b = pb.Vector3d(0.25, 0.5, 0.5), pb.Vector3d(1.75, 1.25, 0.5)  # crosses x = 1 at t = 1/2, and y = 1 at t = 2/3
+        cells, t = pb.SegmentAnalyser.voxelise(a, b, pb.Vector3d(0, 0, 0), pb.Vector3d(2, 2, 1), 2, 2, 1)
+        self.assertEqual(cells, [0, 1, 3], "voxelise: wrong cells")
+        for t_, t0 in zip(t, [0., 0.5, 2. / 3., 1.]):
+            self.assertAlmostEqual(t_, t0, 14, "voxelise: wrong cell boundaries")
+        l = np.sqrt(1.5 ** 2 + 0.75 ** 2)
+        ana = pb.SegmentAnalyser([a, b], [pb.Vector2i(0, 1)], [0.], [0.1])
+        d = ana.distribution3("length", pb.Vector3d(0, 0, 0), pb.Vector3d(2, 2, 1), 2, 2, 1, True)
+        for d_, d0 in zip(d, [l / 2., l / 6., 0., l / 3.]):
+            self.assertAlmostEqual(d_, d0, 14, "distribution3: wrong length per cell")
+        cells, t = pb.SegmentAnalyser.voxelise(pb.Vector3d(-1, 0.5, 0.5), pb.Vector3d(1.5, 0.5, 0.5), pb.Vector3d(0, 0, 0), pb.Vector3d(2, 2, 1), 2, 2, 1)
+        self.assertEqual(cells, [0, 1], "voxelise: wrong cells of a segment starting outside of the grid")
+        for t_, t0 in zip(t, [0.4, 0.8, 1.]):
+            self.assertAlmostEqual(t_, t0, 14, "voxelise: wrong cell boundaries of a segment starting outside of the grid")
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,128 @@
+import sys; sys.path.append(".."); sys.path.append("../src/")
+import unittest
+
+import base64
+import re
+import struct
+import zlib
+import xml.etree.ElementTree as ET
+
+import numpy as np
+
+import plantbox as pb
+
+
+def base64_size(n):
+    """ number of characters of n base64 encoded bytes """
+    return 4 * ((n + 2) // 3)
+
+
+def decode(appended, offset, encoding, compressed):
+    """ decodes the data array at offset of the appended data (UInt64 headers, see VTK file formats) """
+    if encoding == "base64":
+        n = struct.unpack("<Q", base64.b64decode(appended[offset:offset + 12])[:8])[0]
+    else:
+        n = struct.unpack("<Q", appended[offset:offset + 8])[0]
+    if not compressed:  # n is the number of bytes, header and data are encoded together
+        if encoding == "base64":
+            return base64.b64decode(appended[offset:offset + base64_size(8 + n)])[8:]
+        return appended[offset + 8:offset + 8 + n]
+    hs = 8 * (3 + n)  # n is the number of blocks, header is [blocks, block size, last partial block size, compressed sizes]
+    if encoding == "base64":  # header and blocks are encoded separately
+        header = base64.b64decode(appended[offset:offset + base64_size(hs)])
+        pos = offset + base64_size(hs)
+    else:
+        header = appended[offset:offset + hs]
+        pos = offset + hs
+    header = struct.unpack("<{:d}Q".format(3 + n), header)
+    sizes = header[3:]
+    if encoding == "base64":
+        blocks = base64.b64decode(appended[pos:pos + base64_size(sum(sizes))])
+    else:
+        blocks = appended[pos:pos + sum(sizes)]
+    data, i = b"", 0
+    for j, s in enumerate(sizes):
+        block = zlib.decompress(blocks[i:i + s])
+        last = j == n - 1 and header[2] > 0
+        assert len(block) == (header[2] if last else header[1]), "wrong size of block {:d}".format(j)
+        data += block
+        i += s
+    return data
+
+
+def read_vtp(name):
+    """ reads the xml tree and the data arrays of a vtp file written by VTPWriter (ascii, raw, or base64, optionally zlib compressed) """
+    with open(name, "rb") as f:
+        content = f.read()
+    xml, appended, encoding = content, b"", ""
+    i = content.find(b"<AppendedData")
+    if i >= 0:
+        j = content.index(b"_", i) + 1
+        k = content.rindex(b"\n</AppendedData>")
+        encoding = re.search(b'encoding="(\\w+)"', content[i:j]).group(1).decode()
+        appended = content[j:k]
+        if encoding == "raw":  # binary data is no valid xml
+            xml = content[:i] + content[k + len(b"\n</AppendedData>\n"):]
+    root = ET.fromstring(xml)
+    compressed = root.get("compressor") == "vtkZLibDataCompressor"
+    arrays = {}
+    for da in root.iter("DataArray"):
+        dtype = {"Float32": np.float32, "Int32": np.int32}[da.get("type")]
+        if da.get("format") == "ascii":
+            arrays[da.get("Name")] = np.array(da.text.split(), dtype = dtype)
+        else:
+            data = decode(appended, int(da.get("offset")), encoding, compressed)
+            arrays[da.get("Name")] = np.frombuffer(data, dtype = dtype)
+    return root, arrays
+
+
+class TestVTPWriter(unittest.TestCase):
+
+    def analyser(self):
+        """ a helix of n nodes, the coordinates need more than one compressed block (VTPWriter::blockSize) """
+        n = 5000
+        t = np.linspace(0., 20., n)
+        nodes = [pb.Vector3d(np.cos(x), np.sin(x), -x) for x in t]
+        segs = [pb.Vector2i(i, i + 1) for i in range(n - 1)]
+        cts = list(t[1:])
+        radii = list(0.1 + 0.01 * t[1:])
+        ana = pb.SegmentAnalyser(nodes, segs, cts, radii)
+        expected = {"radius": np.array(radii, dtype = np.float32),
+                    "creationTime": np.array(cts, dtype = np.float32),
+                    "Coordinates": np.array([np.array(x) for x in nodes], dtype = np.float32).flatten(),
+                    "connectivity": np.array([np.array(s) for s in segs], dtype = np.int32).flatten(),
+                    "offsets": 2 * np.arange(1, n, dtype = np.int32)}
+        return ana, expected
+
+    def test_round_trip(self):
+        """ the data arrays must be decoded to the written Float32 and Int32 values, for each format with and without compression """
+        ana, expected = self.analyser()
+        combinations = [(0, False), (1, False), (2, False)]
+        if pb.VTPWriter.hasCompression():
+            combinations += [(0, True), (1, True), (2, True)]  # ascii ignores compression
+        for format, compressed in combinations:
+            name = "test_vtp_writer_{:d}_{:d}.vtp".format(format, compressed)
+            ana.write(name, ["radius", "creationTime"], format, compressed)
+            root, arrays = read_vtp(name)
+            msg = "(format {:d}, compressed {})".format(format, compressed)
+            self.assertEqual(root.get("header_type"), None if format == 0 else "UInt64", "VTPWriter: wrong header type " + msg)
+            self.assertEqual(root.get("compressor") is not None, compressed and format != 0, "VTPWriter: wrong compressor " + msg)
+            piece = root.find("PolyData/Piece")
+            self.assertEqual(int(piece.get("NumberOfLines")), expected["radius"].shape[0], "VTPWriter: wrong number of lines " + msg)
+            self.assertEqual(int(piece.get("NumberOfPoints")), expected["Coordinates"].shape[0] // 3, "VTPWriter: wrong number of points " + msg)
+            self.assertEqual(sorted(arrays.keys()), sorted(expected.keys()), "VTPWriter: wrong data arrays " + msg)
+            for k, v in expected.items():
+                self.assertTrue(np.array_equal(arrays[k], v), "VTPWriter: data array {:s} differs ".format(k) + msg)
+
+    def test_no_compression(self):
+        """ compressed binary output must throw, if the library is built without zlib """
+        if pb.VTPWriter.hasCompression():
+            self.skipTest("built with zlib")
+        ana, _ = self.analyser()
+        for format in [1, 2]:
+            with self.assertRaises(ValueError):
+                ana.write("test_vtp_writer.vtp", ["radius"], format, True)
+
+
+if __name__ == '__main__':
+    unittest.main()
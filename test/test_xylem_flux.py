@@ -0,0 +1,98 @@
+import sys; sys.path.append(".."); sys.path.append("../src/")
+import unittest
+
+import numpy as np
+from scipy import sparse
+import scipy.sparse.linalg as LA
+
+import plantbox as pb
+from functional.xylem_flux import XylemFluxPython
+from functional.PlantHydraulicModel import HydraulicModel_Meunier
+from functional.PlantHydraulicParameters import PlantHydraulicParameters
+
+kz = 4.32e-2  # axial conductivity [cm3/day]
+kr = 1.728e-4  # radial conductivity [1/day]
+min_, max_, res_ = pb.Vector3d(-10, -10, -20), pb.Vector3d(10, 10, 0), pb.Vector3d(4, 4, 10)
+
+
+def root_system():
+    rs = pb.MappedRootSystem()
+    rs.readParameters("../modelparameter/structural/rootsystem/Anagallis_femina_Leitner_2010.xml")
+    rs.setRectangularGrid(min_, max_, res_, False)
+    rs.initialize(False)
+    rs.simulate(7, False)
+    return rs, 7
+
+
+def plant():
+    p = pb.MappedPlant(2)
+    p.readParameters("../modelparameter/structural/plant/Heliantus_Pagès_2013.xml", fromFile = True, verbose = False)
+    p.setRectangularGrid(min_, max_, res_, False)
+    p.initialize(False)
+    p.simulate(20, False)
+    return p, 20
+
+
+def assembled(r, bc_node, value, dirichlet):
+    """ solves the linear system assembled by linearSystem or linearSystemMeunier (aI, aJ, aV, aB) with scipy """
+    Q = sparse.csc_matrix(sparse.coo_matrix((np.array(r.aV), (np.array(r.aI), np.array(r.aJ)))))
+    b = np.array(r.aB)
+    if dirichlet:
+        Q, b = r.bc_dirichlet(Q, b, [bc_node], [value])
+    else:
+        Q, b = r.bc_neumann(Q, b, [bc_node], [value])
+    return LA.spsolve(Q, b)
+
+
+class TestXylemFlux(unittest.TestCase):
+
+    def check(self, r, linear_system, t, name):
+        """ compares solve_cpp with the assembled system, for Neumann and Dirichlet collar conditions, with sx per cell and per segment """
+        ns = len(r.rs.segments)
+        sx_cells = [-200. - 10. * (i // 16) for i in range(160)]  # per cell, decreasing with depth
+        sx_segs = list(np.linspace(-200., -400., ns))  # per segment
+        for cells, sx in [(True, sx_cells), (False, sx_segs)]:
+            for dirichlet, value in [(False, -1.), (True, -500.)]:
+                x = np.array(r.solve_cpp(t, sx, cells, [0], [value], dirichlet))
+                linear_system(t, sx, cells)
+                y = assembled(r, 0, value, dirichlet)
+                err = np.max(np.abs(x - y) / (1. + np.abs(y)))
+                self.assertLess(err, 1.e-8, "{:s}: solve_cpp and assembled system disagree (cells {}, dirichlet {})".format(name, cells, dirichlet))
+
+    def test_xylem_flux_root_system(self):
+        """ XylemFlux::solve and XylemFlux::linearSystem agree for a root system """
+        rs, t = root_system()
+        r = XylemFluxPython(rs)
+        r.setKr([0., kr, kr, kr, kr, kr])
+        r.setKx([kz, kz, kz, kz, kz, kz])
+        self.check(r, r.linearSystem, t, "XylemFlux, root system")
+
+    def test_xylem_flux_plant(self):
+        """ XylemFlux::solve and XylemFlux::linearSystem agree for a plant """
+        p, t = plant()
+        r = XylemFluxPython(p)
+        r.setKr([[kr], [kr], [0.004]])
+        r.setKx([[kz], [kz], [kz]])
+        self.check(r, r.linearSystem, t, "XylemFlux, plant")
+
+    def test_meunier_root_system(self):
+        """ PlantHydraulicModel::solve and PlantHydraulicModel::linearSystemMeunier agree for a root system """
+        rs, t = root_system()
+        params = PlantHydraulicParameters()
+        params.setKr([0., kr, kr, kr, kr, kr], verbose = False)
+        params.setKx([kz, kz, kz, kz, kz, kz], verbose = False)
+        r = HydraulicModel_Meunier(rs, params)
+        self.check(r, r.linearSystemMeunier, t, "HydraulicModel_Meunier, root system")
+
+    def test_meunier_plant(self):
+        """ PlantHydraulicModel::solve and PlantHydraulicModel::linearSystemMeunier agree for a plant """
+        p, t = plant()
+        params = PlantHydraulicParameters()
+        params.setKr([[kr], [kr], [0.004]])
+        params.setKx([[kz], [kz], [kz]])
+        r = HydraulicModel_Meunier(p, params)
+        self.check(r, r.linearSystemMeunier, t, "HydraulicModel_Meunier, plant")
+
+
+if __name__ == '__main__':
+    unittest.main()